@@ -1,22 +1,93 @@
 #ifndef ADDRESS_ALLOCATOR_H
 #define ADDRESS_ALLOCATOR_H
 
+#include <map>
 #include <utility>
 #include <random>
+#include <string>
+#include <vector>
 #include "FaultConfig.hpp"
+#include "MemoryState.hpp"
+#include "Neighborhood.hpp"
+
+// rows x cols 記憶體中 addr 所在的整條 row (stride 1) 或 column (stride cols)
+inline LineRange lineOf(LineScope scope, int addr, int rows, int cols) {
+    if (scope == LineScope::Row)    return { addr - addr % cols, cols, 1 };
+    if (scope == LineScope::Column) return { addr % cols, rows, cols };
+    return { addr, 1, 1 };
+}
 
 class AddressAllocator {
 public:
     AddressAllocator(int rows, int cols, unsigned int seed) 
         : row_(rows), col_(cols), rng_(seed) {
     }
+    // 重新設定亂數種子 (Monte-Carlo 模式每個 sample 由 counter-based RNG 決定)
+    void reseed(unsigned int seed) { rng_.seed(seed); }
+    // 亂數產生器的完整狀態 (文字形式)，供檢查點保存；restore 後抽出的位址序列與保存時相同
+    std::string state() const;
+    void restore(const std::string& state);
+
     // Determine addresses for a fault based on its configuration.
     // Returns {aggressor, victim}. For single-cell faults, victim is used and aggressor can be -1.
     std::pair<int,int> allocate(const FaultConfig& config);
 
+    // Address decoder fault：回傳 {partner, 故障位址}；partner 與故障位址只差一個位址 bit
+    // (decoder 中單一條選擇線出錯)，NoAccess 沒有 partner，回傳 -1
+    std::pair<int,int> allocateDecoder(const FaultConfig& config);
+
+    // Line fault：回傳觸發 cell (與 1-cell fault 相同的隨機位址)，其所在的 row / column 由 lineOf() 取得
+    int allocateLine(const FaultConfig& config) { return allocate(config).second; }
+    LineRange lineOf(LineScope scope, int addr) const { return ::lineOf(scope, addr, row_, col_); }
+
+    // N-cell fault：從預先算好的鄰域表中隨機挑一筆，回傳鄰域順序的位址
+    std::vector<int> allocateNeighborhood(const FaultConfig& config);
+    // 同上，寫入 cells (沿用其容量)
+    void allocateNeighborhood(const FaultConfig& config, std::vector<int>& cells);
+
+    // 此幾何上 cellNumber 個 cell 的鄰域表 (第一次使用時建立)
+    const NeighborhoodTable& table(int cellNumber);
+
 private:
     int row_, col_; // Memory dimensions (if needed)
     std::mt19937 rng_;
+    std::map<int, NeighborhoodTable> tables_;
+};
+
+// 在一塊大記憶體中替多個 fault 安排互不重疊、互不相鄰的位址。
+// 每個 fault 佔用的 cell 以及其 8 個鄰居都會被標記，後續 fault 不得使用，
+// 因此同一批 fault 之間不會互相干擾，可以共用一次 March pass。
+class SpatialPlacementPlanner {
+public:
+    SpatialPlacementPlanner(int rows, int cols)
+        : row_(rows), col_(cols), blocked_(static_cast<std::size_t>(rows) * cols, 0) {}
+
+    // 為 config 尋找位址；回傳 {aggressor, victim} (單 cell fault 的 aggressor 為 -1)。
+    // 記憶體已無空間時回傳 {-1, -1}，呼叫端應先清空再重新安排。
+    std::pair<int,int> place(const FaultConfig& config);
+
+    // N-cell fault：整個鄰域都可用時才佔用，回傳鄰域順序的位址；放不下時回傳空 vector
+    std::vector<int> placeNeighborhood(const FaultConfig& config);
+
+    // Line fault：整條 row / column 都可用時才佔用，回傳位於線段中央的觸發 cell；放不下時回傳 -1
+    int placeLine(const FaultConfig& config);
+    LineRange lineOf(LineScope scope, int addr) const { return ::lineOf(scope, addr, row_, col_); }
+
+    // 清除所有佔用紀錄，開始新的一批
+    void clear();
+
+private:
+    bool usable(int addr) const { return !blocked_[addr]; }
+    void claim(int addr);
+
+    int row_, col_;
+    std::vector<unsigned char> blocked_; // 已佔用或與已佔用 cell 相鄰
+    std::vector<int> touched_;           // clear() 時只還原被標記過的位址
+    int cursor_ {0};                     // 由低位址往高位址掃描
+    std::map<int, NeighborhoodTable> tables_;
+    std::map<int, std::size_t> tableCursor_; // 各鄰域表已掃描到的位置
+    int rowCursor_ {0};                      // placeLine 已掃描到的 row / column
+    int colCursor_ {0};
 };
 
 #endif // ADDRESS_ALLOCATOR_H
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef ADDRESS_DECODER_H
+#define ADDRESS_DECODER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Address decoder fault 的種類
+//   NoAccess  : 位址選不到任何 cell (寫入遺失，讀到浮動值)
+//   MultiCell : 位址同時選到自己與另一個 cell (寫入兩者，讀值為 wired-AND / wired-OR)
+//   WrongCell : 位址選到另一個 cell (自己的 cell 永遠存取不到，另一個 cell 被兩個位址共用)
+enum class DecoderFaultKind { None, NoAccess, MultiCell, WrongCell };
+
+// "no-access" / "multi-cell" / "wrong-cell"
+DecoderFaultKind parseDecoderFaultKind(const std::string& name);
+const char* toString(DecoderFaultKind kind);
+
+// ────────────────────────────────────────────────
+// 邏輯位址 → 實體 cell 的解碼表
+//   只記錄與 identity 不同的位址 (decoder fault 通常只有一兩個)，
+//   其他位址一律視為 identity；[lo_, hi_] 之外的位址只需兩次比較即可判定。
+//   建好之後不再修改 (FaultPool 在兩個 fault 之間 clear() 重填除外)，
+//   可由多個 fault 以 shared_ptr<const DecodeTable> 共用。
+// ────────────────────────────────────────────────
+class DecodeTable {
+public:
+    // addr 改為存取 cells (空表示選不到任何 cell)
+    void remap(int addr, std::initializer_list<int> cells) { remap(addr, cells.begin(), cells.end()); }
+    void remap(int addr, const std::vector<int>& cells) { remap(addr, cells.begin(), cells.end()); }
+
+    // 回到 identity；保留已配置的空間，之後 remap 不必重新配置 (FaultPool 重複使用)
+    void clear() {
+        used_ = 0;
+        lo_ = 1 << 30;
+        hi_ = -1;
+    }
+
+    // addr 的解碼結果；identity 時回傳 nullptr
+    const std::vector<int>* lookup(int addr) const {
+        if (addr < lo_ || addr > hi_) return nullptr;
+        for (std::size_t i = 0; i < used_; ++i)
+            if (entries_[i].first == addr) return &entries_[i].second;
+        return nullptr;
+    }
+
+    bool identity() const { return used_ == 0; }
+    std::size_t size() const { return used_; }
+
+private:
+    template <class It>
+    void remap(int addr, It first, It last) {
+        auto end = entries_.begin() + static_cast<std::ptrdiff_t>(used_);
+        auto it = std::find_if(entries_.begin(), end, [addr](const auto& e) { return e.first == addr; });
+        if (it == end) {
+            if (used_ == entries_.size()) entries_.emplace_back();
+            it = entries_.begin() + static_cast<std::ptrdiff_t>(used_++);
+            it->first = addr;
+        }
+        it->second.assign(first, last);
+        lo_ = std::min(lo_, addr);
+        hi_ = std::max(hi_, addr);
+    }
+
+    int lo_ {1 << 30};
+    int hi_ {-1};
+    std::vector<std::pair<int, std::vector<int>>> entries_; // 只有前 used_ 筆有效
+    std::size_t used_ {0};
+};
+
+#endif // ADDRESS_DECODER_H
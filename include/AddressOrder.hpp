@@ -0,0 +1,46 @@
+#ifndef ADDRESS_ORDER_H
+#define ADDRESS_ORDER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// ────────────────────────────────────────────────
+// March element 的位址走訪順序
+//   March 記法在方向字元後以 [name<k>] 指定，例如 a[gray](r0,w1)、d[stride2](r1,w0)；
+//   沒有指定時為 linear (0, 1, ..., N-1)。⇓ 一律是同一個順序倒著走。
+//   內建：
+//     linear        0, 1, ..., N-1
+//     gray          二進位反射 Gray code (N 不是 2 的冪時略過 >= N 的碼)
+//     stride<k>     每次遞增 2^k：0, 2^k, 2*2^k, ..., 1, 1+2^k, ...
+//     col           column-fast：同一個 column 由上到下，再換下一個 column
+//     scramble<k>   以 key k 產生的固定偽亂數排列 (代替實體 scramble 表)
+//   其他順序 (例如 tester 實際的 scramble 表) 可用 AddressOrderRegistry::add 註冊。
+// ────────────────────────────────────────────────
+struct AddressOrder {
+    std::string name {"linear"};
+    int param {0};
+
+    bool linear() const { return name == "linear"; }
+    bool operator==(const AddressOrder& other) const { return name == other.name && param == other.param; }
+    // "gray"、"stride2" (與 March 記法相同)
+    std::string toString() const { return param ? name + std::to_string(param) : name; }
+};
+
+// 產生 rows x cols 記憶體上的走訪順序；必須是 [0, rows * cols) 的一個排列
+using AddressOrderGenerator = std::function<std::vector<int>(int rows, int cols, int param)>;
+
+class AddressOrderRegistry {
+public:
+    // 註冊 (或取代) 一個位址順序；name 只能包含英文字母、'-'、'_'
+    static void add(const std::string& name, AddressOrderGenerator generator);
+    static bool contains(const std::string& name);
+
+    // "gray" / "stride2" / "scramble7" → AddressOrder；未註冊的名稱丟出 invalid_argument
+    static AddressOrder parse(const std::string& text);
+
+    // 產生並檢查位址序列 (不是排列時丟出 invalid_argument)
+    static std::vector<int> generate(const AddressOrder& order, int rows, int cols);
+};
+
+#endif // ADDRESS_ORDER_H
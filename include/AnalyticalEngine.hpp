@@ -0,0 +1,61 @@
+#ifndef ANALYTICAL_ENGINE_H
+#define ANALYTICAL_ENGINE_H
+
+#include <vector>
+#include "DetectionReport.hpp"
+#include "FaultConfig.hpp"
+#include "March.hpp"
+
+// ────────────────────────────────────────────────
+// 解析式偵測引擎 (Analytical detection engine)
+//   不建立 MemoryState，只以符號方式追蹤 victim / aggressor 兩個 cell，
+//   依每個 element 的位址順序 (ASC / DESC / BOTH→ASC) 決定兩者的先後，
+//   O(March length) 算出與 OneByOneFaultSimulator 相同的 DetectionReport
+//   (偵測到的 victim 位址以段記錄，需要時才展開)。
+//
+//   註：TwoCellCoupledTrigger 觸發後 matched 狀態會一直維持到下一次
+//   trigger cell 被操作，期間經過的其他位址也會受影響 (寫入被吃掉、讀到 finalRead)。
+//   因此除了 A / V 的相對順序，還把「A、V 之前 / 之間 / 之後」三段位址
+//   各視為一個符號 cell；同一段內的位址經歷完全相同的操作，不需逐一模擬。
+// ────────────────────────────────────────────────
+// 一次讀錯：符號 cell 所代表的整段 victim 位址 [lo, hi) 在 idx 這個 read 被偵測
+struct DetectedSegment {
+    int lo;
+    int hi;
+    MarchIdx idx;
+};
+
+// 解析式引擎的結果：偵測以位址段記錄，與記憶體大小無關；
+// report.detectedVicAddrs_ 只在 expandAddresses() 後才逐一列出
+struct AnalyticalResult {
+    DetectionReport report;
+    std::vector<DetectedSegment> segments;
+
+    // 把 segments 展開到 report.detectedVicAddrs_ (O(偵測到的位址數)，與模擬的報告相同)
+    void expandAddresses();
+};
+
+class AnalyticalEngine {
+public:
+    AnalyticalEngine(const std::vector<MarchElement>& marchTest, int memorySize);
+
+    // 此 fault 型態是否可由解析式引擎處理 (不支援時呼叫端應退回模擬)
+    bool supports(const FaultConfig& cfg) const;
+
+    // 計算 cfg 在 background = initValue、位址 (aggrAddr, vicAddr) 下的偵測結果。
+    // 單 cell fault 的 aggrAddr 為 -1。out 重複使用時沿用其中的節點與容量。
+    void evaluate(const FaultConfig& cfg, int initValue, int aggrAddr, int vicAddr,
+                  AnalyticalResult& out) const;
+    // 同上，並展開 detectedVicAddrs_
+    DetectionReport evaluate(const FaultConfig& cfg, int initValue,
+                             int aggrAddr, int vicAddr) const;
+
+private:
+    const std::vector<MarchElement>& marchTest_;
+    int memSize_;
+    std::vector<MarchIdx> readIdx_; // 所有 read op 的位置 (報告中預設為 false)
+    bool repeatedOps_ {false};      // March test 含 op^N (符號 cell 不追蹤重複次數)
+    bool nonLinearOrder_ {false};   // 有 element 使用 gray / stride 等位址順序
+};
+
+#endif // ANALYTICAL_ENGINE_H
@@ -0,0 +1,63 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// 多生產者 / 多消費者的有界佇列：滿了 push 會等待，空了 pop 會等待。
+// close() 之後 push 一律失敗；pop 取完剩下的元素後回傳 false。
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mu_);
+        notFull_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mu_);
+        notEmpty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        return take(out);
+    }
+
+    // 不等待；佇列為空時回傳 false
+    bool tryPop(T& out) {
+        std::lock_guard<std::mutex> lock(mu_);
+        return take(out);
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mu_);
+        closed_ = true;
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    bool take(T& out) {
+        if (items_.empty()) return false;
+        out = std::move(items_.front());
+        items_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+    const std::size_t capacity_;
+    std::mutex mu_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> items_;
+    bool closed_ {false};
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,77 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ────────────────────────────────────────────────
+// 報表用的緩衝輸出
+//   所有欄位直接格式化進固定大小的 buffer (數字以 std::to_chars)，
+//   buffer 滿了才以 fwrite 寫出一次；每一列不會產生暫時的 std::string。
+// ────────────────────────────────────────────────
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::string& filename, std::size_t capacity = 1 << 16)
+        : file_(std::fopen(filename.c_str(), "wb")), buf_(capacity) {
+        if (!file_) throw std::runtime_error("無法開啟輸出檔案: " + filename);
+    }
+    // 呼叫端應先自行 flush() 以取得錯誤；解構時的寫入錯誤只能忽略
+    ~BufferedWriter() {
+        try { flush(); } catch (...) {}
+        std::fclose(file_);
+    }
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    BufferedWriter& put(char c) {
+        if (used_ == buf_.size()) flush();
+        buf_[used_++] = c;
+        return *this;
+    }
+    BufferedWriter& put(std::string_view s) {
+        if (s.size() > buf_.size() - used_) {
+            flush();
+            if (s.size() > buf_.size()) return raw(s.data(), s.size());
+        }
+        std::memcpy(buf_.data() + used_, s.data(), s.size());
+        used_ += s.size();
+        return *this;
+    }
+    // 十進位整數
+    template <typename Int>
+    BufferedWriter& num(Int v) {
+        char digits[24];
+        return put(std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), v).ptr - digits));
+    }
+    // 二進位：原樣寫出 (host byte order)
+    template <typename T>
+    BufferedWriter& bin(const T& v) { return put(std::string_view(reinterpret_cast<const char*>(&v), sizeof(T))); }
+    template <typename T>
+    BufferedWriter& bin(const std::vector<T>& v) {
+        return put(std::string_view(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T)));
+    }
+
+    void flush() {
+        if (used_ && std::fwrite(buf_.data(), 1, used_, file_) != used_)
+            throw std::runtime_error("寫入輸出檔案失敗");
+        used_ = 0;
+    }
+
+private:
+    BufferedWriter& raw(const char* p, std::size_t n) {
+        if (std::fwrite(p, 1, n, file_) != n) throw std::runtime_error("寫入輸出檔案失敗");
+        return *this;
+    }
+
+    std::FILE* file_;
+    std::vector<char> buf_;
+    std::size_t used_ {0};
+};
+
+#endif // BUFFERED_WRITER_H
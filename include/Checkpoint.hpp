@@ -0,0 +1,97 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include "ResultStore.hpp"
+
+// 逐一模擬的進度：init 0 的所有 fault 跑完才跑 init 1，
+// 因此 (init, fault) 之前的 (fault, init) 都已完成，之後的都還沒開始
+struct RunCursor {
+    int init {0};
+    std::size_t fault {0};
+
+    bool finished() const { return init >= 2; }
+    // 已完成的 (fault, init) 數
+    long long done(std::size_t faults) const { return done(0, faults); }
+    // 只計算 [first, last) 的 fault 時 (shard) 已完成的數量
+    long long done(std::size_t first, std::size_t last) const {
+        const long long n = static_cast<long long>(last - first);
+        return finished() ? n * 2 : init * n + static_cast<long long>(fault - first);
+    }
+    bool operator==(const RunCursor& other) const { return init == other.init && fault == other.fault; }
+};
+
+// 檢查點檔的內容 (文字格式)：
+//   FSCKPT 1
+//   job <本次工作的參數摘要>
+//   cursor <init> <fault>
+//   rng <AddressAllocator 的亂數狀態>
+// 已完成的結果不在這裡，而是在 ResultStore 的 spill 檔中
+struct CheckpointState {
+    std::string job;      // resume 時比對，避免接上不同參數的檢查點
+    RunCursor cursor;     // 下一個要計算的 (init, fault)
+    std::string rngState; // 位址抽取的亂數狀態；placement 由它決定
+
+    // 先寫入 path.tmp 再 rename，中途被終止時舊的檢查點仍完整
+    void save(const std::string& path) const;
+    static CheckpointState load(const std::string& path);
+};
+
+// ────────────────────────────────────────────────
+// 長時間模擬的檢查點
+//   結果放在 ResultStore 的 spill 檔 (mmap)，另一個小檔 (spill 檔名 + ".ckpt") 保存
+//   CheckpointState。每隔 interval 秒由 due() 提示呼叫端保存一次：先 msync 結果，再
+//   寫入 state，所以檢查點記錄的進度一定已經在磁碟上。
+// ────────────────────────────────────────────────
+class CheckpointWriter {
+public:
+    CheckpointWriter(ResultStore& results, std::string path, std::string job, double intervalSec);
+
+    const std::string& path() const { return path_; }
+    // 距離上次保存已超過 interval
+    bool due() const { return std::chrono::steady_clock::now() >= next_; }
+    void save(const RunCursor& cursor, const std::string& rngState);
+    int saves() const { return saves_; }
+
+    // spill 檔對應的檢查點檔名
+    static std::string statePath(const std::string& spillFile) { return spillFile + ".ckpt"; }
+
+private:
+    ResultStore& results_;
+    std::string path_;
+    std::string job_;
+    std::chrono::steady_clock::duration interval_;
+    std::chrono::steady_clock::time_point next_;
+    int saves_ {0};
+};
+
+// 進度顯示：每隔 interval 秒輸出一行「完成比例、throughput、ETA」。
+// throughput 只計算本次執行完成的量，resume 之前的部分不列入
+class ProgressMeter {
+public:
+    ProgressMeter(long long total, long long done, std::ostream& out, double intervalSec = 5.0);
+    // done 為目前已完成的總量；未到輸出時間時只比較一次時間
+    void update(long long done) {
+        if (std::chrono::steady_clock::now() >= next_) print(done);
+    }
+    // 最後一行 (不論是否到輸出時間)
+    void finish(long long done) { print(done); }
+
+    // 秒數 → "1h02m03s" / "4m05s" / "6s"
+    static std::string formatDuration(double seconds);
+
+private:
+    void print(long long done);
+
+    long long total_;
+    long long start_;
+    std::ostream& out_;
+    std::chrono::steady_clock::duration interval_;
+    std::chrono::steady_clock::time_point begin_;
+    std::chrono::steady_clock::time_point next_;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,25 @@
+#ifndef CLI_OPTIONS_H
+#define CLI_OPTIONS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 命令列參數：位置參數維持原本的意義，另外接受 --flag 與 --key=value 形式的選項。
+class CliOptions {
+public:
+    CliOptions(int argc, char* argv[]);
+
+    const std::vector<std::string>& positional() const { return positional_; }
+    bool has(const std::string& key) const { return flags_.count(key) != 0; }
+
+    std::string get(const std::string& key, const std::string& def = "") const;
+    int         getInt(const std::string& key, int def) const;
+    double      getDouble(const std::string& key, double def) const;
+
+private:
+    std::vector<std::string> positional_;
+    std::unordered_map<std::string, std::string> flags_;
+};
+
+#endif // CLI_OPTIONS_H
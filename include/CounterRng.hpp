@@ -0,0 +1,75 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// ────────────────────────────────────────────────
+// Counter-based RNG (Philox4x32-10)
+//   亂數是 (key, counter) 的純函數，不需要保存或依序推進狀態：
+//   每個 fault 使用自己的 stream、每個 sample 使用自己的 counter 區段，
+//   因此不論用幾個 thread、以什麼順序計算，同一個 sample 得到的亂數都相同。
+// ────────────────────────────────────────────────
+class CounterRng {
+public:
+    using Block = std::array<uint32_t, 4>;
+
+    explicit CounterRng(uint64_t seed)
+        : key_{ static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) } {}
+
+    // Philox4x32-10：counter (4 x 32 bit) → 128 bit 亂數
+    Block block(Block ctr) const {
+        std::array<uint32_t, 2> key = key_;
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                key[0] += 0x9E3779B9u;
+                key[1] += 0xBB67AE85u;
+            }
+            const uint64_t p0 = uint64_t{0xD2511F53u} * ctr[0];
+            const uint64_t p1 = uint64_t{0xCD9E8D57u} * ctr[2];
+            ctr = { static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+                    static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0) };
+        }
+        return ctr;
+    }
+
+    // stream / counter 各 64 bit，回傳 64 bit 亂數
+    uint64_t bits(uint64_t stream, uint64_t counter) const {
+        const Block out = block({ static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                                  static_cast<uint32_t>(stream),  static_cast<uint32_t>(stream >> 32) });
+        return (uint64_t{out[1]} << 32) | out[0];
+    }
+
+    // [0, 1) 的 double (取 53 bit)
+    double uniform(uint64_t stream, uint64_t counter) const {
+        return static_cast<double>(bits(stream, counter) >> 11) * 0x1.0p-53;
+    }
+
+private:
+    std::array<uint32_t, 2> key_;
+};
+
+// 一個 (stream, 起始 counter) 上依序取用的亂數；符合 UniformRandomBitGenerator，
+// 可直接搭配 std::uniform_int_distribution 等使用
+class CounterRngStream {
+public:
+    using result_type = uint64_t;
+
+    CounterRngStream(const CounterRng& rng, uint64_t stream, uint64_t counter = 0)
+        : rng_(&rng), stream_(stream), counter_(counter) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return rng_->bits(stream_, counter_++); }
+
+    double uniform() { return rng_->uniform(stream_, counter_++); }
+    uint64_t counter() const { return counter_; }
+
+private:
+    const CounterRng* rng_;
+    uint64_t stream_;
+    uint64_t counter_;
+};
+
+#endif // COUNTER_RNG_H
@@ -0,0 +1,53 @@
+#ifndef DATA_BACKGROUND_H
+#define DATA_BACKGROUND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ────────────────────────────────────────────────
+// Data background (word-oriented memory)
+//   March test 中的 w0 / r0 代表寫入 / 讀出 background 本身，
+//   w1 / r1 代表其反相。不同 background 讓同一 word 內相鄰 bit
+//   出現不同的組合，才能偵測 intra-word coupling fault。
+//   以實體欄位 (col * width + bit) 與 row 的奇偶決定每個 bit 的值。
+// ────────────────────────────────────────────────
+enum class DataBackground {
+    Solid,        // 全 0
+    Checkerboard, // (row + 實體欄位) 的奇偶交錯
+    RowStripe,    // 奇數 row 全 1
+    ColumnStripe  // 奇數實體欄位為 1
+};
+
+// 寬度 width 的全 1 mask (1 ≤ width ≤ 64)
+inline uint64_t wordMask(int width) {
+    return width >= 64 ? ~uint64_t{0} : ((uint64_t{1} << width) - 1);
+}
+
+// 位址 (row, col) 上寬度 width 的 word 在此 background 下的值
+inline uint64_t backgroundWord(DataBackground bg, int row, int col, int width) {
+    const uint64_t mask = wordMask(width);
+    const uint64_t oddBits = 0xAAAAAAAAAAAAAAAAULL & mask;  // bit 1, 3, 5 … 為 1
+    const int firstColumn = col * width;                    // 此 word 第 0 bit 的實體欄位
+    switch (bg) {
+        case DataBackground::Solid:
+            return 0;
+        case DataBackground::Checkerboard:
+            return ((row + firstColumn) & 1) ? (~oddBits & mask) : oddBits;
+        case DataBackground::RowStripe:
+            return (row & 1) ? mask : 0;
+        case DataBackground::ColumnStripe:
+            return (firstColumn & 1) ? (~oddBits & mask) : oddBits;
+    }
+    return 0;
+}
+
+// "solid" / "checkerboard" / "row" / "column"；不認得時丟出 std::runtime_error
+DataBackground parseDataBackground(const std::string& name);
+
+// 以逗號分隔的清單，例如 "solid,checkerboard"
+std::vector<DataBackground> parseDataBackgrounds(const std::string& list);
+
+const char* toString(DataBackground bg);
+
+#endif // DATA_BACKGROUND_H
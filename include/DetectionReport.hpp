@@ -1,6 +1,7 @@
 #ifndef DETECTION_REPORT_H
 #define DETECTION_REPORT_H
 
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <set>
@@ -18,6 +19,57 @@ public:
     std::set<int> detectedVicAddrs_; // Set of detected victim addresses
 
     std::map<MarchIdx, bool> detected_; // Map of MarchIdx to detection status
+
+    bool operator==(const DetectionReport& other) const {
+        return isDetected_ == other.isDetected_ &&
+               detectedVicAddrs_ == other.detectedVicAddrs_ &&
+               detected_ == other.detected_;
+    }
+};
+
+// Word-oriented 模擬結果：lane j 代表 victim 位於 word 內第 j 個 bit 的情形。
+class WordDetectionReport {
+public:
+    uint64_t validLanes_ {0};           // 有意義的 bit 位置
+    std::vector<uint64_t> detected_[2]; // [init][background index]：被偵測到的 lanes
+
+    // 任一 background 偵測到即算偵測
+    uint64_t detectedLanes(int init) const {
+        uint64_t lanes = 0;
+        for (uint64_t d : detected_[init & 1]) lanes |= d;
+        return lanes;
+    }
+};
+
+// Linked fault (多個 fault 共用 victim) 的模擬結果。
+class LinkedDetectionReport {
+public:
+    std::vector<int> members_;     // 組合中各 fault 在 fault library 中的索引
+    bool detected_[2] {false, false}; // [init] 組合是否被偵測
+    bool masked_[2] {false, false};   // [init] 有成員單獨時會被偵測，組合後卻沒有
+};
+
+// Monte-Carlo 模式的參數
+struct MonteCarloOptions {
+    int maxSamples {10000};    // 每個 fault 的樣本上限
+    int minSamples {32};       // 至少取這麼多樣本才檢查停止條件
+    double tolerance {0.02};   // 信賴區間半寬小於此值即停止
+    double confidence {0.95};
+    double activation {1.0};   // 1-cell / 2-cell fault 觸發時真正生效的機率
+    int threads {0};           // 0 = hardware concurrency
+    uint64_t seed {12345};
+};
+
+// Monte-Carlo 模擬結果：隨機擺放 / power-up 內容 (/ 機率性觸發) 下被偵測的機率。
+class MonteCarloReport {
+public:
+    long long samples_ {0};
+    long long detected_ {0};
+    double lo_ {0.0};         // 信賴區間 (Wilson score interval)
+    double hi_ {1.0};
+    bool converged_ {false};  // 區間半寬已小於容許誤差 (否則為達到樣本上限)
+
+    double estimate() const { return samples_ ? static_cast<double>(detected_) / samples_ : 0.0; }
 };
 
 #endif // DETECTION_REPORT_H
\ No newline at end of file
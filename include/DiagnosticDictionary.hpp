@@ -0,0 +1,79 @@
+#ifndef DIAGNOSTIC_DICTIONARY_H
+#define DIAGNOSTIC_DICTIONARY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DetectionReport.hpp"
+#include "FaultConfig.hpp"
+#include "March.hpp"
+#include "ResultStore.hpp"
+
+// ────────────────────────────────────────────────
+// 診斷字典 (fault dictionary)
+//   由模擬結果建立 syndrome → fault 集合的反查表：給定測試機觀察到的失敗 read，
+//   找出能解釋它的 fault primitive。
+//   - 每個 fault 的 init 0 / init 1 syndrome 各為一筆 (測試機不知道 power-up 內容)；
+//     全 0 的 syndrome (未被偵測) 不列入。
+//   - exact()：hash 查表，O(read 數 / 64)。
+//   - nearest()：所有不同的 syndrome 連續存放，逐一以 popcount 計算 Hamming 距離，
+//     回傳距離最小的 fault；syndrome 數量等於不同的失敗型態數，通常遠小於 fault 數。
+//   - 等價類別：init 0 / init 1 兩個 syndrome 都相同的 fault 無法以此 March test 區分，
+//     類別數 / 被偵測的 fault 數即為診斷解析度。
+//   save() / load() 以 JSON 保存，載入後不需重新模擬即可查詢。
+// ────────────────────────────────────────────────
+class DiagnosticDictionary {
+public:
+    // nearest() 的結果：faults 為 fault 在 library 中的索引 (遞增)
+    struct Match {
+        int distance {-1};          // -1 表示字典為空或超過 maxDistance
+        std::vector<int> faults;
+    };
+
+    DiagnosticDictionary() = default;
+    // results 為 faults 的模擬結果 (索引相同)，read 順序取自 results
+    DiagnosticDictionary(const std::vector<FaultConfig>& faults, const ResultStore& results);
+
+    // DetectionReport → syndrome (依本字典的 read 順序)
+    Syndrome syndromeOf(const DetectionReport& report) const;
+
+    // 完全相同的 syndrome；沒有時回傳 nullptr
+    const std::vector<int>* exact(const Syndrome& observed) const;
+    // Hamming 距離最小的 syndrome 所對應的 fault (距離相同者合併)；maxDistance < 0 表示不限
+    Match nearest(const Syndrome& observed, int maxDistance = -1) const;
+
+    // 無法區分的 fault 集合 (只含被偵測的 fault)，依最小索引排序
+    const std::vector<std::vector<int>>& equivalenceClasses() const { return classes_; }
+    // 等價類別數 / 被偵測的 fault 數 (1 = 每個 fault 都可唯一診斷)
+    double resolution() const;
+
+    int readCount() const { return static_cast<int>(readIdx_.size()); }
+    int syndromeCount() const { return static_cast<int>(syndromes_.size()); }
+    int faultCount() const { return static_cast<int>(ids_.size()); }
+    const FaultID& faultId(int fault) const { return ids_[fault]; }
+
+    void save(const std::string& filename) const;
+    static DiagnosticDictionary load(const std::string& filename);
+
+private:
+    // fault 加入 syndrome 對應的集合 (重複時略過)；回傳 syndrome 編號，全 0 時回傳 -1
+    int insert(const Syndrome& syndrome, int fault);
+    // 加入一個 fault 的 init 0 / init 1 syndrome
+    void addFault(const FaultID& id, const Syndrome& init0, const Syndrome& init1);
+    void buildClasses();
+
+    std::vector<MarchIdx> readIdx_;                    // 第 i 個 bit 對應的 read 操作
+    std::unordered_map<int, int> bitOf_;               // overallIdx → bit
+    std::vector<FaultID> ids_;
+    std::vector<std::pair<int, int>> entryOf_;         // 各 fault 的 (init 0, init 1) syndrome 編號，-1 = 未偵測
+    std::vector<Syndrome> syndromes_;                  // 不同的 syndrome
+    std::vector<std::vector<int>> faults_;             // syndromes_[k] 對應的 fault
+    std::unordered_map<Syndrome, int, SyndromeHash> index_; // syndrome → k
+    std::vector<uint64_t> packed_;                     // syndromes_ 連續存放，供 nearest() 掃描
+    int stride_ {0};                                   // 每個 syndrome 佔幾個 word
+    std::vector<std::vector<int>> classes_;
+    int detected_ {0};
+};
+
+#endif // DIAGNOSTIC_DICTIONARY_H
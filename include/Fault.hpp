@@ -1,12 +1,18 @@
 #ifndef FAULT_H
 #define FAULT_H
 
-#include <deque>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
+#include <vector>
+#include "AddressDecoder.hpp"
+#include "CounterRng.hpp"
 #include "FaultConfig.hpp"
 #include "MemoryState.hpp"
 #include "March.hpp"
+#include "Neighborhood.hpp"
+#include "SimClock.hpp"
 
 // ────────────────────────────────────────────────
 // 1. 共用資料結構
@@ -23,6 +29,125 @@ struct OperationRecord {
     }
 };
 
+// 連續相同的 (before value, op) 記錄合併成一段 (run-length)
+struct OperationRun {
+    OperationRecord rec;
+    long long count {0};
+};
+
+// 在 run-length 序列尾端追加 n 筆相同的記錄
+inline void appendRun(std::vector<OperationRun>& runs, const OperationRecord& rec, long long n) {
+    if (!runs.empty() && runs.back().rec == rec) runs.back().count += n;
+    else runs.push_back({rec, n});
+}
+
+// 把觸發序列 (含 op^N) 展開成 run-length 記錄；firstBefore 為第一個操作的 before value。
+// 寫入 runs (先清空，沿用其容量)
+inline void toOperationRuns(int firstBefore, std::span<const SingleOp> ops, std::vector<OperationRun>& runs) {
+    runs.clear();
+    int before = firstBefore;
+    for (const auto& op : ops) {
+        const SingleOp one{op.type_, op.value_};
+        appendRun(runs, {before, one}, 1);
+        if (op.repeat_ > 1) appendRun(runs, {op.value_, one}, op.repeat_ - 1);
+        before = op.value_;
+    }
+}
+
+inline std::vector<OperationRun> toOperationRuns(int firstBefore, std::span<const SingleOp> ops) {
+    std::vector<OperationRun> runs;
+    toOperationRuns(firstBefore, ops, runs);
+    return runs;
+}
+
+// 只保留最近 capacity 筆的環狀緩衝，取代 deque 的 push_back / pop_front：
+// 只有 setCapacity() 可能配置記憶體 (容量不足時)，push / clear 都不會。
+template <class T>
+class RingWindow {
+public:
+    void setCapacity(std::size_t capacity) {
+        buf_.resize(capacity);
+        clear();
+    }
+    void clear() { head_ = size_ = 0; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // 第 i 筆，0 為最舊的
+    T& operator[](std::size_t i) { return buf_[(head_ + i) % buf_.size()]; }
+    const T& operator[](std::size_t i) const { return buf_[(head_ + i) % buf_.size()]; }
+    T& back() { return (*this)[size_ - 1]; }
+
+    // 已滿時覆蓋最舊的一筆；容量為 0 時不保留任何記錄
+    void push(const T& v) {
+        if (buf_.empty()) return;
+        if (size_ < buf_.size()) {
+            (*this)[size_++] = v;
+        } else {
+            buf_[head_] = v;
+            head_ = (head_ + 1) % buf_.size();
+        }
+    }
+
+    // 內容 (由舊到新) 是否與 seq 相同
+    template <class Seq>
+    bool equals(const Seq& seq) const {
+        if (size_ != seq.size()) return false;
+        for (std::size_t i = 0; i < size_; ++i)
+            if (!((*this)[i] == seq[i])) return false;
+        return true;
+    }
+
+private:
+    std::vector<T> buf_;
+    std::size_t head_ {0};
+    std::size_t size_ {0};
+};
+
+// h[start] 起算的 pattern.size() 段是否與 pattern 相符 (兩者皆已合併)。
+// 展開後的視窗只能從第一段的尾巴開始；atEnd 時視窗必須結束在最後一段的結尾，
+// 否則最後一段也可以只用到開頭。
+template <class Runs>
+bool runsMatch(const Runs& h, std::size_t start, const std::vector<OperationRun>& pattern, bool atEnd) {
+    const std::size_t k = pattern.size();
+    for (std::size_t j = 0; j < k; ++j) {
+        const OperationRun& run = h[start + j];
+        if (!(run.rec == pattern[j].rec)) return false;
+        const bool partial = (j == 0) || (j + 1 == k && !atEnd);
+        if (partial ? run.count < pattern[j].count : run.count != pattern[j].count) return false;
+    }
+    return true;
+}
+
+// 以計數器比對「最近的記錄是否恰好以 pattern 結尾」，等同展開後 history_ == pattern_，
+// 但只保留最近 pattern.size() 段，每次 feed 為 O(段數) 而與重複次數無關。
+class RunLengthMatcher {
+public:
+    RunLengthMatcher() = default;
+    explicit RunLengthMatcher(std::vector<OperationRun> pattern) : pattern_(std::move(pattern)) {
+        history_.setCapacity(pattern_.size());
+    }
+
+    // 換成新的觸發序列 (沿用 pattern / history 的容量)
+    void setPattern(int firstBefore, std::span<const SingleOp> ops) {
+        toOperationRuns(firstBefore, ops, pattern_);
+        history_.setCapacity(pattern_.size());
+    }
+
+    bool feed(const OperationRecord& rec) {
+        if (!history_.empty() && history_.back().rec == rec) ++history_.back().count;
+        else history_.push({rec, 1});
+        if (history_.size() < pattern_.size()) return false;
+        return runsMatch(history_, 0, pattern_, true);
+    }
+
+    void reset() { history_.clear(); }
+
+private:
+    std::vector<OperationRun> pattern_;
+    RingWindow<OperationRun> history_;
+};
+
 // ────────────────────────────────────────────────
 // 2. Trigger Strategy 介面
 // ────────────────────────────────────────────────
@@ -52,6 +177,9 @@ public:
     OneCellSequenceTrigger(int vicAddr,
                            std::shared_ptr<const FaultConfig> cfg);
 
+    // 換成另一個 fault (FaultPool 重複使用)，參數同建構子
+    void bind(int vicAddr, std::shared_ptr<const FaultConfig> cfg);
+
     void feed(int addr, const SingleOp& op, int beforeValue) override;
 
     bool matched() const override { return matched_; }
@@ -66,8 +194,8 @@ public:
 private:
     int vicAddr_;
     std::shared_ptr<const FaultConfig> cfg_;
-    std::deque<OperationRecord> pattern_;
-    std::deque<OperationRecord> history_;
+    std::vector<OperationRecord> pattern_;
+    RingWindow<OperationRecord> history_;
     bool matched_ {false};
 };
 
@@ -80,6 +208,9 @@ public:
     TwoCellCoupledTrigger(int aggrAddr, int vicAddr,
                           std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem);
 
+    void bind(int aggrAddr, int vicAddr,
+              std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem);
+
     void feed(int addr, const SingleOp& op, int beforeValue) override;
 
     bool matched() const override { return matched_; }
@@ -96,21 +227,126 @@ private:
     int vicAddr_;
     std::shared_ptr<const FaultConfig> cfg_;
     std::shared_ptr<MemoryState> mem_; // 用於讀取耦合 cell 的值
-    std::deque<OperationRecord> pattern_;
-    std::deque<OperationRecord> history_;
+    std::vector<OperationRecord> pattern_;
+    RingWindow<OperationRecord> history_;
     int coupledTriggerValue_ {-1}; // 用於記錄 coupled cell 的值
     bool matched_ {false};
 };
 
+// ────────────────────────────────────────────────
+// 2‑3. Counted Sequence Trigger
+//     (觸發序列含 op^N，例如 hammer / read disturb 需要上千次重複存取)
+//     以 RunLengthMatcher 計數取代逐一比對的 deque；
+//     coupledAddr < 0 時行為同 OneCellSequenceTrigger，否則同 TwoCellCoupledTrigger。
+// ────────────────────────────────────────────────
+class CountedSequenceTrigger final : public ITrigger {
+public:
+    CountedSequenceTrigger(int trigAddr, int coupledAddr,
+                           std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem);
+
+    void bind(int trigAddr, int coupledAddr,
+              std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem);
+
+    void feed(int addr, const SingleOp& op, int beforeValue) override;
+
+    bool matched() const override { return matched_; }
+
+    void setTrigCond() override;
+
+    void reset() override {
+        matcher_.reset();
+        matched_ = false;
+    }
+
+private:
+    int trigAddr_;    // 觸發序列作用的 cell
+    int coupledAddr_; // 需要符合 coupledValue_ 的另一個 cell，-1 表示沒有
+    std::shared_ptr<const FaultConfig> cfg_;
+    std::shared_ptr<MemoryState> mem_;
+    RunLengthMatcher matcher_;
+    int coupledValue_ {-1};
+    bool matched_ {false};
+};
+
+// ────────────────────────────────────────────────
+// 2‑4. N‑Cell Pattern Trigger
+//     (trigger cell 上出現特定操作序列，且鄰域其餘 cell 符合指定狀態時觸發)
+//     鄰域的值以 packed bit pattern 保存 (bit k = 鄰域索引 k 的 cell)，
+//     由 fault 在每次寫入後以 observe() 增量更新；
+//     比對只需一次 (packed & care) == value，與鄰域大小無關。
+// ────────────────────────────────────────────────
+class NCellPatternTrigger final : public ITrigger {
+public:
+    NCellPatternTrigger(const std::vector<int>& cells, int cols,
+                        std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem);
+
+    void bind(const std::vector<int>& cells, int cols,
+              std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem);
+
+    void feed(int addr, const SingleOp& op, int beforeValue) override;
+
+    bool matched() const override { return matched_; }
+
+    void setTrigCond() override;
+
+    void reset() override {
+        matcher_.reset();
+        matched_ = false;
+    }
+
+    // 位址 addr 的值變成 value 後呼叫 (不在鄰域內的位址忽略)
+    void observe(int addr, int value) {
+        const int slot = slotOf(addr);
+        if (slot < 0) return;
+        if (value) packed_ |= (1u << slot);
+        else       packed_ &= ~(1u << slot);
+    }
+
+    // 位址在鄰域中的索引，-1 表示不在鄰域內
+    int slotOf(int addr) const {
+        if (addr < 0) return -1;
+        return NeighborhoodLayout::slotOf(static_cast<int>(cells_.size()),
+                                          addr / cols_ - vicRow_, addr % cols_ - vicCol_);
+    }
+
+    uint32_t pattern() const { return packed_; }
+
+    // 記憶體被整塊換掉後呼叫 (⇕ 分岔還原)：下一次 feed 重新載入鄰域的值
+    void resync() { synced_ = false; }
+
+private:
+    std::vector<int> cells_;
+    int cols_ {0};
+    int vicRow_ {0}, vicCol_ {0};
+    std::shared_ptr<const FaultConfig> cfg_;
+    std::shared_ptr<MemoryState> mem_; // 第一次 feed 時載入鄰域初值
+    RunLengthMatcher matcher_;         // trigger cell 上的操作序列
+    uint32_t packed_ {0};    // 目前鄰域的值
+    uint32_t careMask_ {0};  // 需要比對的 cell (不含 trigger cell 與 don't care)
+    uint32_t careValue_ {0}; // 這些 cell 需要的值
+    bool synced_ {false};
+    bool matched_ {false};
+};
+
 // ────────────────────────────────────────────────
 // 3. Fault 基底 (含共通邏輯)
 // ────────────────────────────────────────────────
+
+// March element 邊界上 fault 除了記憶體以外的狀態 (⇕ 兩個方向分岔時保存 / 還原)；
+// trigger 在每個 element 開頭都會 reset，不必保存
+struct FaultForkState {
+    SimTime deadline {kNever}; // RetentionFault 的下一個事件
+
+    bool operator==(const FaultForkState&) const = default;
+};
+
 class IFault {
 protected:
     std::shared_ptr<MemoryState> mem_;
     std::shared_ptr<const FaultConfig> cfg_;
     std::unique_ptr<ITrigger> trigger_;
     int vicAddr_ {-1}; // 受影響的 victim cell 地址
+    const SimClock* clock_ {nullptr}; // SequenceExecutor 的模擬時鐘 (time-dependent fault 使用)
 
     IFault(std::shared_ptr<const FaultConfig> cfg,
               std::shared_ptr<MemoryState> mem,
@@ -118,14 +354,53 @@ protected:
               int vicAddr)
         : mem_(std::move(mem)), cfg_(std::move(cfg)), trigger_(std::move(trig)), vicAddr_(vicAddr) {}
 
-    void payload(); // 實際把 fault value 寫入 victim
+    virtual void payload(); // 實際把 fault value 寫入 victim
+
+    // 子類別的 bind() 共用：換成新的 config / 記憶體 / victim (trigger 由呼叫端另行 bind)
+    void rebind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem, int vicAddr) {
+        cfg_ = std::move(cfg);
+        mem_ = std::move(mem);
+        vicAddr_ = vicAddr;
+    }
 
 public:
     // 由外部顯式呼叫，或由 Factory 內部調用
     virtual void writeProcess(int addr, const SingleOp& op) = 0;
     virtual int  readProcess (int addr, const SingleOp& op) = 0;
-    void reset() { trigger_->reset(); }
+    virtual void reset() { if (trigger_) trigger_->reset(); }
     virtual ~IFault() = default;
+
+    // 此位址上的操作是否會影響 fault 的狀態；回傳 false 時，
+    // SequenceExecutor 可把重複的操作 (op^N) 當成一次執行
+    virtual bool observes(int addr) const { (void)addr; return true; }
+
+    // ── 分解步驟 (供 LinkedFault 組合多個 fault 使用) ──
+    // 只餵入操作、回傳是否觸發，不修改記憶體；beforeValue 為操作前的值
+    virtual bool sense(int addr, const SingleOp& op, int beforeValue) {
+        if (!trigger_) return false;
+        trigger_->feed(addr, op, beforeValue);
+        return trigger_->matched();
+    }
+    // 觸發時是否取代本次寫入 (TwoCellFault：先觸發，寫入被吃掉)
+    virtual bool overridesWrite() const { return false; }
+
+    // ── 時間相關 (retention / leakage) ──
+    // SequenceExecutor 在 execute() 開始時呼叫；記憶體此時已是初始內容
+    virtual void attachClock(const SimClock* clock) { clock_ = clock; }
+    // timed() 為 false 時 executor 不會查詢 nextEvent()
+    virtual bool timed() const { return false; }
+    // 下一個事件的時間 (kNever 表示沒有)；onEvent 處理所有 <= now 的事件
+    virtual SimTime nextEvent() const { return kNever; }
+    virtual void onEvent(SimTime now) { (void)now; }
+
+    // ── ⇕ 分岔 (SequenceExecutor::setBothDirections) ──
+    // 只在 element 邊界呼叫；restoreState 之前記憶體已還原成同一個分支的內容
+    virtual FaultForkState saveState() const { return {}; }
+    virtual void restoreState(const FaultForkState& state) { (void)state; }
+    MemoryState& memory() const { return *mem_; }
+
+    void inject() { payload(); }
+    int  finalRead() const { return cfg_->finalReadValue_; }
 };
 
 // --------------------------------------------------
@@ -146,9 +421,14 @@ public:
     static std::unique_ptr<OneCellFault> create(std::shared_ptr<const FaultConfig> cfg,
                                                 std::shared_ptr<MemoryState> mem,
                                                 int vicAddr);
+    // FaultPool 重複使用：trigger 由 pool 另行 bind
+    void bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem, int vicAddr) {
+        rebind(std::move(cfg), std::move(mem), vicAddr);
+    }
 
     void writeProcess(int addr, const SingleOp& op) override;
     int  readProcess (int addr, const SingleOp& op) override;
+    bool observes(int addr) const override { return addr == vicAddr_; }
 };
 
 // ────────────────────────────────────────────────
@@ -169,9 +449,157 @@ public:
                                                std::shared_ptr<MemoryState> mem,
                                                int aggrAddr,
                                                int vicAddr);
+    void bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+              int aggrAddr, int vicAddr) {
+        rebind(std::move(cfg), std::move(mem), vicAddr);
+        aggrAddr_ = aggrAddr;
+    }
 
     void writeProcess(int addr, const SingleOp& op) override;
     int  readProcess (int addr, const SingleOp& op) override;   
+    bool overridesWrite() const override { return true; }
+    bool observes(int addr) const override { return addr == aggrAddr_ || addr == vicAddr_; }
+};
+
+// ────────────────────────────────────────────────
+// 3‑3. NCellFault (3-cell coupling、5 / 9-cell NPSF)
+//     操作照常寫入，觸發條件以操作前的鄰域判斷；觸發時 victim 改為 fault value。
+//     trigger cell 即 victim 時 (passive / static NPSF)，觸發的 read 回傳 finalReadValue_；
+//     trigger cell 為鄰居時 (active NPSF、3-cell CF)，鄰居本身的讀寫不受影響。
+// ────────────────────────────────────────────────
+class NCellFault final : public IFault {
+public:
+    NCellFault(std::shared_ptr<const FaultConfig> cfg,
+               std::shared_ptr<MemoryState> mem,
+               std::unique_ptr<NCellPatternTrigger> trig,
+               int vicAddr)
+        : IFault(std::move(cfg), std::move(mem), nullptr, vicAddr), pattern_(trig.get()) {
+        trigger_ = std::move(trig);
+    }
+    // cells 為鄰域順序的位址 (見 NeighborhoodLayout)，cols 為記憶體寬度
+    static std::unique_ptr<NCellFault> create(std::shared_ptr<const FaultConfig> cfg,
+                                              std::shared_ptr<MemoryState> mem,
+                                              const std::vector<int>& cells,
+                                              int cols);
+    // 連同自己的 trigger 一起換成新的鄰域
+    void bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+              const std::vector<int>& cells, int cols);
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    bool observes(int addr) const override { return pattern_->slotOf(addr) >= 0; }
+    void restoreState(const FaultForkState&) override { pattern_->resync(); }
+
+private:
+    NCellPatternTrigger* pattern_; // 與 trigger_ 相同物件，用於 observe()
+};
+
+// ────────────────────────────────────────────────
+// 3‑4. DecoderFault (address decoder fault)
+//     SequenceExecutor 與 MemoryState 之間的位址對應層：
+//     DecodeTable 中沒有的位址走 identity 路徑直接讀寫記憶體，
+//     有的位址改為存取表中的 cell (可能沒有、或有多個)。
+//     沒有觸發序列也沒有內部狀態，重複的操作與做一次相同。
+// ────────────────────────────────────────────────
+class DecoderFault final : public IFault {
+public:
+    // floatingValue：選不到 cell 時讀到的值 (-1 表示不確定)；wiredOr：多個 cell 時讀值取 OR，否則取 AND
+    DecoderFault(std::shared_ptr<MemoryState> mem, std::shared_ptr<const DecodeTable> table,
+                 int floatingValue, bool wiredOr, int vicAddr)
+        : IFault(nullptr, std::move(mem), nullptr, vicAddr), table_(std::move(table)),
+          floatingValue_(floatingValue), wiredOr_(wiredOr) {}
+    // addr 為故障的位址，partner 為 MultiCell / WrongCell 另外選到的 cell
+    static std::unique_ptr<DecoderFault> create(std::shared_ptr<const FaultConfig> cfg,
+                                                std::shared_ptr<MemoryState> mem,
+                                                int addr,
+                                                int partner);
+    // 依 cfg 的種類把 addr 的解碼結果寫入 table (table 原有的內容會被清除)
+    static void fillTable(DecodeTable& table, const FaultConfig& cfg, int addr, int partner);
+    // FaultPool 重複使用：table 由 pool 先以 fillTable 更新
+    void bind(const FaultConfig& cfg, std::shared_ptr<MemoryState> mem, int addr) {
+        rebind(nullptr, std::move(mem), addr);
+        floatingValue_ = cfg.faultValue_;
+        wiredOr_ = cfg.faultValue_ == 1;
+    }
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    bool observes(int addr) const override { (void)addr; return false; }
+    const DecodeTable& table() const { return *table_; }
+
+private:
+    std::shared_ptr<const DecodeTable> table_;
+    int floatingValue_;
+    bool wiredOr_;
+};
+
+// ────────────────────────────────────────────────
+// 3‑5. LineFault (word line / bit line fault)
+//     觸發條件與 OneCellFault 相同，作用在線上的一個 cell (vicAddr_)；
+//     觸發時 payload 以 MemoryState::fillLine 一次寫入整條 row / column，
+//     而不是替線上每個 cell 各建一個 fault。只有觸發 cell 的操作會改變狀態。
+// ────────────────────────────────────────────────
+class LineFault final : public IFault {
+public:
+    LineFault(std::shared_ptr<const FaultConfig> cfg,
+              std::shared_ptr<MemoryState> mem,
+              std::unique_ptr<ITrigger> trig,
+              int vicAddr,
+              LineRange line)
+        : IFault(std::move(cfg), std::move(mem), std::move(trig), vicAddr), line_(line) {}
+    // vicAddr 為觸發 cell，必須位於 line 上
+    static std::unique_ptr<LineFault> create(std::shared_ptr<const FaultConfig> cfg,
+                                             std::shared_ptr<MemoryState> mem,
+                                             int vicAddr,
+                                             LineRange line);
+    void bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+              int vicAddr, LineRange line);
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    bool observes(int addr) const override { return addr == vicAddr_; }
+    const LineRange& line() const { return line_; }
+
+protected:
+    void payload() override { mem_->fillLine(line_, cfg_->faultValue_); }
+
+private:
+    LineRange line_;
+};
+
+// ────────────────────────────────────────────────
+// 3‑6. RetentionFault (data retention / charge leakage)
+//     victim 保持 VI_ 超過 retentionTime_ 沒有被寫入 (leakage 時讀取也算) 就變成 fault value。
+//     只記錄一個 deadline：寫入 / 讀取時更新，時間到了由 executor 呼叫 onEvent()，
+//     因此 Del 暫停多久都不需要逐 cycle 模擬。
+// ────────────────────────────────────────────────
+class RetentionFault final : public IFault {
+public:
+    RetentionFault(std::shared_ptr<const FaultConfig> cfg,
+                   std::shared_ptr<MemoryState> mem,
+                   int vicAddr)
+        : IFault(std::move(cfg), std::move(mem), nullptr, vicAddr) {}
+    static std::unique_ptr<RetentionFault> create(std::shared_ptr<const FaultConfig> cfg,
+                                                  std::shared_ptr<MemoryState> mem,
+                                                  int vicAddr);
+    void bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem, int vicAddr);
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    bool observes(int addr) const override { return addr == vicAddr_; }
+
+    void attachClock(const SimClock* clock) override;
+    bool timed() const override { return true; }
+    SimTime nextEvent() const override { return deadline_; }
+    void onEvent(SimTime now) override;
+    FaultForkState saveState() const override { return { deadline_ }; }
+    void restoreState(const FaultForkState& state) override { deadline_ = state.deadline; }
+
+private:
+    // victim 目前的值為 value 時，從現在起重新計時
+    void restore(int value);
+
+    SimTime deadline_ {kNever};
 };
 
 // ────────────────────────────────────────────────
@@ -190,6 +618,216 @@ struct FaultFactory {
                                                    int vicAddr) {
         return TwoCellFault::create(std::move(cfg), std::move(mem), aggrAddr, vicAddr);
     }
+
+    static std::unique_ptr<IFault> makeNCellFault(std::shared_ptr<const FaultConfig> cfg,
+                                                 std::shared_ptr<MemoryState> mem,
+                                                 const std::vector<int>& cells,
+                                                 int cols) {
+        return NCellFault::create(std::move(cfg), std::move(mem), cells, cols);
+    }
+
+    static std::unique_ptr<IFault> makeDecoderFault(std::shared_ptr<const FaultConfig> cfg,
+                                                   std::shared_ptr<MemoryState> mem,
+                                                   int addr,
+                                                   int partner) {
+        return DecoderFault::create(std::move(cfg), std::move(mem), addr, partner);
+    }
+
+    static std::unique_ptr<IFault> makeLineFault(std::shared_ptr<const FaultConfig> cfg,
+                                                std::shared_ptr<MemoryState> mem,
+                                                int vicAddr,
+                                                LineRange line) {
+        return LineFault::create(std::move(cfg), std::move(mem), vicAddr, line);
+    }
+
+    static std::unique_ptr<IFault> makeRetentionFault(std::shared_ptr<const FaultConfig> cfg,
+                                                     std::shared_ptr<MemoryState> mem,
+                                                     int vicAddr) {
+        return RetentionFault::create(std::move(cfg), std::move(mem), vicAddr);
+    }
+};
+
+// ────────────────────────────────────────────────
+// 4‑1. FaultPool (逐一模擬時重複使用 fault / trigger 物件)
+//     每種 (fault, trigger) 組合只在第一次用到時以 create 配置，之後以 bind() 換上新的
+//     config 與位址並清除狀態；pattern / history 等容器沿用原有的容量，
+//     因此穩定後每個 fault 都不再配置記憶體。分派規則與 FaultSimulator 的 buildFault 相同。
+//     回傳的 fault 在下一次 acquire() 前有效；pool 不複製 cfg，呼叫端須保證它在模擬期間存在
+//     (例如以 aliasing 建構子產生不擁有的 shared_ptr)。
+// ────────────────────────────────────────────────
+class FaultPool {
+public:
+    // line 只有 line fault 使用，cells / cols 只有 N-cell fault 使用
+    IFault& acquire(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+                    int aggrAddr, int vicAddr, const std::vector<int>& cells, int cols,
+                    const LineRange& line);
+
+private:
+    template <class F, class T>
+    struct Slot {
+        std::unique_ptr<F> fault;
+        T* trigger {nullptr}; // 由 fault 擁有
+    };
+
+    Slot<OneCellFault, OneCellSequenceTrigger> oneCell_;
+    Slot<OneCellFault, CountedSequenceTrigger> oneCellCounted_;
+    Slot<TwoCellFault, TwoCellCoupledTrigger> twoCell_;
+    Slot<TwoCellFault, CountedSequenceTrigger> twoCellCounted_;
+    Slot<LineFault, OneCellSequenceTrigger> line_;
+    Slot<LineFault, CountedSequenceTrigger> lineCounted_;
+    std::unique_ptr<NCellFault> nCell_;
+    std::unique_ptr<RetentionFault> retention_;
+    std::unique_ptr<DecoderFault> decoder_;
+    std::shared_ptr<DecodeTable> decodeTable_;
+};
+
+// ────────────────────────────────────────────────
+// 5. FaultOverlay (多個互不重疊的 fault 共用一塊記憶體)
+//     以 per-address 表格記錄每個位址屬於哪個 fault；
+//     不屬於任何 fault 的位址直接讀寫記憶體 (fault-free)。
+//     每個 fault 只會收到自己 cell 上的操作。
+// ────────────────────────────────────────────────
+class FaultOverlay final : public IFault {
+public:
+    FaultOverlay(std::shared_ptr<MemoryState> mem, int memorySize)
+        : IFault(nullptr, std::move(mem), nullptr, -1), owner_(memorySize, -1) {}
+
+    // 加入一個 fault，cells 為它佔用的位址；回傳其在 overlay 中的編號
+    int add(std::unique_ptr<IFault> fault, const std::vector<int>& cells);
+
+    // 該位址所屬 fault 的編號，-1 表示 fault-free
+    int ownerOf(int addr) const {
+        return (addr < 0 || addr >= static_cast<int>(owner_.size())) ? -1 : owner_[addr];
+    }
+    std::size_t size() const { return faults_.size(); }
+
+    // 移除所有 fault (表格大小不變)
+    void clear();
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    void reset() override;
+    bool observes(int addr) const override {
+        const int owner = ownerOf(addr);
+        return owner >= 0 && faults_[owner]->observes(addr);
+    }
+
+    // 轉給所有成員；nextEvent / onEvent 只看 timed() 的成員
+    void attachClock(const SimClock* clock) override;
+    bool timed() const override { return !timed_.empty(); }
+    SimTime nextEvent() const override;
+    void onEvent(SimTime now) override;
+
+private:
+    std::vector<int> owner_;                    // per-address overlay table
+    std::vector<int> timed_;                    // timed() 成員的編號
+    std::vector<int> claimed_;                  // 已登記的位址，clear() 時只還原這些
+    std::vector<std::unique_ptr<IFault>> faults_;
+};
+
+// ────────────────────────────────────────────────
+// 5‑1. LinkedFault (多個 fault 共用同一塊記憶體、可共用 victim)
+//     每次操作：所有成員先以操作前的值 sense，
+//     若有觸發的成員 overridesWrite 則略過寫入，否則照常寫入，
+//     最後依序 inject 觸發成員的 fault value (後者覆蓋前者，即 masking)。
+//     只有一個成員時與該 fault 單獨模擬的結果完全相同。
+// ────────────────────────────────────────────────
+class LinkedFault final : public IFault {
+public:
+    LinkedFault(std::shared_ptr<MemoryState> mem, std::vector<std::unique_ptr<IFault>> members)
+        : IFault(nullptr, std::move(mem), nullptr, -1), members_(std::move(members)),
+          matched_(members_.size(), 0) {}
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    void reset() override;
+    bool observes(int addr) const override {
+        for (const auto& m : members_) if (m->observes(addr)) return true;
+        return false;
+    }
+    std::size_t size() const { return members_.size(); }
+
+private:
+    // 所有成員 sense 一次，回傳最後一個觸發的成員 (-1 表示沒有)
+    int senseAll(int addr, const SingleOp& op, bool& blocksWrite);
+
+    std::vector<std::unique_ptr<IFault>> members_;
+    std::vector<unsigned char> matched_;
+};
+
+// ────────────────────────────────────────────────
+// 5‑2. ProbabilisticFault (機率性觸發，Monte-Carlo 模式使用)
+//     以 sense / overridesWrite / inject 包裝一個 1-cell / 2-cell fault：
+//     觸發條件成立時，只有 coin 的亂數 < probability 才真的生效，否則本次操作與 fault-free 相同。
+//     probability = 1 時與被包裝的 fault 單獨模擬的結果完全相同。
+// ────────────────────────────────────────────────
+class ProbabilisticFault final : public IFault {
+public:
+    ProbabilisticFault(std::shared_ptr<MemoryState> mem, std::unique_ptr<IFault> inner,
+                       double probability, CounterRngStream coin)
+        : IFault(nullptr, std::move(mem), nullptr, -1), inner_(std::move(inner)),
+          probability_(probability), coin_(coin) {}
+
+    void writeProcess(int addr, const SingleOp& op) override;
+    int  readProcess (int addr, const SingleOp& op) override;
+    void reset() override { inner_->reset(); }
+    bool observes(int addr) const override { return inner_->observes(addr); }
+
+private:
+    // 觸發且 coin 成立
+    bool activated(int addr, const SingleOp& op);
+
+    std::unique_ptr<IFault> inner_;
+    double probability_;
+    CounterRngStream coin_;
+};
+
+// ────────────────────────────────────────────────
+// 6. WordLaneFault (word-oriented，bit-parallel)
+//     把「victim 位於 word 內第 j 個 bit」視為獨立的 universe j，
+//     以 uint64_t 的第 j 個 bit (lane) 記錄該 universe 中 victim 的值；
+//     一次 word 操作就同時模擬 fault 位於所有 bit 位置的情形。
+//     Two-cell fault 的 aggressor 為同一 word 內相鄰的 bit：
+//     A<V 時 victim j 的 aggressor 為 bit j-1，A>V 時為 bit j+1。
+//     Word 操作同時作用在 aggressor 與 victim 上，觸發判斷一律以操作前的值為準，
+//     觸發時 victim 改為 fault value (取代同一次的寫入)。
+//     觸發序列以 shift-and 方式逐 lane 比對，等同 history_ == pattern_。
+// ────────────────────────────────────────────────
+class WordLaneFault {
+public:
+    WordLaneFault(std::shared_ptr<const FaultConfig> cfg,
+                  std::shared_ptr<WordMemoryState> mem,
+                  int wordAddr);
+
+    // 有意義的 lane (two-cell fault 在 word 邊緣的 bit 沒有 aggressor)
+    uint64_t validLanes() const { return valid_; }
+
+    // 換一個 March element 時呼叫
+    void reset();
+
+    // 記憶體重新填入 background 後呼叫，重新載入 victim lanes
+    void reload();
+
+    void writeProcess(int addr, uint64_t data);
+
+    // 回傳讀值與 expected 不一致的 universe (lane mask)
+    uint64_t readProcess(int addr, uint64_t expected);
+
+private:
+    // universe j 中 aggressor bit 的值搬到 lane j
+    uint64_t aggressorLanes(uint64_t word) const;
+    uint64_t lanesOf(int bit) const { return bit ? mask_ : 0; }
+    // 餵入一次操作，回傳觸發的 lanes；good 為 fault-free word 在操作前的值
+    uint64_t feed(OpType type, uint64_t good, uint64_t value);
+
+    std::shared_ptr<const FaultConfig> cfg_;
+    std::shared_ptr<WordMemoryState> mem_;
+    int wordAddr_;
+    uint64_t mask_;
+    uint64_t valid_;
+    uint64_t vic_ {0};             // lane j：universe j 中 victim (bit j) 的值
+    std::vector<SingleOp> trig_;   // 觸發序列 (op^N 展開成 N 個操作)
+    std::vector<uint64_t> prefix_; // prefix_[k]：最近 k 個操作符合觸發序列前 k 步的 lanes
 };
 
 #endif // FAULT_H
\ No newline at end of file
@@ -1,17 +1,57 @@
 #ifndef FAULT_CONFIG_H
 #define FAULT_CONFIG_H
 
+#include <mutex>
+#include <ostream>
+#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include "AddressDecoder.hpp"
+#include "InlineVector.hpp"
 #include "March.hpp"
-#include "DetectionReport.hpp"
+#include "SimClock.hpp"
 
 enum class TwoCellFaultType { Sa, Sv };
-// Represents configuration for a fault from input.
+// Row = word line fault, Column = bit line fault
+enum class LineScope { None, Row, Column };
+// Retention = the cell loses its state if it is not written for a while (reads do not restore it)
+// Leakage   = same, but every read also restores the charge (DRAM-style)
+enum class TimeFaultKind { None, Retention, Leakage };
+
+// 共用的 fault 名稱：同一個字串在整個程式中只保存一份 (同名的 subcase 共用，不釋放)，
+// 比較與 hash 只需比對指標。可隱式轉成 const std::string&。
+class InternedName {
+public:
+    InternedName() : str_(intern({})) {}
+    InternedName(std::string_view text) : str_(intern(text)) {}
+    InternedName(const std::string& text) : str_(intern(text)) {}
+    InternedName(const char* text) : str_(intern(text)) {}
+
+    const std::string& str() const { return *str_; }
+    operator const std::string&() const { return *str_; }
+    bool empty() const { return str_->empty(); }
+
+    bool operator==(const InternedName& other) const { return str_ == other.str_; }
+    std::size_t hash() const { return std::hash<const void*>{}(str_); }
+    friend std::ostream& operator<<(std::ostream& os, const InternedName& name) { return os << *name.str_; }
+
+private:
+    static const std::string* intern(std::string_view text) {
+        static std::mutex mu;
+        static std::set<std::string, std::less<>> pool; // 節點位址固定
+        std::lock_guard<std::mutex> lock(mu);
+        auto it = pool.find(text);
+        if (it == pool.end()) it = pool.emplace(text).first;
+        return &*it;
+    }
+
+    const std::string* str_;
+};
 
 struct FaultID {
-    std::string faultName_; // Name of the fault (e.g., "StuckAt", "Transition", etc.)
+    InternedName faultName_; // Name of the fault (e.g., "StuckAt", "Transition", etc.)
     int subcaseIdx_;        // Index of the subcase for this fault
 
     bool operator==(const FaultID& other) const {
@@ -24,24 +64,30 @@ namespace std {
     template <>
     struct hash<FaultID> {
         std::size_t operator()(const FaultID& fid) const {
-            std::size_t h1 = std::hash<std::string>{}(fid.faultName_);
+            std::size_t h1 = fid.faultName_.hash();
             std::size_t h2 = std::hash<int>{}(fid.subcaseIdx_);
             return h1 ^ (h2 << 1);
         }
     };
 }
 
+// 觸發序列：絕大多數不超過 4 個操作，直接放在 FaultConfig 內
+using TriggerOps = InlineVector<SingleOp, 4>;
+
+// Represents configuration for a fault from input.
 class FaultConfig {
 public:
     // Constructor to initialize with basic parameters
     FaultConfig()
         : VI_(-1), faultValue_(-1), finalReadValue_(-1),
-          is_twoCell_(false), twoCellFaultType_(TwoCellFaultType::Sa), AI_(-1) {}
+          is_twoCell_(false), is_A_less_than_V_(false), twoCellFaultType_(TwoCellFaultType::Sa), AI_(-1),
+          cellNumber_(1), triggerCell_(-1), decoderKind_(DecoderFaultKind::None),
+          lineScope_(LineScope::None), timeKind_(TimeFaultKind::None), retentionTime_(0) {}
 
     // Basic information about the fault
     FaultID id_; // Unique identifier for the fault
     int VI_;            // Initial victim value
-    std::vector<SingleOp> trigger_;  // Trigger sequence for the fault on the aggressor or victim cell
+    TriggerOps trigger_;  // Trigger sequence for the fault on the aggressor or victim cell
     int faultValue_;      // The value to inject for the fault
     int finalReadValue_; // Expected value after the fault is injected (if applicable)
 
@@ -51,8 +97,43 @@ public:
     TwoCellFaultType twoCellFaultType_; // Type of fault (e.g., "Sa", "Sv", etc.)
     int AI_;            // Initial aggressor value (if applicable)
 
-    DetectionReport init0_healthReport_; // Report on the health of the fault
-    DetectionReport init1_healthReport_; // Report on the health of the fault
+    // Additional parameters for N-cell faults (cell_number 3 / 5 / 9)
+    int cellNumber_;               // Number of cells involved (1, 2, 3, 5 or 9)
+    std::vector<int> cellStates_;  // Required state of each cell in neighbourhood order (-1 = don't care)
+    int triggerCell_;              // Neighbourhood index of the cell the trigger sequence acts on
+
+    bool isNCell() const { return cellNumber_ > 2; }
+
+    // Address decoder fault ("kind": "decoder"); faultValue_ is the floating read value
+    // for NoAccess and selects wired-AND (0) / wired-OR (1) for MultiCell
+    DecoderFaultKind decoderKind_;
+
+    bool isDecoder() const { return decoderKind_ != DecoderFaultKind::None; }
+
+    // Row / column line fault ("kind": "row" / "column"); uses the 1-cell fields on one
+    // cell of the line, and the payload writes faultValue_ to the whole line
+    LineScope lineScope_;
+
+    bool isLine() const { return lineScope_ != LineScope::None; }
+
+    // Time-dependent fault ("kind": "retention" / "leakage"); a cell holding VI_ for
+    // retentionTime_ without being restored decays to faultValue_
+    TimeFaultKind timeKind_;
+    SimTime retentionTime_;
+
+    bool isTimed() const { return timeKind_ != TimeFaultKind::None; }
+
+    // Whether the trigger sequence uses the `op^N` repetition syntax
+    bool hasRepeatedOps() const {
+        for (const auto& op : trigger_) if (op.repeat_ > 1) return true;
+        return false;
+    }
+
+    // Initial value of the cell the trigger sequence starts on
+    int triggerInitialValue() const {
+        if (isNCell()) return cellStates_[triggerCell_];
+        return (is_twoCell_ && twoCellFaultType_ == TwoCellFaultType::Sa) ? AI_ : VI_;
+    }
 };
 
 
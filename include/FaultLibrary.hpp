@@ -0,0 +1,39 @@
+#ifndef FAULT_LIBRARY_H
+#define FAULT_LIBRARY_H
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "FaultConfig.hpp"
+
+// ────────────────────────────────────────────────
+// 不可變的 fault library
+//   建立後內容不再改變，複製只增加參考計數：同一份 library 可以同時給多個 thread、
+//   多個 March test 或多個模擬器使用。模擬結果不寫回 FaultConfig，而是放在以
+//   fault 索引存取的 ResultStore (見 ResultStore.hpp)。
+//   fault 名稱為 InternedName，觸發序列為 inline 陣列，每個 FaultConfig 沒有額外的 heap 配置
+//   (N-cell fault 的 cellStates_ 與超過 4 個操作的觸發序列除外)。
+// ────────────────────────────────────────────────
+class FaultLibrary {
+public:
+    FaultLibrary();
+    explicit FaultLibrary(std::vector<FaultConfig> faults);
+
+    std::size_t size() const { return faults_->size(); }
+    bool empty() const { return faults_->empty(); }
+    const FaultConfig& operator[](std::size_t fault) const { return (*faults_)[fault]; }
+    std::vector<FaultConfig>::const_iterator begin() const { return faults_->begin(); }
+    std::vector<FaultConfig>::const_iterator end() const { return faults_->end(); }
+    // 供只接受 vector 的模擬器 / writer 使用
+    const std::vector<FaultConfig>& faults() const { return *faults_; }
+
+    // FaultID → 索引；不存在時回傳 -1 (同一 FaultID 出現多次時取第一個)
+    long find(const FaultID& id) const;
+
+private:
+    std::shared_ptr<const std::vector<FaultConfig>> faults_;
+    std::shared_ptr<const std::unordered_map<FaultID, std::size_t>> index_;
+};
+
+#endif // FAULT_LIBRARY_H
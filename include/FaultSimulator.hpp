@@ -1,11 +1,22 @@
+#ifndef FAULT_SIMULATOR_H
+#define FAULT_SIMULATOR_H
+
 #include "AddressAllocator.hpp"
+#include "AnalyticalEngine.hpp"
+#include "Checkpoint.hpp"
+#include "CounterRng.hpp"
+#include "DataBackground.hpp"
 #include "DetectionReport.hpp"
 #include "Fault.hpp"
 #include "FaultConfig.hpp"
 #include "March.hpp"
 #include "MemoryState.hpp"
 #include "ResultCollector.hpp"
+#include "ResultStore.hpp"
+#include "SensitizationFilter.hpp"
 #include "SequenceExecutor.hpp"
+#include "SymmetryReducer.hpp"
+#include <functional>
 #include <unordered_map>
 
 class IFaultSimulator {
@@ -16,28 +27,289 @@ public:
     virtual double getDetectedRate() = 0;
 };
 
+// 解析式引擎的使用方式
+enum class AnalyticalMode {
+    Off,        // 一律逐一模擬
+    FastPath,   // 支援的 fault 直接採用解析式結果，其餘退回模擬
+    CrossCheck  // 兩者都跑並比對，結果仍以模擬為準
+};
+
+// 每個 (fault, init) 的完整 DetectionReport (含 detectedVicAddrs_)；ResultStore 只保存 syndrome，
+// 需要其他欄位時以 setReportObserver 取得。fault 為在 fault library 中的索引
+using ReportObserver = std::function<void(std::size_t fault, int init, const DetectionReport& report)>;
+// 每完成一個 (fault, init) 呼叫一次 (結果已寫入 ResultStore)；next 為下一個要計算的位置
+using ProgressCallback = std::function<void(const RunCursor& next)>;
+
 class OneByOneFaultSimulator final: public IFaultSimulator {
 public:
-    OneByOneFaultSimulator(std::vector<FaultConfig>& faultConfigs,
+    // fault library 只讀取；結果寫入 results 中對應的列 (results 的 fault 數須與 library 相同)
+    OneByOneFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
               const std::vector<MarchElement>& marchTest,
-              int rows, int cols, int seed);
+              int rows, int cols, int seed, ResultStore& results);
+    // 共用已編譯的 program (常駐的 server 對同一個 March test 只編譯一次)；program 須為 rows x cols
+    OneByOneFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+              const std::vector<MarchElement>& marchTest,
+              std::shared_ptr<const MarchProgram> program,
+              int rows, int cols, int seed, ResultStore& results);
     ~OneByOneFaultSimulator() = default;
+    // 從 cursor() 繼續跑完；已跑完時再從頭跑一次 (位址接續抽取)，
+    // 但 resumeAt() 之後的第一次 run() 只跑剩下的部分 (檢查點已完成時什麼都不做)
     void run() override {
-        run_0();
-        run_1();
+        if (cursor_.finished() && !resumed_) restart();
+        resumed_ = false;
+        while (!cursor_.finished()) runInit(cursor_.init);
     }
-    void run_0();
-    void run_1();
+    void run_0() { runInit(0); }
+    void run_1() { runInit(1); }
     double getDetectedRate() override {
         return static_cast<double>(detectedCount_) / (cfg_.size() * 2);
     }
+    // 下一個要計算的 (init, fault)
+    const RunCursor& cursor() const { return cursor_; }
+    // 位址抽取的亂數狀態；與 cursor() 一起保存即可在之後接續同樣的 placement
+    std::string allocatorState() const { return addrAllocator_->state(); }
+    // 從檢查點接續：cursor 之前的結果須已在 ResultStore 中，偵測數由其中重新計算。
+    // 對稱性化簡的快取從空的開始，換算 / 計算的次數會不同，但結果相同
+    void resumeAt(const RunCursor& cursor, const std::string& allocatorState);
+    void setProgressCallback(ProgressCallback callback) { progress_ = std::move(callback); }
+    // 只計算 [first, last) 的 fault (本機 shard)；須在 run() / resumeAt() 之前設定。
+    // 範圍外的 fault 只抽取位址不模擬，因此範圍內每個 fault 的 placement 與不分 shard 時相同
+    void setFaultRange(std::size_t first, std::size_t last);
+    void setAnalyticalMode(AnalyticalMode mode) { analyticalMode_ = mode; }
+    // CrossCheck 模式下，解析式結果與模擬結果不一致的次數
+    int crossCheckMismatches() const { return crossCheckMismatches_; }
+    // 開啟對稱性化簡：同一 orbit 只計算一個代表，其餘換算得到
+    void setSymmetryReduction(bool enable) {
+        symmetry_ = enable ? std::make_unique<SymmetryReducer>(marchTest_, rows_ * cols_) : nullptr;
+    }
+    const SymmetryReducer* symmetry() const { return symmetry_.get(); }
+    // 記憶體實作 (預設依大小自動選擇 Dense / Paged)
+    void setMemoryKind(MemoryKind kind) { memoryKind_ = kind; }
+    // ⇕ element 兩個方向都評估，報告最差的結果 (見 SequenceExecutor::setBothDirections)；
+    // March test 有 ⇕ element 時不使用解析式引擎與對稱性化簡
+    void setBothDirections(bool enable) { bothDirections_ = enable; }
+    void setReportObserver(ReportObserver observer) { observer_ = std::move(observer); }
 protected:
-    std::vector<FaultConfig>& cfg_; // Fault configurations
+    // 計算 initValue 下 cursor_ 所指的 fault 到最後一個 (cursor_.init 不是 initValue 時從頭開始)
+    void runInit(int initValue);
+    // 範圍內第一個位置 (init 0)；重新開始時使用
+    void restart();
+    // 抽掉 target 之前尚未抽取的 placement (範圍外的 fault)，讓亂數狀態對應到 target
+    void skipTo(const RunCursor& target);
+    // 一個 fault 在 initValue 下的結果 (過濾、對稱性換算、解析式或模擬)；
+    // 回傳的參考在下一次 evaluate() 前有效
+    const DetectionReport& evaluate(const FaultConfig& faultConfig, int initValue);
+    // 實際跑一次 March test，回傳 collector_ 的報告
+    // N-cell fault 以 cells (鄰域順序的位址) 配置，其餘 fault 忽略 cells
+    const DetectionReport& simulate(const FaultConfig& faultConfig, int aggressorAddr, int victimAddr,
+                                    const std::vector<int>& cells);
+
+    const std::vector<FaultConfig>& cfg_; // Fault configurations
     const std::vector<MarchElement>& marchTest_; // March test sequence
     int rows_;
     int cols_;
+    std::shared_ptr<const MarchProgram> program_; // 編譯後的 March test，所有 fault 共用
+    ResultStore& results_;
+    ReportObserver observer_;
+    ProgressCallback progress_;
+    RunCursor cursor_;  // 下一個要計算的 (init, fault)
+    RunCursor placed_;  // 下一個要抽取 placement 的 (init, fault)，不會超前 cursor_
+    std::size_t first_{0};
+    std::size_t last_;
+    bool resumed_{false};
     int detectedCount_{0}; // Count of detections
     std::shared_ptr<MemoryState> mem_;// Memory state
-    std::unique_ptr<IResultCollector> collector_; // Result collector
+    // 逐一模擬的工作物件都重複使用：fault / trigger 由 pool 重新 bind，collector 重設時不釋放節點，
+    // cells_ 沿用容量，結果直接由 collector 寫入 ResultStore；暖機後每個 fault 不再配置記憶體
+    OneByOneResultCollector collector_;
+    DetectionReport derived_; // 對稱性換算的結果
+    FaultPool pool_;
+    std::vector<int> cells_; // N-cell fault 的整個鄰域
     std::unique_ptr<AddressAllocator> addrAllocator_; // Address allocator
-};
\ No newline at end of file
+    SensitizationFilter filter_; // 靜態敏化分析，略過永遠不會觸發的 fault
+    AnalyticalEngine analytical_; // 解析式偵測引擎
+    AnalyticalResult analyticalResult_; // 解析式引擎的結果 (重複使用)
+    AnalyticalMode analyticalMode_{AnalyticalMode::Off};
+    int crossCheckMismatches_{0};
+    std::unique_ptr<SymmetryReducer> symmetry_; // nullptr 表示不化簡
+    MemoryKind memoryKind_{MemoryKind::Auto};
+    bool bothDirections_{false};
+};
+
+// 單一 fault 的逐一模擬 (init 0 與 init 1)，供串流 pipeline 的每個 worker 各自持有。
+// 與 OneByOneFaultSimulator 不同的是位址不依 fault 順序抽取：第 seq 個 fault 的擺放
+// 只取決於 (seed, seq)，因此結果與 worker 數、完成順序無關。
+class SingleFaultSimulator {
+public:
+    SingleFaultSimulator(const std::vector<MarchElement>& marchTest, int rows, int cols,
+                         uint64_t seed, MemoryKind kind = MemoryKind::Auto);
+    // 共用已編譯的 program (多個 worker 只編譯一次)；program 的記憶體大小須為 rows x cols
+    SingleFaultSimulator(const std::vector<MarchElement>& marchTest,
+                         std::shared_ptr<const MarchProgram> program, int rows, int cols,
+                         uint64_t seed, MemoryKind kind = MemoryKind::Auto);
+    // 模擬 cfg 的 init 0 / init 1，結果由 report() 取得 (下一次 run() 前有效)
+    void run(const FaultConfig& cfg, uint64_t seq);
+    const DetectionReport& report(int init) const { return reports_[init & 1]; }
+    void setBothDirections(bool enable) { bothDirections_ = enable; }
+private:
+    int rows_;
+    int cols_;
+    CounterRng rng_;
+    std::shared_ptr<const MarchProgram> program_;
+    std::shared_ptr<MemoryState> mem_[2]; // [init]
+    AddressAllocator allocator_;
+    OneByOneResultCollector collector_;
+    FaultPool pool_;
+    std::vector<int> cells_;
+    SensitizationFilter filter_;
+    bool bothDirections_{false};
+    DetectionReport reports_[2]; // [init]
+};
+
+// 空間平行模擬：把一批互不相鄰的 fault 放進同一塊大記憶體，
+// 整批只跑一次 March test，再依位址把 read 結果歸給各自的 fault。
+// 每個 fault 只會看到自己 cell 上的操作 (與 OneByOne 不同的是，
+// TwoCellFault 觸發後不會影響其他位址)；記憶體放滿時自動分成多批。
+class SpatialFaultSimulator final: public IFaultSimulator {
+public:
+    SpatialFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+              const std::vector<MarchElement>& marchTest,
+              int rows, int cols, ResultStore& results);
+    void run() override {
+        runInit(0);
+        runInit(1);
+    }
+    double getDetectedRate() override {
+        return static_cast<double>(detectedCount_) / (cfg_.size() * 2);
+    }
+    // 最近一次 run() 共跑了幾次 March pass
+    int batchCount() const { return batchCount_; }
+    void setMemoryKind(MemoryKind kind) { memoryKind_ = kind; }
+    void setReportObserver(ReportObserver observer) { observer_ = std::move(observer); }
+private:
+    void runInit(int initValue);
+    void flushBatch(int initValue, std::vector<std::size_t>& batch);
+    void store(std::size_t fault, int initValue, const DetectionReport& report);
+
+    const std::vector<FaultConfig>& cfg_;
+    const std::vector<MarchElement>& marchTest_;
+    int rows_;
+    int cols_;
+    MarchProgram program_;
+    ResultStore& results_;
+    ReportObserver observer_;
+    int detectedCount_{0};
+    int batchCount_{0};
+    std::shared_ptr<MemoryState> mem_;
+    MemoryKind memoryKind_{MemoryKind::Auto};
+    std::unique_ptr<FaultOverlay> overlay_;
+    SpatialPlacementPlanner planner_;
+    SensitizationFilter filter_;
+};
+
+// Linked fault 模擬：從 fault library 列舉共用同一個 victim 的 fault 組合
+// (order = 2 為 pair，3 為 triple)，以 LinkedFault 組合後整體模擬。
+// 不可能互相影響的組合事先剔除 (見 mayInteract)，其餘以多執行緒平行評估。
+// 所有 fault 的 victim 都放在記憶體中央，aggressor 放在相鄰的 cell。
+class LinkedFaultSimulator final: public IFaultSimulator {
+public:
+    LinkedFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+              const std::vector<MarchElement>& marchTest,
+              int rows, int cols, int order = 2, int threads = 0);
+    void run() override;
+    // 被偵測到的 (組合, 初值) 比例
+    double getDetectedRate() override;
+
+    const std::vector<LinkedDetectionReport>& reports() const { return reports_; }
+    long long candidateCount() const { return candidates_; } // 剔除前的組合數
+    long long prunedCount() const { return candidates_ - static_cast<long long>(reports_.size()); }
+    int order() const { return order_; }
+
+    // 共用 victim 時 a、b 是否可能互相遮蔽：
+    // fault value 相反，且其中一個的 fault value 恰為另一個的 victim 初值 (互補敏化)
+    static bool mayInteract(const FaultConfig& a, const FaultConfig& b);
+
+private:
+    void enumerate();
+    // 在 mem 上評估一個組合 (兩種初值)
+    void evaluate(LinkedDetectionReport& report, OneByOneResultCollector& collector) const;
+    // 依序為組合中的 fault 安排位址：victim 共用中央 cell，aggressor 取不同的鄰居
+    std::vector<std::pair<int,int>> placements(const std::vector<int>& members) const;
+    bool detectedWith(const std::vector<int>& members, const std::vector<std::pair<int,int>>& slots,
+                      std::size_t only, int initValue, OneByOneResultCollector& collector) const;
+
+    const std::vector<FaultConfig>& cfg_;
+    const std::vector<MarchElement>& marchTest_;
+    int rows_;
+    int cols_;
+    int order_;
+    int threads_;
+    long long candidates_{0};
+    MarchProgram program_;
+    SensitizationFilter filter_;
+    std::vector<LinkedDetectionReport> reports_;
+};
+
+// Word-oriented 模擬：記憶體為 rows x cols 個 width-bit word，
+// 每個 fault 放在中央的 word，一次 March pass 以 bit-parallel 方式同時涵蓋
+// victim 位於每個 bit 的情形；每個 data background × 兩種初值各跑一次。
+class WordFaultSimulator final: public IFaultSimulator {
+public:
+    WordFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+              const std::vector<MarchElement>& marchTest,
+              int rows, int cols, int width,
+              std::vector<DataBackground> backgrounds);
+    void run() override;
+    // 被偵測到的 (fault, bit 位置, 初值) 比例
+    double getDetectedRate() override;
+    const std::vector<WordDetectionReport>& reports() const { return reports_; }
+    const std::vector<DataBackground>& backgrounds() const { return backgrounds_; }
+    int width() const { return mem_->width(); }
+private:
+    const std::vector<FaultConfig>& cfg_;
+    const std::vector<MarchElement>& marchTest_;
+    std::vector<DataBackground> backgrounds_;
+    std::shared_ptr<WordMemoryState> mem_;
+    std::vector<WordDetectionReport> reports_;
+};
+
+// Monte-Carlo 覆蓋率估計：每個 sample 重新隨機擺放 fault、隨機產生 power-up 內容
+// (每個 cell 隨機 0 / 1)，可選擇機率性觸發，跑一次 March test 記錄是否偵測。
+// 每個 fault 各自取樣，直到偵測機率的信賴區間夠窄或達到樣本上限。
+// 亂數來自 CounterRng：fault i 的 sample s 只取決於 (seed, i, s)，
+// 因此結果與 thread 數、排程順序無關。
+class MonteCarloSimulator final: public IFaultSimulator {
+public:
+    MonteCarloSimulator(const std::vector<FaultConfig>& faultConfigs,
+              const std::vector<MarchElement>& marchTest,
+              int rows, int cols, MonteCarloOptions options = {});
+    void run() override;
+    // 各 fault 偵測機率估計值的平均
+    double getDetectedRate() override;
+    const std::vector<MonteCarloReport>& reports() const { return reports_; }
+    const MonteCarloOptions& options() const { return opt_; }
+    void setMemoryKind(MemoryKind kind) { memoryKind_ = kind; }
+
+    // 雙尾信賴水準 → 常態分位數 (0.95 → 1.96)
+    static double zScore(double confidence);
+    // Wilson score interval：k / n 次偵測時的 {lo, hi}
+    static std::pair<double,double> wilson(long long k, long long n, double z);
+
+private:
+    struct Worker;
+    void estimate(std::size_t i, Worker& worker);
+    bool sample(std::size_t i, uint64_t s, Worker& worker) const;
+
+    const std::vector<FaultConfig>& cfg_;
+    const std::vector<MarchElement>& marchTest_;
+    int rows_;
+    int cols_;
+    MarchProgram program_;
+    MonteCarloOptions opt_;
+    CounterRng rng_;
+    double z_;
+    MemoryKind memoryKind_{MemoryKind::Auto};
+    std::vector<MonteCarloReport> reports_;
+};
+
+#endif // FAULT_SIMULATOR_H
@@ -0,0 +1,89 @@
+#ifndef INLINE_VECTOR_H
+#define INLINE_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+// 前 N 個元素放在物件內部的小型 vector：大部分觸發序列只有 1 ~ 3 個操作，
+// 不需為每個 FaultConfig 另外配置 heap；超過 N 個時整份改放在 heap_。
+// 只支援 default-constructible 的 T (SingleOp 之類的小型值型別)。
+template <typename T, std::size_t N>
+class InlineVector {
+public:
+    InlineVector() = default;
+    InlineVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+    InlineVector(const std::vector<T>& items) { assign(items.begin(), items.end()); }
+    template <typename It>
+    InlineVector(It first, It last) { assign(first, last); }
+
+    InlineVector(const InlineVector&) = default;
+    InlineVector& operator=(const InlineVector&) = default;
+    InlineVector(InlineVector&& other) noexcept
+        : inline_(other.inline_), heap_(std::move(other.heap_)), size_(other.size_) {
+        other.size_ = 0;
+    }
+    InlineVector& operator=(InlineVector&& other) noexcept {
+        inline_ = other.inline_;
+        heap_ = std::move(other.heap_);
+        size_ = other.size_;
+        other.size_ = 0;
+        return *this;
+    }
+    InlineVector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    template <typename It>
+    void assign(It first, It last) {
+        clear();
+        for (; first != last; ++first) push_back(*first);
+    }
+
+    void push_back(const T& item) {
+        if (size_ < N) {
+            inline_[size_] = item;
+        } else {
+            if (size_ == N) heap_.assign(inline_.begin(), inline_.end()); // 第一次溢出：搬到 heap
+            heap_.push_back(item);
+        }
+        ++size_;
+    }
+    void clear() {
+        heap_.clear();
+        size_ = 0;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    // 元素是否仍放在物件內部
+    bool isInline() const { return size_ <= N; }
+
+    T* data() { return isInline() ? inline_.data() : heap_.data(); }
+    const T* data() const { return isInline() ? inline_.data() : heap_.data(); }
+    T* begin() { return data(); }
+    T* end() { return data() + size_; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size_; }
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[size_ - 1]; }
+    const T& back() const { return data()[size_ - 1]; }
+
+    bool operator==(const InlineVector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+
+private:
+    std::array<T, N> inline_ {};
+    std::vector<T> heap_;   // size_ > N 時存放全部元素
+    uint32_t size_ {0};
+};
+
+#endif // INLINE_VECTOR_H
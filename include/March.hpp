@@ -2,13 +2,15 @@
 #define MARCH_H
 
 #include <vector>
+#include "AddressOrder.hpp"
 
 // Represents a single memory operation (part of a March sequence).
-enum class OpType { R, W, CI, CO, UNKNOWN };
+// DEL is a pause (`del100` = 100 ms) that does not access memory.
+enum class OpType { R, W, CI, CO, DEL, UNKNOWN };
 
 struct MarchIdx {
-    MarchIdx() : marchIdx(-1), opIdx(-1), overallIdx(-1) {}
-    MarchIdx( int marchIdx, int opIdx, int overallIdx)
+    constexpr MarchIdx() : marchIdx(-1), opIdx(-1), overallIdx(-1) {}
+    constexpr MarchIdx( int marchIdx, int opIdx, int overallIdx)
         : marchIdx(marchIdx), opIdx(opIdx), overallIdx(overallIdx) {}
 
     int marchIdx; // The order of the March element in the sequence
@@ -27,10 +29,11 @@ struct MarchIdx {
 class SingleOp {
 public:
     // Constructor
-    SingleOp() : type_(OpType::R), value_(-1) {}
-    SingleOp(OpType type, int value) : type_(type), value_(value) {}
+    constexpr SingleOp() : type_(OpType::R), value_(-1), repeat_(1) {}
+    constexpr SingleOp(OpType type, int value, int repeat = 1) : type_(type), value_(value), repeat_(repeat) {}
     OpType type_;
     int value_; // For WRITE operations; ignored for READ
+    int repeat_; // Consecutive repetitions on the same cell (`r0^1000`); 1 for a plain op
     bool operator ==(const SingleOp& other) {
         return type_ == other.type_ && value_ == other.value_;
     }
@@ -52,6 +55,7 @@ public:
     // Constructor
     MarchElement() : addrOrder_(Direction::BOTH), elemIdx_(-1) {}
     Direction addrOrder_; // Address order for this March element (ASC, DESC, BOTH)
+    AddressOrder order_;  // 位址序列 (a[gray](...))；DESC 為同一序列倒著走
     std::vector<PositionedOp> ops_; // Sequence of operations in this March element
     int elemIdx_; // Order in the March sequence
 };
@@ -0,0 +1,199 @@
+#ifndef MARCH_LIBRARY_H
+#define MARCH_LIBRARY_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include "March.hpp"
+
+// ────────────────────────────────────────────────
+// 編譯期的 March test
+//   StaticMarch::parse 在 constexpr 中解析 "b(w0);a(r0,w1);..." 記法 (與 Parser 相同的
+//   direction / 操作碼 / op^N 規則，一個 token 可含多個操作，共用同一個 opIdx)；
+//   常數求值時格式錯誤會直接成為編譯錯誤。
+//   容量固定 (kMaxElements / kMaxOps)，所有內建 test 因此是同一個型別，可以放進同一張表。
+// ────────────────────────────────────────────────
+struct StaticOp {
+    OpType type {OpType::UNKNOWN};
+    int value {-1};
+    int repeat {1};
+    int opIdx {0};     // element 內的 token 編號 (MarchIdx::opIdx)
+};
+
+struct StaticElement {
+    Direction dir {Direction::BOTH};
+    int begin {0};     // [begin, end) 為 ops 中的索引，也就是 overallIdx
+    int end {0};
+};
+
+struct StaticMarch {
+    static constexpr int kMaxElements = 16;
+    static constexpr int kMaxOps = 128;
+
+    int elementCount {0};
+    int opCount {0};
+    StaticElement elems[kMaxElements] {};
+    StaticOp ops[kMaxOps] {};
+
+    static constexpr StaticMarch parse(std::string_view pattern) {
+        StaticMarch m;
+        std::size_t pos = 0;
+        while (pos < pattern.size()) {
+            std::size_t semi = pattern.find(';', pos);
+            if (semi == std::string_view::npos) semi = pattern.size();
+            m.addElement(strip(pattern.substr(pos, semi - pos)));
+            pos = semi + 1;
+        }
+        return m;
+    }
+
+private:
+    static constexpr bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    static constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static constexpr bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+    static constexpr char lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    static constexpr std::string_view strip(std::string_view s) {
+        while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+        while (!s.empty() && isSpace(s.back())) s.remove_suffix(1);
+        return s;
+    }
+
+    static constexpr bool equalsNoCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            if (lower(a[i]) != b[i]) return false;
+        return true;
+    }
+
+    constexpr void addElement(std::string_view seg) {
+        if (seg.empty()) return;
+        if (elementCount == kMaxElements) throw std::length_error("StaticMarch: element 數超過上限");
+        Direction dir = Direction::BOTH;
+        switch (lower(seg[0])) {
+            case 'a': dir = Direction::ASC;  break;
+            case 'd': dir = Direction::DESC; break;
+            case 'b': dir = Direction::BOTH; break;
+            default:  throw std::invalid_argument("StaticMarch: 未知 direction");
+        }
+        const std::size_t l = seg.find('(');
+        const std::size_t r = seg.find(')', l);
+        if (l == std::string_view::npos || r == std::string_view::npos || r <= l + 1)
+            throw std::invalid_argument("StaticMarch: pattern 格式錯誤");
+
+        StaticElement& elem = elems[elementCount++];
+        elem.dir = dir;
+        elem.begin = opCount;
+        const std::string_view list = seg.substr(l + 1, r - l - 1);
+        int opIdx = 0;
+        std::size_t pos = 0;
+        while (pos <= list.size()) {
+            std::size_t comma = list.find(',', pos);
+            if (comma == std::string_view::npos) comma = list.size();
+            const std::string_view tok = strip(list.substr(pos, comma - pos));
+            if (!tok.empty()) addToken(tok, opIdx++);
+            pos = comma + 1;
+        }
+        elem.end = opCount;
+    }
+
+    // 一個 token 可以是 "r0"、"w1^500"、"co"、"del100" 或多個操作相連 ("r0w1")
+    constexpr void addToken(std::string_view tok, int opIdx) {
+        std::size_t i = 0;
+        while (i < tok.size()) {
+            const std::size_t nameBegin = i;
+            while (i < tok.size() && isAlpha(tok[i])) ++i;
+            const std::string_view name = tok.substr(nameBegin, i - nameBegin);
+            int value = -1;
+            if (i < tok.size() && isDigit(tok[i])) {
+                value = 0;
+                while (i < tok.size() && isDigit(tok[i])) value = value * 10 + (tok[i++] - '0');
+            }
+            int repeat = 1;
+            if (i < tok.size() && tok[i] == '^') {
+                ++i;
+                if (i == tok.size() || !isDigit(tok[i])) throw std::invalid_argument("StaticMarch: ^ 後缺少次數");
+                repeat = 0;
+                while (i < tok.size() && isDigit(tok[i])) repeat = repeat * 10 + (tok[i++] - '0');
+                if (repeat < 1) throw std::invalid_argument("StaticMarch: 重複次數必須至少為 1");
+            }
+
+            OpType type = OpType::UNKNOWN;
+            if      (equalsNoCase(name, "r"))   type = OpType::R;
+            else if (equalsNoCase(name, "w"))   type = OpType::W;
+            else if (equalsNoCase(name, "ci"))  type = OpType::CI;
+            else if (equalsNoCase(name, "co"))  type = OpType::CO;
+            else if (equalsNoCase(name, "del")) type = OpType::DEL;
+            if (type == OpType::UNKNOWN) throw std::invalid_argument("StaticMarch: 不支援的操作碼");
+            if (value < 0 && type != OpType::CO) throw std::invalid_argument("StaticMarch: 操作缺少數值");
+            if (opCount == kMaxOps) throw std::length_error("StaticMarch: 操作數超過上限");
+            ops[opCount++] = { type, value, repeat, opIdx };
+        }
+    }
+};
+
+// ────────────────────────────────────────────────
+// 內建 March test 庫 (與 input/All_MarchTest.json 相同)
+//   每一筆在編譯期就解析好；SequenceExecutor 為每一筆實例化一個完全展開的 kernel，
+//   MarchProgram 編譯時若 March test 與某一筆完全相同就改走該 kernel。
+//   從 JSON 讀入的其他 March test 仍使用一般的直譯路徑。
+// ────────────────────────────────────────────────
+struct BuiltinMarch {
+    std::string_view name;
+    std::string_view pattern;
+    StaticMarch march;
+
+    constexpr BuiltinMarch(std::string_view n, std::string_view p)
+        : name(n), pattern(p), march(StaticMarch::parse(p)) {}
+};
+
+class MarchLibrary {
+public:
+    static constexpr BuiltinMarch kTests[] = {
+        { "MATS++",          "b(w0);a(r0,w1);d(r1,w0,r0)" },
+        { "March X",         "b(w0);a(r0,w1);d(r1,w0);b(r0)" },
+        { "March Y",         "b(w0);a(r0,w1,r1);d(r1,w0,r0);b(r0)" },
+        { "March C-",        "b(w0);a(r0,w1);a(r1,w0);d(r0,w1);d(r1,w0);b(r0)" },
+        { "March C- modify", "b(w0);a(r0,w1);a(r1,w0,r0);d(r0,w1);d(r1,w0);b(r0)" },
+        { "March MD2",       "b(w0);a(r0,w1,w1,r1,w1,w1,r1,w0,w0,r0,w0,w0,r0,w0,w1,w0,w1);"
+                             "a(r1,w0,w0,r0,w0,w0,r0,w1,w1,r1,w1,w1,r1,w1,w0,w1,w0);"
+                             "d(r0,w1,r1,w1,r1,r1,r1,w0,r0,w0,r0,r0,r0,w0,w1,w0,w1);"
+                             "d(r1,w0,r0,w0,r0,r0,r0,w1,r1,w1,r1,r1,r1,w1,w0,w1,w0);b(r0)" },
+        { "March MD9A",      "b(w0);a(r0,w1,r1,w1,r1,r1);a(r1,w0,r0,w0,r0,r0);d(r0,w1,r1,w1,r1,r1);"
+                             "d(r1,w0,r0,w0,r0,r0);b(r0)" },
+        { "March WY1",       "b(w0);a(r0,w0,w1,w0,w1,r1,w1,w0,w1,w0,r0,w1,w1,w1);"
+                             "a(r1,w1,w0,w1,w0,r0,w0,w1,w0,w1,r1,w0,w0,w0);"
+                             "d(r0,w1,r1,w1,r1,r1,r1,w0,r0,w0,r0,r0,r0,w1,w1,w1);"
+                             "d(r1,w0,r0,w0,r0,r0,r0,w1,r1,w1,r1,r1,r1,w0,w0,w0,w0);b(r0)" },
+        { "March-DC",        "b(w0);a(r0,w1,ci0,r1);a(r1,w0,ci0,r0);d(r0,w1);d(r1,w0);b(r0)" },
+        { "March-CM24",      "b(w0);a(r0,ci0,r0,co,w1,ci0,r1,co);a(r1,ci1,r1,co,w0,ci1,r0,co);"
+                             "d(r0,ci0,r0,co,w1,ci0,r1,co);d(r1,ci1,r1,co,w0,ci1,r0,co);b(r0)" },
+        { "March SS",        "b(w0);a(r0,r0,w0,r0,w1);a(r1,r1,w1,r1,w0);d(r0,r0,w0,r0,w1);"
+                             "d(r1,r1,w1,r1,w0);b(r0)" },
+        { "March DSS",       "a(w0);a(r0,r0,w0,r0,w1);a(r1,w1,r1,w0);d(r0,w0,r0,w1);d(r1,w1,r1,w0,w0,r0);"
+                             "d(r0,w0,r0);d(r0,w1,r1);d(r1,w1);a(r1,w0,r0);a(r0,w1,r1);a(r1,w0);d(r0,w0);"
+                             "a(r0,w1);d(r1,w1,r1);d(r1,w0);d(r0)" },
+        { "March-LSD",       "b(w0);a(r0,w1,r1,w1,w1,r1,w1,w0,r0,w1,w1,r1,w0,w1,r1,w1,r1,r1);"
+                             "a(r1,w1,w1,r1,w1,w0,r0,w1,w1,r1,w0,w1,r1,w1,r1,r1,r1,w0);a(r0);"
+                             "d(r0,w0,w0,r0,w0,w1,r1,w0,w0,r0,w1,w0,r0,w0,r0,r0,r0,w1);"
+                             "d(r1,w0,r0,w0,w0,r0,w0,w1,r1,w0,w0,r0,w1,w0,r0,w0,r0,r0);d(r0)" },
+    };
+    static constexpr int kCount = static_cast<int>(std::size(kTests));
+
+    // 依名稱找內建 test；找不到回傳 -1
+    static constexpr int find(std::string_view name) {
+        for (int i = 0; i < kCount; ++i)
+            if (kTests[i].name == name) return i;
+        return -1;
+    }
+
+    // 與 marchTest 完全相同 (方向、操作、MarchIdx) 的內建 test；沒有則回傳 -1
+    static int match(const std::vector<MarchElement>& marchTest);
+
+    // 展開成 Parser::parseMarchTest 的輸出形式
+    static std::vector<MarchElement> toElements(const StaticMarch& march);
+};
+
+#endif // MARCH_LIBRARY_H
@@ -0,0 +1,94 @@
+#ifndef MARCH_PROGRAM_H
+#define MARCH_PROGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "March.hpp"
+#include "SimClock.hpp"
+
+// ────────────────────────────────────────────────
+// 編譯後的 March test (structure-of-arrays)
+//   把 vector<MarchElement> 攤平成連續的陣列：每個操作一格 kind / value / repeat /
+//   syndrome bit，每個 element 一段 [opBegin, opEnd) 與事先決定好的位址順序 (起點、步長；
+//   非 linear 的 AddressOrder 另外展開成位址陣列，同一個順序的 element 共用一份)。
+//   SequenceExecutor::execute(const MarchProgram&, ...) 以一個迴圈直譯，
+//   不必再逐一走訪 PositionedOp、也不必每次判斷 Direction 或「是否只有 Del」。
+//   編譯結果只與 March test 及記憶體幾何有關，建好之後不再修改，
+//   可由所有 fault、所有 thread 共用。
+// ────────────────────────────────────────────────
+class MarchProgram {
+public:
+    // executor 需要區分的操作種類；Idle 為 CI / CO，不存取記憶體但佔用 cycle
+    enum Kind : uint8_t { Read, Write, Delay, Idle };
+
+    MarchProgram() = default;
+    MarchProgram(const std::vector<MarchElement>& marchTest, int rows, int cols);
+    // 只知道大小時視為 1 x memorySize (col 順序此時與 linear 相同)
+    MarchProgram(const std::vector<MarchElement>& marchTest, int memorySize)
+        : MarchProgram(marchTest, 1, memorySize) {}
+
+    int memorySize() const { return memorySize_; }
+    int elementCount() const { return static_cast<int>(elemPause_.size()); }
+    int opCount() const { return static_cast<int>(kind_.size()); }
+    // read 操作數 = syndrome 長度
+    int readCount() const { return static_cast<int>(readOp_.size()); }
+
+    // ── element e ──
+    int opBegin(int e) const { return elemOpBegin_[e]; }
+    int opEnd(int e) const { return elemOpBegin_[e + 1]; }
+    // 只有 Del 的 element：整個陣列一起暫停一次，不走訪位址
+    bool pause(int e) const { return elemPause_[e] != 0; }
+    // 走訪位置依序為 firstPos, firstPos + posStep, ... 共 memorySize() 個；
+    // addresses(e) 為 nullptr (linear) 時位置就是位址，否則位址為 addresses(e)[位置]
+    int firstPos(int e) const { return elemFirst_[e]; }
+    int posStep(int e) const { return elemStep_[e]; }
+    const int* addresses(int e) const { return elemSeq_[e] < 0 ? nullptr : sequences_[elemSeq_[e]].data(); }
+    // ⇕ element：預設與 ⇑ 相同 (firstPos / posStep 為遞增)，
+    // SequenceExecutor::setBothDirections 時另外以反方向評估
+    bool both(int e) const { return elemBoth_[e] != 0; }
+    bool hasBoth() const { return std::find(elemBoth_.begin(), elemBoth_.end(), 1) != elemBoth_.end(); }
+
+    // ── op i ──
+    Kind kind(int i) const { return static_cast<Kind>(kind_[i]); }
+    // Write 寫入的值；Read 期望讀到的值
+    int value(int i) const { return value_[i]; }
+    int repeat(int i) const { return repeat_[i]; }
+    // Delay 暫停的時間 (ns)
+    SimTime delay(int i) const { return delay_[i]; }
+    // Read 在 syndrome 中的位置 (依 overallIdx 排序)，其他操作為 -1
+    int bit(int i) const { return bit_[i]; }
+    // 傳給 IFault / IResultCollector 的原始形式
+    const SingleOp& op(int i) const { return op_[i]; }
+    const MarchIdx& index(int i) const { return idx_[i]; }
+
+    // syndrome 第 b 個 bit 對應的 read
+    const MarchIdx& readIndex(int b) const { return idx_[readOp_[b]]; }
+
+    // 與 MarchLibrary::kTests 中相同的那一筆 (SequenceExecutor 改走展開的 kernel)；-1 表示一般路徑
+    int builtin() const { return builtin_; }
+
+private:
+    int memorySize_ {0};
+    int builtin_ {-1};
+    // per op (熱資料)
+    std::vector<uint8_t> kind_;
+    std::vector<int> value_;
+    std::vector<int> repeat_;
+    std::vector<int> bit_;
+    std::vector<SimTime> delay_;
+    // per op (只在呼叫 fault / collector 時取用)
+    std::vector<SingleOp> op_;
+    std::vector<MarchIdx> idx_;
+    std::vector<int> readOp_;   // syndrome bit → op
+    // per element；elemOpBegin_ 多一格結尾
+    std::vector<int> elemOpBegin_ {0};
+    std::vector<int> elemFirst_;
+    std::vector<int> elemStep_;
+    std::vector<uint8_t> elemPause_;
+    std::vector<uint8_t> elemBoth_;
+    std::vector<int> elemSeq_;                 // sequences_ 的索引；-1 為 linear
+    std::vector<std::vector<int>> sequences_;  // 每個用到的非 linear 順序一份
+};
+
+#endif // MARCH_PROGRAM_H
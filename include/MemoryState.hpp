@@ -1,8 +1,31 @@
 #ifndef MEMORY_STATE_H
 #define MEMORY_STATE_H
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <vector>
+#include "DataBackground.hpp"
+
+// Dense: one int per cell, allocated up front.
+// Paged: only written pages are stored (for very large arrays).
+// Auto:  Paged once the array reaches kPagedThreshold cells.
+enum class MemoryKind { Auto, Dense, Paged };
+constexpr long long kPagedThreshold = 1LL << 20;
+
+// One word line (row) or bit line (column) of a rows x cols array:
+// addresses first, first + stride, ..., count cells in total.
+struct LineRange {
+    int first {0};
+    int count {0};
+    int stride {1};
+
+    bool contains(int address) const {
+        const int offset = address - first;
+        return offset >= 0 && offset % stride == 0 && offset / stride < count;
+    }
+};
 
 // Base class representing memory with read/write operations.
 class MemoryState {
@@ -18,11 +41,30 @@ public:
     virtual int read(int address) const = 0;
 
     virtual void reset() = 0;
+
+    // Write the same value to every cell of a row / column (line fault payload).
+    virtual void fillLine(const LineRange& line, int value) {
+        for (int i = 0, addr = line.first; i < line.count; ++i, addr += line.stride) write(addr, value);
+    }
+
+    // Snapshot of the current contents. Writes to either copy do not affect the other.
+    virtual std::shared_ptr<MemoryState> clone() const = 0;
+
+    // Overwrite the contents with those of other, which has the same size (e.g. an earlier clone()).
+    virtual void restore(const MemoryState& other) = 0;
+
+    // Whether every cell holds the same value as in other (same size).
+    virtual bool sameContents(const MemoryState& other) const = 0;
+
+    // Pick an implementation for a rows x cols array (see MemoryKind).
+    static std::shared_ptr<MemoryState> create(int rows, int cols, int defaultValue,
+                                               MemoryKind kind = MemoryKind::Auto);
     
 protected:
     int defaultValue_;
 };
 
+
 // Dense memory implementation using a contiguous vector.
 // Uninitialized cells are set to default value.
 class DenseMemoryState final: public MemoryState {
@@ -42,8 +84,112 @@ public:
         std::fill(data_.begin(), data_.end(), defaultValue_);
     }
 
+    // A row is one contiguous std::fill; a column is a strided loop without per-cell bounds checks.
+    void fillLine(const LineRange& line, int value) override;
+
+    std::shared_ptr<MemoryState> clone() const override {
+        return std::make_shared<DenseMemoryState>(*this);
+    }
+
+    // Reuses the existing buffer when other is also dense
+    void restore(const MemoryState& other) override;
+    bool sameContents(const MemoryState& other) const override;
+
 private:
     std::vector<int> data_;
 };
 
+// Sparse memory: the array is split into pages of 2^kPageBits cells.
+// A page that was never written is implicit and reads as the default value.
+// Pages are shared between clones and copied on first write (copy-on-write).
+// reset() only drops the pages touched since the last reset; they are kept and refilled
+// on the next write, so a reset / simulate loop stops allocating once warm.
+class PagedMemoryState final: public MemoryState {
+public:
+    static constexpr int kPageBits = 12;
+    static constexpr int kPageSize = 1 << kPageBits;
+
+    PagedMemoryState(int row, int col, int defaultValue);
+
+    void write(int address, int value) override {
+        if (address < 0 || address >= size_) return;
+        writablePage(address >> kPageBits)[address & (kPageSize - 1)] = value;
+    }
+
+    int read(int address) const override {
+        if (address < 0 || address >= size_) return defaultValue_;
+        const auto& page = pages_[address >> kPageBits];
+        return page ? (*page)[address & (kPageSize - 1)] : defaultValue_;
+    }
+
+    // O(touched pages)
+    void reset() override;
+
+    // Rows are filled page by page
+    void fillLine(const LineRange& line, int value) override;
+
+    // O(page table): the pages themselves are shared until written.
+    // Spare pages stay with this copy; sharing them would let both copies refill the same page.
+    std::shared_ptr<MemoryState> clone() const override {
+        auto copy = std::make_shared<PagedMemoryState>(*this);
+        copy->spare_.clear();
+        return copy;
+    }
+
+    // From another paged memory: O(page table), pages are shared copy-on-write
+    void restore(const MemoryState& other) override;
+    // Pages shared with other are skipped without reading them
+    bool sameContents(const MemoryState& other) const override;
+
+    // Number of materialized pages (for tests / statistics)
+    int residentPages() const { return static_cast<int>(touched_.size()); }
+
+private:
+    using Page = std::vector<int>;
+    std::vector<int>& writablePage(int pageIdx);
+
+    int size_;
+    std::vector<std::shared_ptr<Page>> pages_; // nullptr = implicit default page
+    std::vector<int> touched_;                 // indices of non-null entries in pages_
+    std::vector<std::shared_ptr<Page>> spare_; // pages dropped by reset(), reused by the next writes
+};
+
+// Word-oriented memory: rows x cols words, each `width` bits wide (1..64).
+// Words are stored as uint64_t so a whole word is read / written at once.
+class WordMemoryState {
+public:
+    WordMemoryState(int rows, int cols, int width);
+
+    int size() const { return static_cast<int>(data_.size()); }
+    int width() const { return width_; }
+    uint64_t mask() const { return mask_; }
+
+    // Write a word; bits above `width` are dropped. Out-of-range writes are ignored.
+    void write(int address, uint64_t word) {
+        if (address < 0 || address >= static_cast<int>(data_.size())) return;
+        data_[address] = word & mask_;
+    }
+
+    // Read a word; out-of-range reads return 0.
+    uint64_t read(int address) const {
+        if (address < 0 || address >= static_cast<int>(data_.size())) return 0;
+        return data_[address];
+    }
+
+    // Background value at `address`, or its inverse when `invert` is true.
+    uint64_t pattern(int address, bool invert) const {
+        return invert ? (~backgrounds_[address] & mask_) : backgrounds_[address];
+    }
+
+    // Select the data background and fill every word with it (or its inverse).
+    void fill(DataBackground bg, bool invert);
+
+private:
+    int cols_;
+    int width_;
+    uint64_t mask_;
+    std::vector<uint64_t> data_;
+    std::vector<uint64_t> backgrounds_; // 目前 background 在每個位址的值
+};
+
 #endif // MEMORY_STATE_H
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// ────────────────────────────────────────────────
+// N-cell fault 的鄰域定義 (victim 固定在正中央，索引依 row-major 排列)
+//   3 : 同一列連續三個 cell   [W, V, E]
+//   5 : von Neumann (十字)    [N, W, V, E, S]
+//   9 : Moore (3x3)           [NW, N, NE, W, V, E, SW, S, SE]
+// ────────────────────────────────────────────────
+struct NeighborhoodLayout {
+    static bool valid(int cellNumber) {
+        return cellNumber == 3 || cellNumber == 5 || cellNumber == 9;
+    }
+
+    // victim 在鄰域中的索引
+    static int victimIndex(int cellNumber) { return cellNumber / 2; }
+
+    // 相對 victim 的位移 (dr, dc) → 鄰域索引；不在鄰域內回傳 -1
+    static int slotOf(int cellNumber, int dr, int dc) {
+        if (std::abs(dr) > 1 || std::abs(dc) > 1) return -1;
+        static constexpr int kSlot3[3][3] = { {-1, -1, -1}, { 0, 1, 2}, {-1, -1, -1} };
+        static constexpr int kSlot5[3][3] = { {-1,  0, -1}, { 1, 2, 3}, {-1,  4, -1} };
+        static constexpr int kSlot9[3][3] = { { 0,  1,  2}, { 3, 4, 5}, { 6,  7,  8} };
+        switch (cellNumber) {
+            case 3:  return kSlot3[dr + 1][dc + 1];
+            case 5:  return kSlot5[dr + 1][dc + 1];
+            case 9:  return kSlot9[dr + 1][dc + 1];
+            default: return -1;
+        }
+    }
+
+    // 鄰域索引 → 相對 victim 的位移 (dr, dc)
+    static std::pair<int,int> offsetOf(int cellNumber, int slot) {
+        for (int dr = -1; dr <= 1; ++dr)
+            for (int dc = -1; dc <= 1; ++dc)
+                if (slotOf(cellNumber, dr, dc) == slot) return { dr, dc };
+        throw std::out_of_range("NeighborhoodLayout: 鄰域索引超出範圍");
+    }
+};
+
+// 預先算好某個 rows x cols 幾何上所有完整鄰域的位址表。
+// 第 i 筆的 cells(i)[k] 為鄰域索引 k 的位址；只收錄整個鄰域都在記憶體內的 victim，
+// 配置 fault 時只需挑一筆，不必再逐一檢查邊界。
+class NeighborhoodTable {
+public:
+    NeighborhoodTable(int rows, int cols, int cellNumber) : n_(cellNumber) {
+        if (!NeighborhoodLayout::valid(cellNumber))
+            throw std::invalid_argument("NeighborhoodTable: 只支援 3 / 5 / 9 cell 的鄰域");
+        const bool vertical = cellNumber != 3; // 3-cell 只往左右延伸
+        for (int r = vertical ? 1 : 0; r < rows - (vertical ? 1 : 0); ++r) {
+            for (int c = 1; c < cols - 1; ++c) {
+                for (int k = 0; k < n_; ++k) {
+                    auto [dr, dc] = NeighborhoodLayout::offsetOf(cellNumber, k);
+                    table_.push_back((r + dr) * cols + (c + dc));
+                }
+            }
+        }
+    }
+
+    int cellNumber() const { return n_; }
+    std::size_t size() const { return table_.size() / n_; }
+    const int* cells(std::size_t i) const { return table_.data() + i * n_; }
+    int victimOf(std::size_t i) const { return cells(i)[NeighborhoodLayout::victimIndex(n_)]; }
+
+private:
+    int n_;
+    std::vector<int> table_;
+};
+
+#endif // NEIGHBORHOOD_H
@@ -3,10 +3,15 @@
 
 #include <iostream>
 #include <fstream>
+#include <functional>
 #include <vector>
 #include <string>
 #include <sstream>
+#include "BufferedWriter.hpp"
+#include "DataBackground.hpp"
+#include "DetectionReport.hpp"
 #include "FaultConfig.hpp"
+#include "ResultStore.hpp"
 #include "nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -17,23 +22,79 @@ class Parser {
 public:
     // Parse fault configurations from a JSON file.
     std::vector<FaultConfig> parseFaults(const std::string& filename) const;
+    // Stream fault configurations one by one without holding the whole library in memory.
+    void streamFaults(const std::string& filename, const std::function<void(FaultConfig&&)>& emit) const;
 
     // Parse a test pattern (sequence of SingleOp) from a JSON file 
     std::vector<MarchElement> parseMarchTest_menu(const std::string& filename); // With menu selection
-    std::vector<MarchElement> parseMarchTest(const std::string& filename); 
+    // filename 為 "builtin:<name>" 時取用 MarchLibrary 的內建 test
+    std::vector<MarchElement> parseMarchTest(const std::string& filename);
+    // March test 庫 (根節點為 array，例如 All_MarchTest.json) 中各 test 的名稱，依檔案順序
+    std::vector<std::string> marchTestNames(const std::string& filename) const;
+    // 從 March test 庫中取出名為 name 的 test
+    std::vector<MarchElement> parseMarchTest(const std::string& filename, const std::string& name);
+    // 直接解析 pattern 字串 (例如 "b(w0); a(r0,w1)")，不讀檔
+    std::vector<MarchElement> parseMarchPattern(const std::string& pattern);
+    // 沒有以 a[name](...) 指定位址順序的 element 所使用的順序 (預設 linear)
+    void setDefaultAddressOrder(const AddressOrder& order) { defaultOrder_ = order; }
     
 
     // Write detection results (syndrome, coverage) to an output file.
-    void writeDetectionReport(const std::vector<FaultConfig>& faults, 
+    // results holds the simulation results of faults (same fault index).
+    void writeDetectionReport(const std::vector<FaultConfig>& faults,
+                              const ResultStore& results,
                               double detectedRate,
                               const std::string& filename) const;
+
+    // Structured outputs: one row per (fault, init) with syndrome, hex and detecting MarchIdx list.
+    // CSV for spreadsheets / pandas, columnar binary (.fscol) for large libraries.
+    void writeCsvReport(const std::vector<FaultConfig>& faults,
+                        const ResultStore& results,
+                        const std::string& filename) const;
+    void writeColumnarReport(const std::vector<FaultConfig>& faults,
+                             const ResultStore& results,
+                             const std::string& filename) const;
+    // Row-level writers used by writeCsvReport and the streaming pipeline (two rows per fault).
+    // reads = readOps(marchTest) decides the syndrome bit order (same as ResultStore::reads()).
+    static std::vector<MarchIdx> readOps(const std::vector<MarchElement>& marchTest);
+    void writeCsvHeader(BufferedWriter& out) const;
+    void writeCsvRows(BufferedWriter& out, const FaultConfig& fault, const Syndrome& init0,
+                      const Syndrome& init1, const std::vector<MarchIdx>& reads) const;
+    void writeJsonRows(BufferedWriter& out, const FaultConfig& fault, const Syndrome& init0,
+                       const Syndrome& init1, const std::vector<MarchIdx>& reads) const;
+
+    // Write word-oriented results: detected bit positions per init / data background.
+    void writeWordDetectionReport(const std::vector<FaultConfig>& faults,
+                                  const std::vector<WordDetectionReport>& reports,
+                                  const std::vector<DataBackground>& backgrounds,
+                                  int width,
+                                  double detectedRate,
+                                  const std::string& filename) const;
+
+    // Write linked-fault results: undetected / masked combinations.
+    void writeLinkedDetectionReport(const std::vector<FaultConfig>& faults,
+                                    const std::vector<LinkedDetectionReport>& reports,
+                                    int order, long long candidates,
+                                    double detectedRate,
+                                    const std::string& filename) const;
+
+    // Write Monte-Carlo results: per-fault detection probability with confidence interval.
+    void writeMonteCarloReport(const std::vector<FaultConfig>& faults,
+                               const std::vector<MonteCarloReport>& reports,
+                               const MonteCarloOptions& options,
+                               double detectedRate,
+                               const std::string& filename) const;
 private:
     std::string marchTestName_;
+    AddressOrder defaultOrder_;
     // 共用小工具（與 JSON 庫無關）
     int                toInt(const std::string& raw) const;                 // "-" → -1
     SingleOp           toSingleOp(char opKind, char value) const;           // R0 / W1 …
     std::vector<SingleOp> explodeOpToken(const std::string& token) const;   // R0W1 → {R0,W1}
+    std::vector<MarchElement> parsePattern(const std::string& pattern) const;
     std::string        processSFR(const FaultConfig& fault) const;
+    void               parseFaultEntry(const json& jfault,
+                                       const std::function<void(FaultConfig&&)>& emit) const;
 };
 
 #endif // PARSER_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "FaultConfig.hpp"
+#include "March.hpp"
+#include "MemoryState.hpp"
+
+enum class StreamFormat { Csv, NdJson };
+
+struct PipelineOptions {
+    int rows {4};
+    int cols {4};
+    uint64_t seed {12345};
+    int workers {0};                 // 0 = hardware concurrency
+    std::size_t queueDepth {64};     // 每個佇列的容量
+    StreamFormat format {StreamFormat::Csv};
+    MemoryKind memoryKind {MemoryKind::Auto};
+    bool bothDirections {false};     // ⇕ element 兩個方向都評估 (最差結果)
+};
+
+struct PipelineStats {
+    long long faults {0};
+    long long detected {0};          // 被偵測的 (fault, init) 數
+    std::size_t peakInFlight {0};    // 同時存在的 FaultConfig 最大數量
+    double detectedRate() const { return faults ? static_cast<double>(detected) / (faults * 2) : 0.0; }
+};
+
+// ────────────────────────────────────────────────
+// 串流模擬 pipeline：parse → simulate → report
+//   loader   ：Parser::streamFaults 逐一讀出 FaultConfig，放入輸入佇列
+//   workers  ：各自持有一個 SingleFaultSimulator，結果放入輸出佇列
+//   writer   ：依讀入順序寫出 CSV / NDJSON 列，輸出佇列暫時沒有資料時 flush
+//   同時存在的 fault 數以 window (= 2 x queueDepth + workers) 為上限：loader 取得名額才能讀下一個，
+//   writer 依序寫出後才歸還名額，因此記憶體與 fault library 大小無關，
+//   提早完成的 fault 在 writer 端等待的數量也不會超過 window。
+// ────────────────────────────────────────────────
+class SimulationPipeline {
+public:
+    SimulationPipeline(const std::vector<MarchElement>& marchTest, PipelineOptions options);
+
+    PipelineStats run(const std::string& faultFile, const std::string& outFile);
+
+    std::size_t window() const { return window_; }
+
+private:
+    const std::vector<MarchElement>& marchTest_;
+    PipelineOptions opt_;
+    std::size_t window_;
+};
+
+#endif // PIPELINE_H
@@ -1,8 +1,13 @@
 #ifndef RESULT_COLLECTOR_H
 #define RESULT_COLLECTOR_H
 
+#include <cstdint>
+#include <set>
+#include <vector>
 #include "DetectionReport.hpp"
 
+class FaultOverlay;
+
 // Collects fault detection results during simulation.
 class IResultCollector {
 public:
@@ -12,14 +17,51 @@ public:
     virtual ~IResultCollector() = default;
 };
 
+// 逐一模擬時每個 fault 都會 reset 一次，因此 reset 不釋放任何節點：
+// detected_ 的 key 固定是 March test 的所有 read (每個 fault 都相同)，只把值清成 false；
+// detectedVicAddrs_ 的節點以 extract 收回，下次 insert 時重複使用。
+// 穩定後 opRecord / reset 都不配置記憶體。
 class OneByOneResultCollector : public IResultCollector {
 public:
     void opRecord(const MarchIdx& idx, int addr, bool isDetected) override;
     DetectionReport getReport() const override { return report_; }
-    void reset() override { report_ = DetectionReport(); } // Reset the report
+    void reset() override;
+    // 不複製的版本；複製到既有的 DetectionReport 時，std::map / std::set 會沿用其節點
+    const DetectionReport& report() const { return report_; }
 private:
-    // Map of fault IDs to their detection reports
     DetectionReport report_;
+    std::vector<std::set<int>::node_type> spareAddrs_; // 收回的 detectedVicAddrs_ 節點
+};
+
+// 多個 fault 共用一次 March pass 時使用：
+// 依 FaultOverlay 的位址表把每個 read 結果歸給該位址所屬的 fault。
+class SpatialResultCollector : public IResultCollector {
+public:
+    explicit SpatialResultCollector(const FaultOverlay& overlay) : overlay_(overlay) {}
+    void opRecord(const MarchIdx& idx, int addr, bool isDetected) override;
+    // 所有 fault 的合併結果
+    DetectionReport getReport() const override;
+    void reset() override;
+
+    // 第 faultId 個 fault 的偵測結果 (faultId 為 FaultOverlay::add 的回傳值)
+    const DetectionReport& reportOf(int faultId) const { return reports_[faultId]; }
+    // 不屬於任何 fault 的位址上發生的讀取錯誤次數 (March test 本身不一致時才會 > 0)
+    int unattributedMismatches() const { return unattributed_; }
+private:
+    const FaultOverlay& overlay_;
+    std::vector<DetectionReport> reports_;
+    int unattributed_ {0};
+};
+
+// Word-oriented 模擬使用：每次 read 回報的是讀錯的 universe (lane mask)，
+// 累積起來即為此 pass 中被偵測到的 bit 位置。
+class WordResultCollector {
+public:
+    void opRecord(const MarchIdx& /*idx*/, int /*addr*/, uint64_t lanes) { detectedLanes_ |= lanes; }
+    uint64_t detectedLanes() const { return detectedLanes_; }
+    void reset() { detectedLanes_ = 0; }
+private:
+    uint64_t detectedLanes_ {0};
 };
 
 #endif // RESULT_COLLECTOR_H
\ No newline at end of file
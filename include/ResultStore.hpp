@@ -0,0 +1,123 @@
+#ifndef RESULT_STORE_H
+#define RESULT_STORE_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DetectionReport.hpp"
+#include "March.hpp"
+
+// 一次 March test 的 syndrome：第 i 個 bit 代表第 i 個 read 操作 (依 overallIdx 排序) 是否失敗。
+// 字串形式與 detection report 的 "Init 0: 0101" 相同 (第一個字元為第一個 read)。
+class Syndrome {
+public:
+    Syndrome() : Syndrome(0) {}
+    explicit Syndrome(int bits) : bits_(bits), words_((bits + 63) / 64, 0) {}
+    Syndrome(int bits, const uint64_t* words) : bits_(bits), words_(words, words + (bits + 63) / 64) {}
+
+    int size() const { return bits_; }
+    void set(int i) { words_[i >> 6] |= uint64_t{1} << (i & 63); }
+    bool test(int i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+    bool any() const {
+        for (uint64_t w : words_) if (w) return true;
+        return false;
+    }
+    const std::vector<uint64_t>& words() const { return words_; }
+
+    // 不同長度的 syndrome 不可比較，呼叫端須確保長度一致
+    int distance(const Syndrome& other) const {
+        int d = 0;
+        for (std::size_t k = 0; k < words_.size(); ++k) d += std::popcount(words_[k] ^ other.words_[k]);
+        return d;
+    }
+
+    std::string toString() const;
+    static Syndrome fromString(const std::string& bits);
+
+    bool operator==(const Syndrome& other) const { return bits_ == other.bits_ && words_ == other.words_; }
+
+private:
+    int bits_;
+    std::vector<uint64_t> words_;
+};
+
+struct SyndromeHash {
+    std::size_t operator()(const Syndrome& s) const {
+        uint64_t h = 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(s.size());
+        for (uint64_t w : s.words()) {
+            h ^= w + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        }
+        return static_cast<std::size_t>(h);
+    }
+};
+
+// ────────────────────────────────────────────────
+// 模擬結果表 (與 fault library 分開保存)
+//   以 fault 在 library 中的索引存取，每個 (fault, init) 一列，只保存 syndrome：
+//   (read 數 + 63) / 64 個 word，偵測與否即 syndrome 是否有 1。
+//   DetectionReport 的 map / set (含 detectedVicAddrs_) 不保存；需要時可用 report() 還原。
+//   - 各列互不重疊，不同 thread 同時寫入不同 fault 是安全的。
+//   - 指定 spill 檔時資料放在 mmap 的檔案中 (百萬 fault 等級時不佔用 heap)，格式：
+//       "FSRES001", uint64 faults, uint32 reads, uint32 stride, uint64 rows[faults * 2][stride]
+// ────────────────────────────────────────────────
+class ResultStore {
+public:
+    ResultStore() = default;
+    // faults 個 fault 的結果；syndrome 的 bit 順序取自 marchTest 的 read 操作。
+    // spillFile 非空時建立 (或覆寫) 該檔案並以 mmap 存放，無法建立時丟出 runtime_error
+    ResultStore(std::size_t faults, const std::vector<MarchElement>& marchTest,
+                const std::string& spillFile = "");
+    // 重新 mmap 既有的 spill 檔 (保留內容，供 --resume 續跑)；
+    // 檔頭的 fault 數 / read 數與本次不符時丟出 runtime_error
+    static ResultStore reopen(const std::string& spillFile, std::size_t faults,
+                              const std::vector<MarchElement>& marchTest);
+    ~ResultStore();
+    ResultStore(ResultStore&& other) noexcept;
+    ResultStore& operator=(ResultStore&& other) noexcept;
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    std::size_t faultCount() const { return faults_; }
+    int readCount() const { return static_cast<int>(reads_.size()); }
+    const std::vector<MarchIdx>& reads() const { return reads_; }
+    // 每列的 word 數
+    std::size_t stride() const { return stride_; }
+    bool spilled() const { return map_ != nullptr; }
+    // 把 spill 檔中修改過的 page 寫回磁碟 (msync)；沒有 spill 檔時不做任何事
+    void flush();
+
+    // 以 report.detected_ 中失敗的 read 覆寫該列
+    void set(std::size_t fault, int init, const DetectionReport& report);
+    void set(std::size_t fault, int init, const Syndrome& syndrome);
+
+    bool detected(std::size_t fault, int init) const;
+    const uint64_t* words(std::size_t fault, int init) const { return row(fault, init); }
+    Syndrome syndrome(std::size_t fault, int init) const { return Syndrome(readCount(), row(fault, init)); }
+    // 還原成 DetectionReport：detected_ 列出所有 read，detectedVicAddrs_ 為空
+    DetectionReport report(std::size_t fault, int init) const;
+    // 被偵測到的 (fault, init) 數
+    long long detectedCount() const;
+    // 複製 other 中 [first, last) 的 fault 的兩列 (合併 shard 結果)；read 順序須相同
+    void copyRows(const ResultStore& other, std::size_t first, std::size_t last);
+
+    // DetectionReport → syndrome (bit 順序為 reads，即 Parser::readOps)
+    static Syndrome toSyndrome(const DetectionReport& report, const std::vector<MarchIdx>& reads);
+
+private:
+    uint64_t* row(std::size_t fault, int init) { return data_ + (fault * 2 + (init & 1)) * stride_; }
+    const uint64_t* row(std::size_t fault, int init) const { return data_ + (fault * 2 + (init & 1)) * stride_; }
+    void mapSpill(const std::string& spillFile, bool create);
+    void release();
+
+    std::vector<MarchIdx> reads_;
+    std::size_t faults_ {0};
+    std::size_t stride_ {0};
+    std::vector<uint64_t> heap_;   // 沒有 spill 檔時的資料
+    uint64_t* data_ {nullptr};
+    void* map_ {nullptr};          // spill 檔的 mmap 區域 (含檔頭)
+    std::size_t mapBytes_ {0};
+};
+
+#endif // RESULT_STORE_H
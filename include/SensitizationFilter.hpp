@@ -0,0 +1,42 @@
+#ifndef SENSITIZATION_FILTER_H
+#define SENSITIZATION_FILTER_H
+
+#include <vector>
+#include "Fault.hpp"
+#include "FaultConfig.hpp"
+#include "March.hpp"
+
+// ────────────────────────────────────────────────
+// 靜態敏化分析 (Static sensitization pre-filter)
+//   March test 中每個 element 對所有 cell 執行相同的操作序列，
+//   因此可事先列舉「任一 cell 在 fault-free 下會看到的 (before value, op) 序列」。
+//   若 fault 的觸發序列從未以連續視窗出現在同一個 element 內，
+//   該 fault 在模擬中永遠不會被觸發，可直接判定為未偵測。
+// ────────────────────────────────────────────────
+class SensitizationFilter {
+public:
+    explicit SensitizationFilter(const std::vector<MarchElement>& marchTest);
+
+    // background = initValue 時，cfg 的觸發序列是否可能在某個 cell 上出現。
+    // 保守判斷：回傳 true 不代表一定觸發；回傳 false 則保證不會觸發。
+    bool canTrigger(const FaultConfig& cfg, int initValue) const;
+
+    // 只看第 elemIdx 個 element 的視窗比對 (不考慮 read 是否一致)
+    bool canTriggerInElement(const FaultConfig& cfg, int initValue, std::size_t elemIdx) const;
+
+    // fault-free 記憶體在此 background 下，所有 read 是否都與期望值一致。
+    // 不一致時 (例如 March 一開始就讀取)，未觸發的 fault 仍可能被「偵測」，不可略過。
+    bool isConsistent(int initValue) const { return consistent_[initValue & 1]; }
+
+private:
+    // pattern 為 cfg 觸發序列的 run-length 表示 (toOperationRuns)
+    bool matchesElement(const FaultConfig& cfg, int initValue, std::size_t elemIdx,
+                        const std::vector<OperationRun>& pattern) const;
+
+    // streams_[init][elem]：單一 cell 在該 element 中依序收到的 (before value, op)，
+    // 以 run-length 表示 (op^N 不必展開)
+    std::vector<std::vector<OperationRun>> streams_[2];
+    bool consistent_[2] {true, true};
+};
+
+#endif // SENSITIZATION_FILTER_H
@@ -3,26 +3,85 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 #include "March.hpp"
+#include "MarchProgram.hpp"
 #include "MemoryState.hpp"
 #include "Fault.hpp"
 #include "ResultCollector.hpp"
+#include "SimClock.hpp"
 
 // Executes a sequence of memory operations (March pattern),
 // coordinating fault injection and detection.
+// Each R / W / CI / CO advances the simulated clock by one cycle, Del by its duration.
+// A March element made only of Del ops is one pause of the whole array, not one per address.
 class SequenceExecutor {
 public:
-    SequenceExecutor(int memorySize, IResultCollector& collector)
-        : memSize_(memorySize), collector_(collector) {}
+    SequenceExecutor(int memorySize, IResultCollector& collector, SimTime cycleTime = kDefaultCycleTime)
+        : memSize_(memorySize), collector_(collector), clock_(cycleTime) {}
 
     // Execute a sequence of single operations with a set of faults.
     // faults: list of fault objects to inject/check during simulation.
+    // Compiles marchTest on every call; simulators that run many faults compile once
+    // and use the MarchProgram overload.
     void execute(const std::vector<MarchElement>& marchTest, IFault& fault);
 
+    // Run a compiled March test; program.memorySize() must equal memorySize.
+    // Built-in tests (program.builtin() >= 0) run their unrolled kernel instead.
+    void execute(const MarchProgram& program, IFault& fault);
+
+    // Simulated time at the end of the last execute()
+    SimTime elapsed() const { return clock_.now(); }
+
+    // 每個 ⇕ element 都以 ⇑ 與 ⇓ 兩個方向評估，collector 收到最差的那條路徑。
+    // 在 ⇕ element 開頭分岔 (記憶體、fault 狀態、偵測結果各一份)，而不是把 2^k 種組合各跑一次；
+    // 每個 element 結束後，記憶體與 fault 狀態相同的分支之後的行為也相同；其中一個讀錯過的 read
+    // 是另一個的子集 (次數也不多) 時只保留它，否則兩個都保留到最後。
+    // 此時 collector 先收到每個 read 一次未偵測，再收到最差路徑上的每次偵測。
+    void setBothDirections(bool enable) { bothDirections_ = enable; }
+    // 最近一次 execute() 合併後同時存在的最大分支數 (沒有分岔、或兩個方向結果相同時為 1)
+    int peakBranches() const { return peakBranches_; }
+
 private:
-    void processElementAtAddr(const MarchElement& elem, IFault& fault, int mem_idx);
+    // 把時鐘往前推，並觸發期間到期的 fault 事件 (只有 timed fault 才查詢)
+    void advance(IFault& fault, SimTime dt) {
+        clock_.advance(dt);
+        if (timed_ && fault.nextEvent() <= clock_.now()) fault.onEvent(clock_.now());
+    }
+    // 內建 March test 的 kernel：MarchLibrary::kTests[I] 的每個操作在編譯期展開，
+    // 位址迴圈內沒有分派，也不讀取 MarchProgram 的陣列
+    using Kernel = void (SequenceExecutor::*)(IFault&);
+    template <std::size_t... I> static constexpr auto kernels(std::index_sequence<I...>);
+    template <int I> void runBuiltin(IFault& fault);
+    template <int I, int E> void runElement(IFault& fault);
+    template <int I, int E, int K> void runOp(IFault& fault, int addr);
+
+    // 一般路徑的一個 element (reset fault 後暫停或走訪位址)；reversed 時反方向走訪
+    void runElement(const MarchProgram& program, int e, IFault& fault, IResultCollector& collector,
+                    bool reversed);
+    void executeForked(const MarchProgram& program, IFault& fault);
+
     int memSize_; // Size of the memory to simulate
     IResultCollector& collector_;
+    SimClock clock_;
+    bool timed_ {false};
+    bool bothDirections_ {false};
+    int peakBranches_ {1};
+};
+
+// Word-oriented counterpart: w0 / r0 write / expect the data background
+// of each address, w1 / r1 its inverse. Reads report a lane mask (see WordLaneFault).
+class WordSequenceExecutor {
+public:
+    WordSequenceExecutor(WordMemoryState& mem, WordResultCollector& collector)
+        : mem_(mem), collector_(collector) {}
+
+    void execute(const std::vector<MarchElement>& marchTest, WordLaneFault& fault);
+
+private:
+    void processElementAtAddr(const MarchElement& elem, WordLaneFault& fault, int addr);
+    WordMemoryState& mem_;
+    WordResultCollector& collector_;
 };
 
 #endif // SEQUENCE_EXECUTOR_H
\ No newline at end of file
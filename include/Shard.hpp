@@ -0,0 +1,36 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "March.hpp"
+#include "ResultStore.hpp"
+
+// ────────────────────────────────────────────────
+// 本機 shard：把一個逐一模擬的工作依 fault 索引切成 count 段，
+// 第 index 段 (0 起算) 由獨立的 process 計算，結果寫入自己的結果檔
+// (ResultStore 的 spill 格式，另有 .ckpt 記錄參數與進度，見 Checkpoint.hpp)。
+// 每個 shard 先抽掉範圍外 fault 的 placement 再模擬自己的範圍，
+// 因此合併後與不分 shard 的結果完全相同。
+// ────────────────────────────────────────────────
+struct ShardSpec {
+    std::size_t index {0};
+    std::size_t count {1};
+
+    // "K/N"，0 <= K < N
+    static ShardSpec parse(const std::string& text);
+    std::string toString() const { return std::to_string(index) + "/" + std::to_string(count); }
+    // 這個 shard 的 fault 範圍 [first, last)；各段大小最多差 1
+    std::pair<std::size_t, std::size_t> range(std::size_t faults) const;
+    // shard 檢查點中的工作摘要：整個工作的參數再加上 shard 編號
+    std::string tag(const std::string& job) const { return job + " | shard " + toString(); }
+};
+
+// 把 files (依任意順序列出的 N 個 shard 結果檔) 合併到 merged。
+// 每個檔案的 .ckpt 須為 job 的第 0 .. N-1 段各一次且已跑完，否則丟出 runtime_error
+void mergeShards(const std::vector<std::string>& files, const std::string& job,
+                 const std::vector<MarchElement>& marchTest, ResultStore& merged);
+
+#endif // SHARD_H
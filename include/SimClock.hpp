@@ -0,0 +1,61 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// 模擬時間，單位 ns
+using SimTime = long long;
+constexpr SimTime kNever = std::numeric_limits<SimTime>::max();
+constexpr SimTime kDefaultCycleTime = 10;          // 每個 R / W / CI / CO 操作佔用的時間 (ns)
+constexpr SimTime kNsPerMs = 1000LL * 1000LL;      // Del<N> 的 N 以 ms 計
+
+// "50ms" / "100us" / "2s" / "500ns"；沒有單位時視為 ms
+inline SimTime parseSimTime(const std::string& text) {
+    std::size_t pos = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) ++pos;
+    if (pos == 0) throw std::invalid_argument("無法解析時間：" + text);
+    const SimTime n = std::stoll(text.substr(0, pos));
+    const std::string unit = text.substr(pos);
+    if (unit.empty() || unit == "ms") return n * kNsPerMs;
+    if (unit == "ns") return n;
+    if (unit == "us") return n * 1000;
+    if (unit == "s")  return n * 1000 * kNsPerMs;
+    throw std::invalid_argument("不支援的時間單位：" + text);
+}
+
+// 以能整除的最大單位輸出 (parseSimTime 的反向)
+inline std::string formatSimTime(SimTime t) {
+    if (t != 0 && t % (1000 * kNsPerMs) == 0) return std::to_string(t / (1000 * kNsPerMs)) + "s";
+    if (t != 0 && t % kNsPerMs == 0)          return std::to_string(t / kNsPerMs) + "ms";
+    if (t != 0 && t % 1000 == 0)              return std::to_string(t / 1000) + "us";
+    return std::to_string(t) + "ns";
+}
+
+// ────────────────────────────────────────────────
+// SequenceExecutor 的模擬時鐘 (event-driven)
+//   每個操作只把時間往前推 cycleTime；Del 直接跳過整段時間，不逐 cycle 前進。
+//   與時間相關的 fault 自行記錄下一個事件的時間 (IFault::nextEvent)，
+//   executor 在每次操作前比較一次即可，暫停多久都是 O(1)。
+// ────────────────────────────────────────────────
+class SimClock {
+public:
+    explicit SimClock(SimTime cycleTime = kDefaultCycleTime) : cycleTime_(cycleTime) {}
+
+    SimTime now() const { return now_; }
+    SimTime cycleTime() const { return cycleTime_; }
+
+    void tick(int cycles = 1) { now_ += cycleTime_ * cycles; }
+    void advance(SimTime dt) { now_ += dt; }
+    void reset() { now_ = 0; }
+    // ⇕ 分岔時回到 element 開頭的時間
+    void rewind(SimTime t) { now_ = t; }
+
+private:
+    SimTime cycleTime_;
+    SimTime now_ {0};
+};
+
+#endif // SIM_CLOCK_H
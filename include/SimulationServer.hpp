@@ -0,0 +1,111 @@
+#ifndef SIMULATION_SERVER_H
+#define SIMULATION_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "FaultLibrary.hpp"
+#include "March.hpp"
+#include "MarchProgram.hpp"
+#include "MemoryState.hpp"
+#include "nlohmann/json.hpp"
+
+struct ServerOptions {
+    int rows {4};                    // job 沒有指定時的預設值
+    int cols {4};
+    int seed {12345};
+    int workers {0};                 // 0 = hardware concurrency
+    std::size_t queueDepth {64};     // 等待中的 job 上限，滿了讀取端會等待
+    MemoryKind memoryKind {MemoryKind::Auto};
+};
+
+// ────────────────────────────────────────────────
+// 常駐的模擬 server：每一行是一個 JSON job，每個 job 回覆一行 JSON (以 "id" 對應)
+//   fault library、解析後的 March test 與編譯好的 MarchProgram 都留在記憶體中，
+//   檔案修改時間改變才重新載入；job 由共用的 worker pool 執行 (每個 job 一個 worker)，
+//   回覆依完成先後送出。
+//
+//   模擬 job (可省略 "cmd"，或為 "simulate")：
+//     {"id": 1, "faults": "input/fault.json", "family": ["TF", "SAF"],
+//      "march": "builtin:March C-" | "<file>.json",  或 "pattern": "b(w0); a(r0,w1)",
+//      或 "march_library": "input/All_MarchTest.json", "march_name": "March X",
+//      "rows": 8, "cols": 8, "seed": 1, "address_order": "gray",
+//      "both_directions": false, "symmetry": false, "analytical": false,
+//      "detail": false, "report": "<detection report 輸出檔>"}
+//   回覆：{"id", "ok", "faults", "detected", "coverage", "timing_ms": {"queue", "load", "simulate", "total"},
+//          "cache": {"faults", "march", "program"}, "results": [...] (detail 時)} 或 {"id", "ok": false, "error"}
+//   其他指令："ping"、"stats"、"list_marches" ("file")、"evict" (清除快取)、"shutdown"
+// ────────────────────────────────────────────────
+class SimulationServer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SimulationServer(ServerOptions options = {});
+    ~SimulationServer();
+    SimulationServer(const SimulationServer&) = delete;
+    SimulationServer& operator=(const SimulationServer&) = delete;
+
+    // 同步處理一行 job，回傳回覆 (一行 JSON，不含換行)；"shutdown" 只回覆，不影響 server
+    std::string handle(const std::string& line);
+
+    // 從 in 讀取 job 交給 worker pool，回覆寫到 out；讀到 EOF 或 "shutdown" 後等所有 job 完成才返回
+    void serve(std::istream& in, std::ostream& out);
+    // 在 Unix domain socket (path) 上接受連線，每個連線同樣以 JSON lines 溝通；
+    // 任一連線送出 "shutdown" 或呼叫 stop() 後結束
+    void serveUnix(const std::string& path);
+    // 讓 serve / serveUnix 停止接收新的 job (可由其他 thread 呼叫)
+    void stop() { stopping_ = true; }
+
+    long long jobCount() const { return jobs_; }
+
+private:
+    class Channel;
+    class StreamChannel;
+    class SocketChannel;
+    class Pool;
+    struct Task;
+
+    using March = std::vector<MarchElement>;
+    struct LibraryEntry {
+        std::filesystem::file_time_type mtime;
+        std::shared_ptr<const FaultLibrary> library;
+    };
+    // March test 重新載入時整個 entry 被取代，舊的 program 一併丟棄
+    struct MarchEntry {
+        std::filesystem::file_time_type mtime;
+        std::shared_ptr<const March> elements;
+        std::map<std::pair<int, int>, std::shared_ptr<const MarchProgram>> programs; // (rows, cols)
+    };
+
+    // 讀取端：解析一行並排入 pool；收到 shutdown 時不排入，存到 stopJob 並回傳 false
+    bool dispatch(const std::string& line, const std::shared_ptr<Channel>& reply, Pool& pool,
+                  nlohmann::json& stopJob);
+    nlohmann::json execute(const nlohmann::json& job, Clock::time_point queued);
+    nlohmann::json simulate(const nlohmann::json& job, Clock::time_point queued);
+    nlohmann::json control(const std::string& cmd, const nlohmann::json& job);
+    int workerCount() const;
+
+    std::shared_ptr<const FaultLibrary> library(const std::string& path, bool& hit);
+    // key 為快取鍵 (March test 來源 + 位址順序)
+    std::shared_ptr<const March> march(const nlohmann::json& job, std::string& key, bool& hit);
+    std::shared_ptr<const MarchProgram> program(const std::string& key, const std::shared_ptr<const March>& elements,
+                                                int rows, int cols, bool& hit);
+
+    ServerOptions opt_;
+    std::atomic<bool> stopping_ {false};
+    std::atomic<long long> jobs_ {0};
+    std::atomic<long long> failed_ {0};
+
+    std::mutex cacheMu_;
+    std::map<std::string, LibraryEntry> libraries_;
+    std::map<std::string, MarchEntry> marches_;
+};
+
+#endif // SIMULATION_SERVER_H
@@ -0,0 +1,71 @@
+#ifndef SYMMETRY_REDUCER_H
+#define SYMMETRY_REDUCER_H
+
+#include <map>
+#include <vector>
+#include "DetectionReport.hpp"
+#include "FaultConfig.hpp"
+#include "March.hpp"
+#include "SensitizationFilter.hpp"
+
+// ────────────────────────────────────────────────
+// 對稱性化簡 (Symmetry reduction)
+//   把「結果必然相同」的 (fault, background, 位址) 組合歸為同一個 orbit，
+//   每個 orbit 只模擬一個代表，其餘由代表的報告換算位址得到。
+//
+//   1. 位址平移：與 AnalyticalEngine 相同，記憶體被 A / V 切成
+//      「之前 / A / 之間 / V / 之後」五段，同一段內的 cell 經歷完全相同的操作。
+//      只要 fault 語意、A / V 先後以及哪幾段為空都相同，syndrome 就相同，
+//      detectedVicAddrs_ 也可逐段對應過去。
+//      (只適用於 linear 位址順序；有 gray / stride 等順序時 orbit 改以實際位址區分)
+//   2. Background 無關：第一個 element 只有 write 時，結束後記憶體內容與
+//      初值無關；若 trigger 在該 element 內兩種初值下都不可能比對成功，
+//      init 0 與 init 1 的結果相同，init 1 可直接沿用 init 0。
+//
+//   未實作 (descoped)：資料互補 twin (f, init ↔ 互補的 f, 另一個 init) 需要 March test
+//   與自己的資料互補相同，只要有 read / write 就不成立；A<V ↔ A>V 鏡射需要每個 element
+//   反向後不變，只有全部為 ⇕ 時才成立，而 ⇕ 固定以 ⇑ 執行，鏡射後的報告並不相同。
+//   兩者都無法在不改變報告的前提下使用，因此 orbit 只涵蓋上面兩種關係。
+// ────────────────────────────────────────────────
+class SymmetryReducer {
+public:
+    using OrbitKey = std::vector<int>;
+
+    SymmetryReducer(const std::vector<MarchElement>& marchTest, int memorySize);
+
+    // (cfg, initValue, aggrAddr, vicAddr) 所屬的 orbit；單 cell fault 的 aggrAddr 為 -1
+    OrbitKey orbitKey(const FaultConfig& cfg, int initValue, int aggrAddr, int vicAddr) const;
+
+    // 此 orbit 已有代表時，換算出 (aggrAddr, vicAddr) 的報告並回傳 true
+    bool derive(const OrbitKey& key, int aggrAddr, int vicAddr, DetectionReport& out);
+
+    // 登記 orbit 代表的結果
+    void record(const OrbitKey& key, int aggrAddr, int vicAddr, const DetectionReport& report);
+
+    // init 1 的結果是否必然等於 init 0
+    bool backgroundIndependent(const FaultConfig& cfg) const;
+
+    int representatives() const { return static_cast<int>(orbits_.size()); }
+    int derivedCount() const { return derived_; }
+
+private:
+    struct Representative {
+        DetectionReport report;
+        int aggrAddr;
+        int vicAddr;
+    };
+
+    // 依 (aggrAddr, vicAddr) 把位址分成五段，回傳第 addr 所屬段的編號 (0..4)
+    static int segmentOf(int addr, int aggrAddr, int vicAddr);
+    // 第 seg 段的位址範圍 [first, last)
+    std::pair<int, int> segmentRange(int seg, int aggrAddr, int vicAddr) const;
+
+    SensitizationFilter filter_;
+    int memSize_;
+    bool firstElemWriteOnly_{false};
+    bool linearOrder_{true}; // 所有 element 都是 linear 位址順序 (否則不做位址平移)
+    std::map<OrbitKey, Representative> orbits_;
+    int derived_{0};
+};
+
+#endif // SYMMETRY_REDUCER_H
@@ -1,95 +1,173 @@
 import re
+import struct
 from pathlib import Path
+import numpy as np
 import pandas as pd
 import sys
 
 if len(sys.argv) != 3:
-    print("❌ Usage: python txt2excel.py <input_txt_file> <output_excel_file>")
+    print("❌ Usage: python txt2excel.py <report.txt|report.csv|report.fscol> <output_excel_file>")
     sys.exit(1)
 
-TXT_PATH = Path(sys.argv[1])  # Input TXT file path
+TXT_PATH = Path(sys.argv[1])  # Input report path (text, --csv or --columnar output)
 EXCEL_OUT = Path(sys.argv[2])  # Output Excel file path
 
-# ----------------------------------------------------------------------------------
-# 1) Pre-compile regular expressions
-fault_re   = re.compile(r'^\s*(.+?Fault.*)$')
-subcase_re = re.compile(r'^Subcase\s+(\d+)\s+<\s*([^>]+)\s*>')
-init_re    = re.compile(
-    r'^Init\s+([01]):\s+([01]+|No detection)(?:\s+\((0x[0-9a-fA-F]+)\))?'
-)
-
-# ----------------------------------------------------------------------------------
-# 2) Scan line by line
-rows_0, rows_1 = [], []
-cur_fault = cur_subcase = sfr_tag = None
+cols0 = ["Fault Name", "Subcase <idx>", "<S / F / R>",
+         "Init 0 <syndrome>", "Init 0 <hex_syndrome>", "Init 0 <detect OPs>"]
+cols1 = ["Fault Name", "Subcase <idx>", "<S / F / R>",
+         "Init 1 <syndrome>", "Init 1 <hex_syndrome>", "Init 1 <detect OPs>"]
 
-with TXT_PATH.open("r", encoding="utf-8") as f:
-    lines = f.readlines()
 
-i, n = 0, len(lines)
-while i < n:
-    line = lines[i].rstrip("\n")
+def split_by_init(df):
+    """One row per (fault, init) → the two Init0 / Init1 sheets."""
+    out = []
+    for init, cols in ((0, cols0), (1, cols1)):
+        part = df[df["init"] == init]
+        detected = part["detected"].astype(bool)
+        out.append(pd.DataFrame({
+            cols[0]: part["fault"].values,
+            cols[1]: part["subcase"].values,
+            cols[2]: part["sfr"].str.strip("<> ").values,
+            cols[3]: part["syndrome"].where(detected, "").values,
+            cols[4]: part["hex"].where(detected, "").values,
+            cols[5]: part["detect_ops"].fillna("").where(detected, "No detection").values,
+        })[cols])
+    return out
+
+
+def load_csv(path):
+    """Output of `Fault_simulator.exe ... --csv=FILE`: already one column per field."""
+    df = pd.read_csv(path, dtype={"syndrome": str, "hex": str, "detect_ops": str})
+    return split_by_init(df)
+
+
+def load_fscol(path):
+    """Output of `--columnar=FILE` (layout documented in Parser::writeColumnarReport)."""
+    data = path.read_bytes()
+    if data[:8] != b"FSCOL001":
+        raise ValueError(f"{path} is not a columnar report")
+    rows, reads, nstrings = struct.unpack_from("<III", data, 8)
+    off = 20
+    read_idx = np.frombuffer(data, "<i4", reads * 2, off).reshape(-1, 2)
+    off += reads * 8
+    strings = []
+    for _ in range(nstrings):
+        (n,) = struct.unpack_from("<I", data, off)
+        strings.append(data[off + 4:off + 4 + n].decode("utf-8"))
+        off += 4 + n
+
+    def column(dtype, count):
+        nonlocal off
+        col = np.frombuffer(data, dtype, count, off)
+        off += col.nbytes
+        return col
+
+    fault, subcase, sfr = column("<i4", rows), column("<i4", rows), column("<i4", rows)
+    init, detected = column("u1", rows), column("u1", rows)
+    words = (reads + 63) // 64
+    syn = column("<u8", rows * words).reshape(rows, words)
+    # bit i (LSB first) of each row → '0'/'1' string in read order
+    bits = np.unpackbits(syn.view("u1").reshape(rows, -1), axis=1, bitorder="little")[:, :reads]
+    names = np.array(strings, dtype=object)
+    ops = np.array([f"M{m}({o})" for m, o in read_idx], dtype=object)
+    syndrome = ["".join("1" if b else "0" for b in row) for row in bits]
+    df = pd.DataFrame({
+        "fault": names[fault], "subcase": subcase, "sfr": names[sfr],
+        "init": init, "detected": detected,
+        "syndrome": syndrome,
+        "hex": [hex(int(s, 2)) if s else "" for s in syndrome],
+        "detect_ops": [" ".join(ops[row.astype(bool)]) for row in bits],
+    })
+    return split_by_init(df)
+
+
+def load_txt(path):
+    """Legacy free-form text report (Parser::writeDetectionReport)."""
+    # ----------------------------------------------------------------------------------
+    # 1) Pre-compile regular expressions
+    fault_re   = re.compile(r'^\s*(.+?Fault.*)$')
+    subcase_re = re.compile(r'^Subcase\s+(\d+)\s+<\s*([^>]+)\s*>')
+    init_re    = re.compile(
+        r'^Init\s+([01]):\s+([01]+|No detection)(?:\s+\((0x[0-9a-fA-F]+)\))?'
+    )
+
+    # ----------------------------------------------------------------------------------
+    # 2) Scan line by line
+    rows_0, rows_1 = [], []
+    cur_fault = cur_subcase = sfr_tag = None
+
+    with path.open("r", encoding="utf-8") as f:
+        lines = f.readlines()
+
+    i, n = 0, len(lines)
+    while i < n:
+        line = lines[i].rstrip("\n")
+
+        # 2-1 Fault header
+        m_fault = fault_re.match(line)
+        if m_fault:
+            cur_fault = m_fault.group(1).strip()
+            i += 1
+            continue
+
+        # 2-2 Subcase
+        m_sub = subcase_re.match(line)
+        if m_sub:
+            cur_subcase = int(m_sub.group(1))
+            sfr_tag     = m_sub.group(2).strip()      # Keep the whole string
+            i += 1
+            continue
+
+        # 2-3 Init 0 / Init 1
+        m_init = init_re.match(line)
+        if m_init:
+            init_id       = int(m_init.group(1))             # 0 or 1
+            syndrome_bin  = m_init.group(2)                  # Could be "No detection"
+            hex_code      = m_init.group(3) or ""            # Could be empty string
+
+            # Try to read the next line for detection results
+            detect_ops = ""
+            if i + 1 < n:
+                nxt = lines[i + 1].lstrip()
+                # If the next line is not a new section (Subcase/Fault/Init) and not blank, treat as detection list
+                if (nxt and
+                    not nxt.startswith(("Init", "Subcase", "dynamic", "Stuck",
+                                       "Transition", "Write", "Read", "Disturb",
+                                       "Incorrect", "State", "Detected Rate"))):
+                    detect_ops = nxt.rstrip("\n")
+                    i += 1  # Skip this line additionally
+
+            row = {
+                "Fault Name"            : cur_fault,
+                "Subcase <idx>"         : cur_subcase,
+                "<S / F / R>"           : sfr_tag,
+                f"Init {init_id} <syndrome>"      : "" if syndrome_bin == "No detection" else syndrome_bin,
+                f"Init {init_id} <hex_syndrome>" : hex_code,
+                f"Init {init_id} <detect OPs>"   : detect_ops if syndrome_bin != "No detection" else "No detection"
+            }
+
+            # Put into the corresponding list
+            if init_id == 0:
+                rows_0.append(row)
+            else:
+                rows_1.append(row)
 
-    # 2-1 Fault header
-    m_fault = fault_re.match(line)
-    if m_fault:
-        cur_fault = m_fault.group(1).strip()
         i += 1
-        continue
 
-    # 2-2 Subcase
-    m_sub = subcase_re.match(line)
-    if m_sub:
-        cur_subcase = int(m_sub.group(1))
-        sfr_tag     = m_sub.group(2).strip()      # Keep the whole string
-        i += 1
-        continue
-
-    # 2-3 Init 0 / Init 1
-    m_init = init_re.match(line)
-    if m_init:
-        init_id       = int(m_init.group(1))             # 0 or 1
-        syndrome_bin  = m_init.group(2)                  # Could be "No detection"
-        hex_code      = m_init.group(3) or ""            # Could be empty string
-
-        # Try to read the next line for detection results
-        detect_ops = ""
-        if i + 1 < n:
-            nxt = lines[i + 1].lstrip()
-            # If the next line is not a new section (Subcase/Fault/Init) and not blank, treat as detection list
-            if (nxt and
-                not nxt.startswith(("Init", "Subcase", "dynamic", "Stuck",
-                                   "Transition", "Write", "Read", "Disturb",
-                                   "Incorrect", "State", "Detected Rate"))):
-                detect_ops = nxt.rstrip("\n")
-                i += 1  # Skip this line additionally
-
-        row = {
-            "Fault Name"            : cur_fault,
-            "Subcase <idx>"         : cur_subcase,
-            "<S / F / R>"           : sfr_tag,
-            f"Init {init_id} <syndrome>"      : "" if syndrome_bin == "No detection" else syndrome_bin,
-            f"Init {init_id} <hex_syndrome>" : hex_code,
-            f"Init {init_id} <detect OPs>"   : detect_ops if syndrome_bin != "No detection" else "No detection"
-        }
-
-        # Put into the corresponding list
-        if init_id == 0:
-            rows_0.append(row)
-        else:
-            rows_1.append(row)
-
-    i += 1
+    df0 = pd.DataFrame(rows_0)[cols0]
+    df1 = pd.DataFrame(rows_1)[cols1]
+    return df0, df1
 
-# ----------------------------------------------------------------------------------
-# 3) Convert to DataFrame and ensure column order
-cols0 = ["Fault Name", "Subcase <idx>", "<S / F / R>",
-         "Init 0 <syndrome>", "Init 0 <hex_syndrome>", "Init 0 <detect OPs>"]
-cols1 = ["Fault Name", "Subcase <idx>", "<S / F / R>",
-         "Init 1 <syndrome>", "Init 1 <hex_syndrome>", "Init 1 <detect OPs>"]
 
-df0 = pd.DataFrame(rows_0)[cols0]
-df1 = pd.DataFrame(rows_1)[cols1]
+# ----------------------------------------------------------------------------------
+# 3) Load the report: structured outputs are read column by column, text is re-parsed
+suffix = TXT_PATH.suffix.lower()
+if suffix == ".csv":
+    df0, df1 = load_csv(TXT_PATH)
+elif suffix == ".fscol":
+    df0, df1 = load_fscol(TXT_PATH)
+else:
+    df0, df1 = load_txt(TXT_PATH)
 
 # ----------------------------------------------------------------------------------
 # 4) Export to Excel: two sheets
@@ -1,4 +1,20 @@
 #include "../include/AddressAllocator.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+std::string AddressAllocator::state() const {
+    std::ostringstream out;
+    out << rng_;
+    return out.str();
+}
+
+void AddressAllocator::restore(const std::string& state) {
+    std::istringstream in(state);
+    std::mt19937 rng;
+    if (!(in >> rng)) throw std::invalid_argument("無效的亂數狀態");
+    rng_ = rng;
+}
 
 std::pair<int, int> AddressAllocator::allocate(const FaultConfig& config) {
     // For single-cell faults, aggressor is not used
@@ -31,4 +47,123 @@ std::pair<int, int> AddressAllocator::allocate(const FaultConfig& config) {
         return { highAddr, lowAddr };
     }
     return { -1, -1 }; // Fallback case, should not happen
+}
+
+std::pair<int, int> AddressAllocator::allocateDecoder(const FaultConfig& config) {
+    const int size = col_ * row_;
+    std::uniform_int_distribution<int> dist(0, size - 1);
+    const int addr = dist(rng_);
+    if (config.decoderKind_ == DecoderFaultKind::NoAccess) return { -1, addr };
+
+    // 候選的 partner 為 addr ^ bit (仍在範圍內者)，先計數再取第 k 個，不必建立暫存陣列
+    std::size_t count = 0;
+    for (int bit = 1; bit < size; bit <<= 1) {
+        if ((addr ^ bit) < size) ++count;
+    }
+    if (count == 0)
+        throw std::invalid_argument("記憶體太小，address decoder fault 至少需要兩個 cell");
+    std::uniform_int_distribution<std::size_t> pick(0, count - 1);
+    std::size_t k = pick(rng_);
+    for (int bit = 1;; bit <<= 1) {
+        if ((addr ^ bit) < size && k-- == 0) return { addr ^ bit, addr };
+    }
+}
+
+const NeighborhoodTable& AddressAllocator::table(int cellNumber) {
+    auto it = tables_.find(cellNumber);
+    if (it == tables_.end())
+        it = tables_.emplace(cellNumber, NeighborhoodTable(row_, col_, cellNumber)).first;
+    return it->second;
+}
+
+std::vector<int> AddressAllocator::allocateNeighborhood(const FaultConfig& config) {
+    std::vector<int> cells;
+    allocateNeighborhood(config, cells);
+    return cells;
+}
+
+void AddressAllocator::allocateNeighborhood(const FaultConfig& config, std::vector<int>& cells) {
+    const NeighborhoodTable& t = table(config.cellNumber_);
+    if (t.size() == 0)
+        throw std::invalid_argument("記憶體太小，放不下 " + std::to_string(config.cellNumber_) + "-cell 鄰域");
+    std::uniform_int_distribution<std::size_t> dist(0, t.size() - 1);
+    const int* picked = t.cells(dist(rng_));
+    cells.assign(picked, picked + t.cellNumber());
+}
+
+// === SpatialPlacementPlanner ===
+void SpatialPlacementPlanner::claim(int addr) {
+    const int r = addr / col_, c = addr % col_;
+    for (int dr = -1; dr <= 1; ++dr) {
+        for (int dc = -1; dc <= 1; ++dc) {
+            const int nr = r + dr, nc = c + dc;
+            if (nr < 0 || nr >= row_ || nc < 0 || nc >= col_) continue;
+            const int n = nr * col_ + nc;
+            if (!blocked_[n]) {
+                blocked_[n] = 1;
+                touched_.push_back(n);
+            }
+        }
+    }
+}
+
+void SpatialPlacementPlanner::clear() {
+    for (int addr : touched_) blocked_[addr] = 0;
+    touched_.clear();
+    cursor_ = 0;
+    tableCursor_.clear();
+    rowCursor_ = colCursor_ = 0;
+}
+
+std::vector<int> SpatialPlacementPlanner::placeNeighborhood(const FaultConfig& config) {
+    auto it = tables_.find(config.cellNumber_);
+    if (it == tables_.end())
+        it = tables_.emplace(config.cellNumber_, NeighborhoodTable(row_, col_, config.cellNumber_)).first;
+    const NeighborhoodTable& t = it->second;
+    std::size_t& i = tableCursor_[config.cellNumber_];
+    for (; i < t.size(); ++i) {
+        const int* cells = t.cells(i);
+        bool ok = true;
+        for (int k = 0; k < t.cellNumber() && ok; ++k) ok = usable(cells[k]);
+        if (!ok) continue;
+        for (int k = 0; k < t.cellNumber(); ++k) claim(cells[k]);
+        return std::vector<int>(cells, cells + t.cellNumber());
+    }
+    return {};
+}
+
+int SpatialPlacementPlanner::placeLine(const FaultConfig& config) {
+    const bool isRow = config.lineScope_ == LineScope::Row;
+    int& i = isRow ? rowCursor_ : colCursor_;
+    for (; i < (isRow ? row_ : col_); ++i) {
+        const LineRange line = lineOf(config.lineScope_, isRow ? i * col_ : i);
+        bool ok = true;
+        for (int k = 0; k < line.count && ok; ++k) ok = usable(line.first + k * line.stride);
+        if (!ok) continue;
+        for (int k = 0; k < line.count; ++k) claim(line.first + k * line.stride);
+        return line.first + (line.count / 2) * line.stride;
+    }
+    return -1;
+}
+
+std::pair<int, int> SpatialPlacementPlanner::place(const FaultConfig& config) {
+    const int size = row_ * col_;
+    for (; cursor_ < size; ++cursor_) {
+        const int addr = cursor_;
+        if (!usable(addr)) continue;
+        if (!config.is_twoCell_ && config.decoderKind_ != DecoderFaultKind::MultiCell
+                                && config.decoderKind_ != DecoderFaultKind::WrongCell) {
+            claim(addr);
+            return { -1, addr };
+        }
+        // 兩 cell fault 使用同一列上相鄰的兩個 cell (左 = 低位址)；
+        // decoder fault 的 partner 也取相鄰 cell (故障位址在右，first 為 partner)
+        if (addr % col_ == col_ - 1 || !usable(addr + 1)) continue;
+        const int lowAddr = addr, highAddr = addr + 1;
+        claim(lowAddr);
+        claim(highAddr);
+        if (config.isDecoder() || config.is_A_less_than_V_) return { lowAddr, highAddr };
+        return { highAddr, lowAddr };
+    }
+    return { -1, -1 };
 }
\ No newline at end of file
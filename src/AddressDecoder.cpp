@@ -0,0 +1,19 @@
+#include "../include/AddressDecoder.hpp"
+#include <stdexcept>
+
+DecoderFaultKind parseDecoderFaultKind(const std::string& name) {
+    if (name == "no-access")  return DecoderFaultKind::NoAccess;
+    if (name == "multi-cell") return DecoderFaultKind::MultiCell;
+    if (name == "wrong-cell") return DecoderFaultKind::WrongCell;
+    throw std::runtime_error("不支援的 address decoder fault: " + name);
+}
+
+const char* toString(DecoderFaultKind kind) {
+    switch (kind) {
+        case DecoderFaultKind::None:      return "none";
+        case DecoderFaultKind::NoAccess:  return "no-access";
+        case DecoderFaultKind::MultiCell: return "multi-cell";
+        case DecoderFaultKind::WrongCell: return "wrong-cell";
+    }
+    return "?";
+}
@@ -0,0 +1,133 @@
+#include "../include/AddressOrder.hpp"
+
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include "../include/CounterRng.hpp"
+
+namespace {
+
+std::vector<int> linearOrder(int rows, int cols, int) {
+    std::vector<int> seq(static_cast<std::size_t>(rows) * cols);
+    std::iota(seq.begin(), seq.end(), 0);
+    return seq;
+}
+
+std::vector<int> grayOrder(int rows, int cols, int) {
+    const int n = rows * cols;
+    std::vector<int> seq;
+    seq.reserve(n);
+    int codes = 1;
+    while (codes < n) codes <<= 1;
+    for (int i = 0; i < codes; ++i) {
+        const int g = i ^ (i >> 1);
+        if (g < n) seq.push_back(g);
+    }
+    return seq;
+}
+
+std::vector<int> strideOrder(int rows, int cols, int k) {
+    if (k < 0 || k > 30) throw std::invalid_argument("stride<k> 的 k 必須介於 0 到 30");
+    const int n = rows * cols;
+    const int step = 1 << k;
+    std::vector<int> seq;
+    seq.reserve(n);
+    for (int offset = 0; offset < step && offset < n; ++offset)
+        for (int a = offset; a < n; a += step) seq.push_back(a);
+    return seq;
+}
+
+std::vector<int> columnOrder(int rows, int cols, int) {
+    std::vector<int> seq;
+    seq.reserve(static_cast<std::size_t>(rows) * cols);
+    for (int c = 0; c < cols; ++c)
+        for (int r = 0; r < rows; ++r) seq.push_back(r * cols + c);
+    return seq;
+}
+
+// Fisher–Yates，亂數取自 CounterRng(key)：與平台的 std 分佈實作無關，同一個 key 永遠得到同一個排列
+std::vector<int> scrambleOrder(int rows, int cols, int key) {
+    std::vector<int> seq = linearOrder(rows, cols, 0);
+    const CounterRng rng(static_cast<uint64_t>(key));
+    for (std::size_t i = seq.size(); i > 1; --i) {
+        const std::size_t j = rng.bits(0, i) % i;
+        std::swap(seq[i - 1], seq[j]);
+    }
+    return seq;
+}
+
+struct Registry {
+    std::mutex mu;
+    std::map<std::string, AddressOrderGenerator> generators {
+        { "linear",   linearOrder },
+        { "gray",     grayOrder },
+        { "stride",   strideOrder },
+        { "col",      columnOrder },
+        { "scramble", scrambleOrder },
+    };
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+bool validName(const std::string& name) {
+    if (name.empty()) return false;
+    for (char c : name)
+        if (!std::isalpha(static_cast<unsigned char>(c)) && c != '-' && c != '_') return false;
+    return true;
+}
+
+} // namespace
+
+void AddressOrderRegistry::add(const std::string& name, AddressOrderGenerator generator) {
+    if (!validName(name)) throw std::invalid_argument("位址順序名稱只能包含英文字母、'-'、'_'：" + name);
+    if (!generator) throw std::invalid_argument("位址順序產生器不可為空：" + name);
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    r.generators[name] = std::move(generator);
+}
+
+bool AddressOrderRegistry::contains(const std::string& name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mu);
+    return r.generators.count(name) != 0;
+}
+
+AddressOrder AddressOrderRegistry::parse(const std::string& text) {
+    std::size_t digits = text.size();
+    while (digits > 0 && std::isdigit(static_cast<unsigned char>(text[digits - 1]))) --digits;
+    AddressOrder order;
+    order.name = text.substr(0, digits);
+    for (char& c : order.name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    order.param = (digits < text.size()) ? std::stoi(text.substr(digits)) : 0;
+    if (!contains(order.name)) throw std::invalid_argument("未知的位址順序：" + text);
+    return order;
+}
+
+std::vector<int> AddressOrderRegistry::generate(const AddressOrder& order, int rows, int cols) {
+    if (rows <= 0 || cols <= 0) throw std::invalid_argument("位址順序需要正的 rows / cols");
+    AddressOrderGenerator generator;
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mu);
+        auto it = r.generators.find(order.name);
+        if (it == r.generators.end()) throw std::invalid_argument("未知的位址順序：" + order.name);
+        generator = it->second;
+    }
+    std::vector<int> seq = generator(rows, cols, order.param);
+
+    const int n = rows * cols;
+    std::vector<char> seen(n, 0);
+    bool ok = static_cast<int>(seq.size()) == n;
+    for (std::size_t i = 0; ok && i < seq.size(); ++i) {
+        ok = seq[i] >= 0 && seq[i] < n && !seen[seq[i]];
+        if (ok) seen[seq[i]] = 1;
+    }
+    if (!ok) throw std::invalid_argument("位址順序 " + order.toString() + " 不是所有位址的一個排列");
+    return seq;
+}
@@ -0,0 +1,171 @@
+#include "../include/AnalyticalEngine.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include "../include/Fault.hpp"
+
+namespace {
+
+// 一段連續位址 [lo, hi)，段內所有 cell 的行為相同，以一個符號值代表
+struct SymCell {
+    int lo;
+    int hi;
+    int value;
+};
+
+} // namespace
+
+AnalyticalEngine::AnalyticalEngine(const std::vector<MarchElement>& marchTest, int memorySize)
+    : marchTest_(marchTest), memSize_(memorySize) {
+    for (const auto& elem : marchTest_) {
+        if (!elem.order_.linear()) nonLinearOrder_ = true;
+        for (const auto& op : elem.ops_) {
+            if (op.op_.type_ == OpType::R) readIdx_.push_back(op.idx_);
+            if (op.op_.repeat_ > 1) repeatedOps_ = true;
+        }
+    }
+}
+
+bool AnalyticalEngine::supports(const FaultConfig& cfg) const {
+    // 1-cell / 2-cell 序列觸發型 fault 皆可處理；N-cell fault 需要二維鄰域、
+    // decoder fault 改變位址對應、line fault 寫入整條線、time-dependent fault 需要時鐘、
+    // op^N 需要計數、非 linear 的位址順序打亂了「之前 / 之間 / 之後」三段，皆退回模擬
+    return memSize_ > 0 && !cfg.isNCell() && !cfg.isDecoder() && !cfg.isLine() && !cfg.isTimed()
+        && !cfg.hasRepeatedOps() && !repeatedOps_ && !nonLinearOrder_;
+}
+
+void AnalyticalResult::expandAddresses() {
+    for (const DetectedSegment& seg : segments)
+        for (int addr = seg.lo; addr < seg.hi; ++addr)
+            report.detectedVicAddrs_.insert(addr);
+}
+
+DetectionReport AnalyticalEngine::evaluate(const FaultConfig& cfg, int initValue,
+                                           int aggrAddr, int vicAddr) const {
+    AnalyticalResult result;
+    evaluate(cfg, initValue, aggrAddr, vicAddr, result);
+    result.expandAddresses();
+    return std::move(result.report);
+}
+
+void AnalyticalEngine::evaluate(const FaultConfig& cfg, int initValue, int aggrAddr, int vicAddr,
+                                AnalyticalResult& out) const {
+    DetectionReport& report = out.report;
+    report.isDetected_ = false;
+    report.detectedVicAddrs_.clear();
+    out.segments.clear();
+    if (memSize_ <= 0 || marchTest_.empty()) {
+        report.detected_.clear();
+        return;
+    }
+    if (report.detected_.size() != readIdx_.size()) report.detected_.clear(); // 沿用同一個 engine 的 key
+    for (const auto& idx : readIdx_) report.detected_[idx] = false;
+
+    const bool twoCell = cfg.is_twoCell_;
+
+    // ── 依位址切出符號 cell：[0,lo) lo (lo,hi) hi (hi,N) ──────────
+    std::vector<SymCell> cells;
+    auto addRange = [&](int lo, int hi) {
+        if (lo < hi) cells.push_back({lo, hi, initValue});
+    };
+    int vicIdx = -1, aggrIdx = -1;
+    if (twoCell) {
+        const int lo = std::min(aggrAddr, vicAddr);
+        const int hi = std::max(aggrAddr, vicAddr);
+        addRange(0, lo);
+        cells.push_back({lo, lo + 1, initValue});
+        const int loIdx = static_cast<int>(cells.size()) - 1;
+        addRange(lo + 1, hi);
+        cells.push_back({hi, hi + 1, initValue});
+        const int hiIdx = static_cast<int>(cells.size()) - 1;
+        addRange(hi + 1, memSize_);
+        vicIdx  = (vicAddr == lo) ? loIdx : hiIdx;
+        aggrIdx = (vicAddr == lo) ? hiIdx : loIdx;
+    } else {
+        addRange(0, vicAddr);
+        cells.push_back({vicAddr, vicAddr + 1, initValue});
+        vicIdx = static_cast<int>(cells.size()) - 1;
+        addRange(vicAddr + 1, memSize_);
+    }
+
+    // ── 觸發條件：與 OneCellSequenceTrigger / TwoCellCoupledTrigger 相同 ──
+    const bool isSa = twoCell && cfg.twoCellFaultType_ == TwoCellFaultType::Sa;
+    const int trigIdx    = isSa ? aggrIdx : vicIdx;
+    const int coupledIdx = isSa ? vicIdx  : aggrIdx;
+    const int coupledValue = isSa ? cfg.VI_ : cfg.AI_;
+
+    std::deque<OperationRecord> pattern;
+    for (std::size_t i = 0; i < cfg.trigger_.size(); ++i) {
+        const int before = (i == 0) ? (isSa ? cfg.AI_ : cfg.VI_) : cfg.trigger_[i - 1].value_;
+        pattern.push_back({before, cfg.trigger_[i]});
+    }
+    std::deque<OperationRecord> history;
+    bool matched = false;
+
+    // 整段一起記錄：段的長度與記憶體大小有關，逐一插入位址會使 evaluate() 變成 O(N)
+    auto record = [&](const PositionedOp& op, const SymCell& cell) {
+        report.detected_[op.idx_] = true;
+        report.isDetected_ = true;
+        out.segments.push_back({cell.lo, cell.hi, op.idx_});
+    };
+
+    auto processCell = [&](const MarchElement& elem, int k) {
+        SymCell& cell = cells[k];
+        for (const auto& pop : elem.ops_) {
+            const SingleOp& op = pop.op_;
+            if (op.type_ != OpType::R && op.type_ != OpType::W) continue;
+            const int before = cell.value;
+
+            if (!twoCell) {
+                // OneCellFault：只有 victim 會被觸發；其他位址一律 fault-free
+                if (k != vicIdx) {
+                    matched = false;
+                    if (op.type_ == OpType::W) cell.value = op.value_;
+                    else if (cell.value != op.value_) record(pop, cell);
+                    continue;
+                }
+                if (op.type_ == OpType::W) cell.value = op.value_;
+                history.push_back({before, op});
+                if (history.size() > pattern.size()) history.pop_front();
+                matched = (history == pattern);
+                int readValue = cell.value;
+                if (matched) {
+                    cell.value = cfg.faultValue_;
+                    readValue = cfg.finalReadValue_;
+                }
+                if (op.type_ == OpType::R && readValue != op.value_) record(pop, cell);
+                continue;
+            }
+
+            // TwoCellFault：只有 trigger cell 的操作會更新 matched，其餘沿用上一次結果
+            if (k == trigIdx) {
+                history.push_back({before, op});
+                if (history.size() > pattern.size()) history.pop_front();
+                matched = (history == pattern) && cells[coupledIdx].value == coupledValue;
+            }
+            if (op.type_ == OpType::W) {
+                if (matched) cells[vicIdx].value = cfg.faultValue_;
+                else cell.value = op.value_;
+            } else {
+                int readValue = cell.value;
+                if (matched) {
+                    cells[vicIdx].value = cfg.faultValue_;
+                    readValue = cfg.finalReadValue_;
+                }
+                if (readValue != op.value_) record(pop, cell);
+            }
+        }
+    };
+
+    const int n = static_cast<int>(cells.size());
+    for (const auto& elem : marchTest_) {
+        history.clear();
+        matched = false;
+        if (elem.addrOrder_ == Direction::DESC) {
+            for (int k = n - 1; k >= 0; --k) processCell(elem, k);
+        } else {
+            for (int k = 0; k < n; ++k) processCell(elem, k);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include "../include/Checkpoint.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr const char* kHeader = "FSCKPT 1";
+
+std::chrono::steady_clock::duration toDuration(double seconds) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds > 0 ? seconds : 0));
+}
+
+} // namespace
+
+// === CheckpointState ===
+void CheckpointState::save(const std::string& path) const {
+    if (job.find('\n') != std::string::npos || rngState.find('\n') != std::string::npos)
+        throw std::invalid_argument("檢查點內容不可包含換行");
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) throw std::runtime_error("無法寫入檢查點: " + tmp);
+        out << kHeader << "\n"
+            << "job " << job << "\n"
+            << "cursor " << cursor.init << " " << cursor.fault << "\n"
+            << "rng " << rngState << "\n";
+        out.flush();
+        if (!out) throw std::runtime_error("無法寫入檢查點: " + tmp);
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        throw std::runtime_error("無法更新檢查點: " + path);
+}
+
+CheckpointState CheckpointState::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("找不到檢查點: " + path);
+    auto field = [&](const std::string& key) {
+        std::string line;
+        if (!std::getline(in, line) || line.compare(0, key.size() + 1, key + " ") != 0)
+            throw std::runtime_error("檢查點格式錯誤 (缺少 " + key + "): " + path);
+        return line.substr(key.size() + 1);
+    };
+    std::string header;
+    if (!std::getline(in, header) || header != kHeader)
+        throw std::runtime_error("不是檢查點檔: " + path);
+
+    CheckpointState state;
+    state.job = field("job");
+    std::istringstream cursor(field("cursor"));
+    if (!(cursor >> state.cursor.init >> state.cursor.fault) || state.cursor.init < 0 || state.cursor.init > 2)
+        throw std::runtime_error("檢查點格式錯誤 (cursor): " + path);
+    state.rngState = field("rng");
+    return state;
+}
+
+// === CheckpointWriter ===
+CheckpointWriter::CheckpointWriter(ResultStore& results, std::string path, std::string job, double intervalSec)
+    : results_(results), path_(std::move(path)), job_(std::move(job)), interval_(toDuration(intervalSec)),
+      next_(std::chrono::steady_clock::now() + interval_) {
+    if (!results_.spilled())
+        throw std::invalid_argument("檢查點需要 spill 檔保存已完成的結果");
+}
+
+void CheckpointWriter::save(const RunCursor& cursor, const std::string& rngState) {
+    results_.flush(); // 先讓結果落地，檢查點才不會超前
+    CheckpointState{ job_, cursor, rngState }.save(path_);
+    ++saves_;
+    next_ = std::chrono::steady_clock::now() + interval_;
+}
+
+// === ProgressMeter ===
+ProgressMeter::ProgressMeter(long long total, long long done, std::ostream& out, double intervalSec)
+    : total_(total), start_(done), out_(out), interval_(toDuration(intervalSec)),
+      begin_(std::chrono::steady_clock::now()), next_(begin_ + interval_) {}
+
+void ProgressMeter::print(long long done) {
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - begin_).count();
+    const double rate = elapsed > 0 ? (done - start_) / elapsed : 0.0;
+
+    std::ostringstream line;
+    line << "Progress: " << done << "/" << total_;
+    if (total_ > 0) line << " (" << std::fixed << std::setprecision(1) << 100.0 * done / total_ << "%)";
+    line << ", " << std::fixed << std::setprecision(0) << rate << "/s";
+    if (done >= total_)  line << ", elapsed " << formatDuration(elapsed);
+    else if (rate > 0)   line << ", ETA " << formatDuration((total_ - done) / rate);
+    else                 line << ", ETA --";
+    out_ << line.str() << std::endl;
+    next_ = now + interval_;
+}
+
+std::string ProgressMeter::formatDuration(double seconds) {
+    long long s = static_cast<long long>(seconds + 0.5);
+    const long long h = s / 3600, m = s / 60 % 60;
+    s %= 60;
+    char buf[48];
+    if (h > 0)      std::snprintf(buf, sizeof(buf), "%lldh%02lldm%02llds", h, m, s);
+    else if (m > 0) std::snprintf(buf, sizeof(buf), "%lldm%02llds", m, s);
+    else            std::snprintf(buf, sizeof(buf), "%llds", s);
+    return buf;
+}
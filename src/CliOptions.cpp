@@ -0,0 +1,29 @@
+#include "../include/CliOptions.hpp"
+
+CliOptions::CliOptions(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0 || arg.size() == 2) {
+            positional_.push_back(std::move(arg));
+            continue;
+        }
+        auto eq = arg.find('=');
+        if (eq == std::string::npos) flags_[arg.substr(2)] = "";
+        else flags_[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+    }
+}
+
+std::string CliOptions::get(const std::string& key, const std::string& def) const {
+    auto it = flags_.find(key);
+    return (it == flags_.end() || it->second.empty()) ? def : it->second;
+}
+
+int CliOptions::getInt(const std::string& key, int def) const {
+    auto it = flags_.find(key);
+    return (it == flags_.end() || it->second.empty()) ? def : std::stoi(it->second);
+}
+
+double CliOptions::getDouble(const std::string& key, double def) const {
+    auto it = flags_.find(key);
+    return (it == flags_.end() || it->second.empty()) ? def : std::stod(it->second);
+}
@@ -0,0 +1,32 @@
+#include "../include/DataBackground.hpp"
+#include <sstream>
+#include <stdexcept>
+
+DataBackground parseDataBackground(const std::string& name) {
+    if (name == "solid")        return DataBackground::Solid;
+    if (name == "checkerboard") return DataBackground::Checkerboard;
+    if (name == "row")          return DataBackground::RowStripe;
+    if (name == "column")       return DataBackground::ColumnStripe;
+    throw std::runtime_error("不支援的 data background: " + name);
+}
+
+std::vector<DataBackground> parseDataBackgrounds(const std::string& list) {
+    std::vector<DataBackground> out;
+    std::stringstream ss(list);
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+        if (!name.empty()) out.push_back(parseDataBackground(name));
+    }
+    if (out.empty()) throw std::runtime_error("data background 清單為空");
+    return out;
+}
+
+const char* toString(DataBackground bg) {
+    switch (bg) {
+        case DataBackground::Solid:        return "solid";
+        case DataBackground::Checkerboard: return "checkerboard";
+        case DataBackground::RowStripe:    return "row";
+        case DataBackground::ColumnStripe: return "column";
+    }
+    return "?";
+}
@@ -0,0 +1,158 @@
+#include "../include/DiagnosticDictionary.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include "nlohmann/json.hpp"
+
+// === DiagnosticDictionary ===
+DiagnosticDictionary::DiagnosticDictionary(const std::vector<FaultConfig>& faults, const ResultStore& results)
+    : readIdx_(results.reads()) {
+    if (results.faultCount() != faults.size())
+        throw std::invalid_argument("ResultStore 的 fault 數與 fault library 不符");
+    for (std::size_t i = 0; i < readIdx_.size(); ++i) bitOf_[readIdx_[i].overallIdx] = static_cast<int>(i);
+    stride_ = static_cast<int>((readIdx_.size() + 63) / 64);
+
+    for (std::size_t f = 0; f < faults.size(); ++f)
+        addFault(faults[f].id_, results.syndrome(f, 0), results.syndrome(f, 1));
+    buildClasses();
+}
+
+Syndrome DiagnosticDictionary::syndromeOf(const DetectionReport& report) const {
+    Syndrome s(readCount());
+    for (const auto& [idx, failed] : report.detected_) {
+        if (!failed) continue;
+        auto it = bitOf_.find(idx.overallIdx);
+        if (it != bitOf_.end()) s.set(it->second);
+    }
+    return s;
+}
+
+void DiagnosticDictionary::addFault(const FaultID& id, const Syndrome& init0, const Syndrome& init1) {
+    const int f = faultCount();
+    ids_.push_back(id);
+    entryOf_.emplace_back(insert(init0, f), insert(init1, f));
+}
+
+int DiagnosticDictionary::insert(const Syndrome& syndrome, int fault) {
+    if (!syndrome.any()) return -1;
+    auto [it, added] = index_.emplace(syndrome, syndromeCount());
+    if (added) {
+        syndromes_.push_back(syndrome);
+        faults_.emplace_back();
+        packed_.insert(packed_.end(), syndrome.words().begin(), syndrome.words().end());
+    }
+    std::vector<int>& members = faults_[it->second];
+    // fault 依索引遞增加入，只需檢查最後一個
+    if (members.empty() || members.back() != fault) members.push_back(fault);
+    return it->second;
+}
+
+void DiagnosticDictionary::buildClasses() {
+    // (init 0, init 1) syndrome 相同的 fault 歸為一類
+    std::map<std::pair<int, int>, std::size_t> classOf;
+    classes_.clear();
+    detected_ = 0;
+    for (std::size_t f = 0; f < entryOf_.size(); ++f) {
+        const std::pair<int, int>& key = entryOf_[f];
+        if (key.first < 0 && key.second < 0) continue; // 未被偵測
+        ++detected_;
+        auto [it, added] = classOf.emplace(key, classes_.size());
+        if (added) classes_.emplace_back();
+        classes_[it->second].push_back(static_cast<int>(f));
+    }
+}
+
+const std::vector<int>* DiagnosticDictionary::exact(const Syndrome& observed) const {
+    auto it = index_.find(observed);
+    return it == index_.end() ? nullptr : &faults_[it->second];
+}
+
+DiagnosticDictionary::Match DiagnosticDictionary::nearest(const Syndrome& observed, int maxDistance) const {
+    Match match;
+    if (observed.size() != readCount())
+        throw std::invalid_argument("syndrome 長度與字典的 read 數不符");
+    if (const std::vector<int>* hit = exact(observed)) {
+        match.distance = 0;
+        match.faults = *hit;
+        return match;
+    }
+    int best = (maxDistance < 0) ? readCount() : maxDistance;
+    std::vector<int> bestEntries;
+    const uint64_t* obs = observed.words().data();
+    for (int k = 0; k < syndromeCount(); ++k) {
+        const uint64_t* w = packed_.data() + static_cast<std::size_t>(k) * stride_;
+        int d = 0;
+        for (int j = 0; j < stride_ && d <= best; ++j) d += std::popcount(w[j] ^ obs[j]);
+        if (d < best || (d == best && bestEntries.empty())) {
+            best = d;
+            bestEntries.assign(1, k);
+        } else if (d == best) {
+            bestEntries.push_back(k);
+        }
+    }
+    if (bestEntries.empty()) return match;
+    match.distance = best;
+    for (int k : bestEntries) match.faults.insert(match.faults.end(), faults_[k].begin(), faults_[k].end());
+    std::sort(match.faults.begin(), match.faults.end());
+    match.faults.erase(std::unique(match.faults.begin(), match.faults.end()), match.faults.end());
+    return match;
+}
+
+double DiagnosticDictionary::resolution() const {
+    return detected_ ? static_cast<double>(classes_.size()) / detected_ : 0.0;
+}
+
+// ─────────────── 保存 / 載入 ──────────────────────────────────────────
+//   { "reads":  [[marchIdx, opIdx, overallIdx], ...],
+//     "faults": [{"name": ..., "subcase": ..., "init0": "0101", "init1": "0000"}, ...] }
+//   只保存各 fault 的 syndrome，載入時重建 hash 表與等價類別。
+void DiagnosticDictionary::save(const std::string& filename) const {
+    nlohmann::json root;
+    root["reads"] = nlohmann::json::array();
+    for (const auto& idx : readIdx_) root["reads"].push_back({ idx.marchIdx, idx.opIdx, idx.overallIdx });
+    root["faults"] = nlohmann::json::array();
+    const std::string none(readCount(), '0');
+    auto bits = [&](int k) { return k < 0 ? none : syndromes_[k].toString(); };
+    for (std::size_t f = 0; f < ids_.size(); ++f) {
+        root["faults"].push_back({
+            { "name", ids_[f].faultName_.str() },
+            { "subcase", ids_[f].subcaseIdx_ },
+            { "init0", bits(entryOf_[f].first) },
+            { "init1", bits(entryOf_[f].second) },
+        });
+    }
+    std::ofstream ofs(filename);
+    if (!ofs) throw std::runtime_error("無法開啟輸出檔案: " + filename);
+    ofs << root.dump(1) << "\n";
+}
+
+DiagnosticDictionary DiagnosticDictionary::load(const std::string& filename) {
+    std::ifstream ifs(filename);
+    if (!ifs) throw std::runtime_error("無法開啟檔案: " + filename);
+    nlohmann::json root;
+    ifs >> root;
+    if (!root.is_object() || !root.contains("reads") || !root.contains("faults"))
+        throw std::runtime_error("診斷字典格式錯誤: " + filename);
+
+    DiagnosticDictionary dict;
+    for (const auto& r : root["reads"]) {
+        dict.bitOf_[r.at(2).get<int>()] = dict.readCount();
+        dict.readIdx_.emplace_back(r.at(0).get<int>(), r.at(1).get<int>(), r.at(2).get<int>());
+    }
+    dict.stride_ = (dict.readCount() + 63) / 64;
+
+    auto syndrome = [&](const nlohmann::json& j) {
+        Syndrome s = Syndrome::fromString(j.get<std::string>());
+        if (s.size() != dict.readCount())
+            throw std::runtime_error("診斷字典的 syndrome 長度與 read 數不符: " + filename);
+        return s;
+    };
+    for (const auto& jf : root["faults"]) {
+        dict.addFault({ jf.at("name").get<std::string>(), jf.at("subcase").get<int>() },
+                      syndrome(jf.at("init0")), syndrome(jf.at("init1")));
+    }
+    dict.buildClasses();
+    return dict;
+}
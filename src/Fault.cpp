@@ -1,4 +1,7 @@
 # include "../include/Fault.hpp"
+# include <algorithm>
+# include <stdexcept>
+# include <string>
 
 // === OneCellSequenceTrigger ===
 OneCellSequenceTrigger::OneCellSequenceTrigger(int vicAddr,
@@ -7,14 +10,20 @@ OneCellSequenceTrigger::OneCellSequenceTrigger(int vicAddr,
     setTrigCond();
 }
 
+void OneCellSequenceTrigger::bind(int vicAddr, std::shared_ptr<const FaultConfig> cfg) {
+    vicAddr_ = vicAddr;
+    cfg_ = std::move(cfg);
+    setTrigCond();
+    matched_ = false;
+}
+
 void OneCellSequenceTrigger::feed(int addr, const SingleOp& op, int beforeValue) {
     if (addr != vicAddr_) {
         matched_ = false; // 只要餵入非 victim cell 的操作，就重置 matched 狀態
         return;
     }
-    history_.push_back({beforeValue, op});
-    if (history_.size() > pattern_.size()) history_.pop_front();
-    matched_ = (history_ == pattern_);
+    history_.push({beforeValue, op});
+    matched_ = history_.equals(pattern_);
 }
 
 void OneCellSequenceTrigger::setTrigCond() {
@@ -26,6 +35,7 @@ void OneCellSequenceTrigger::setTrigCond() {
         }
         pattern_.emplace_back(OperationRecord{cfg_->trigger_[i-1].value_, cfg_->trigger_[i]});
     }
+    history_.setCapacity(pattern_.size());
 }
 
 // === TwoCellCoupledTrigger ===
@@ -37,12 +47,21 @@ TwoCellCoupledTrigger::TwoCellCoupledTrigger(int aggrAddr, int vicAddr,
     setTrigCond();
 }
 
+void TwoCellCoupledTrigger::bind(int aggrAddr, int vicAddr,
+                                 std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem) {
+    aggrAddr_ = aggrAddr;
+    vicAddr_ = vicAddr;
+    cfg_ = std::move(cfg);
+    mem_ = std::move(mem);
+    setTrigCond();
+    matched_ = false;
+}
+
 void TwoCellCoupledTrigger::feed(int addr, const SingleOp& op, int beforeValue) {
     if ((cfg_->twoCellFaultType_ == TwoCellFaultType::Sa && addr == aggrAddr_) ||
             (cfg_->twoCellFaultType_ == TwoCellFaultType::Sv && addr == vicAddr_)) {
-        history_.push_back({beforeValue, op});
-        if (history_.size() > pattern_.size()) history_.pop_front();
-        if (history_ == pattern_) {
+        history_.push({beforeValue, op});
+        if (history_.equals(pattern_)) {
             if (cfg_->twoCellFaultType_ == TwoCellFaultType::Sa) {
                 // 如果是 Sa，則需要讀取 coupled cell 的值
                 int coupledValue = mem_->read(vicAddr_);
@@ -76,6 +95,7 @@ void TwoCellCoupledTrigger::setTrigCond() {
         }
         pattern_.emplace_back(OperationRecord{cfg_->trigger_[i-1].value_, cfg_->trigger_[i]});
     }
+    history_.setCapacity(pattern_.size());
     // 如果是耦合觸發，還需要記錄 coupled cell 的值
     if (cfg_->twoCellFaultType_ == TwoCellFaultType::Sa) {
         coupledTriggerValue_ = cfg_->VI_;
@@ -84,6 +104,92 @@ void TwoCellCoupledTrigger::setTrigCond() {
     }
 }
 
+// === CountedSequenceTrigger ===
+CountedSequenceTrigger::CountedSequenceTrigger(int trigAddr, int coupledAddr,
+                                               std::shared_ptr<const FaultConfig> cfg,
+                                               std::shared_ptr<MemoryState> mem)
+    : trigAddr_(trigAddr), coupledAddr_(coupledAddr), cfg_(std::move(cfg)), mem_(std::move(mem)) {
+    setTrigCond();
+}
+
+void CountedSequenceTrigger::bind(int trigAddr, int coupledAddr,
+                                  std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem) {
+    trigAddr_ = trigAddr;
+    coupledAddr_ = coupledAddr;
+    cfg_ = std::move(cfg);
+    mem_ = std::move(mem);
+    setTrigCond();
+    matched_ = false;
+}
+
+void CountedSequenceTrigger::feed(int addr, const SingleOp& op, int beforeValue) {
+    if (addr != trigAddr_) {
+        if (coupledAddr_ < 0) matched_ = false; // 1-cell：其他 cell 的操作只重置 matched
+        return;
+    }
+    matched_ = matcher_.feed({beforeValue, op}) &&
+               (coupledAddr_ < 0 || mem_->read(coupledAddr_) == coupledValue_);
+}
+
+void CountedSequenceTrigger::setTrigCond() {
+    matcher_.setPattern(cfg_->triggerInitialValue(), cfg_->trigger_);
+    coupledValue_ = -1;
+    if (cfg_->is_twoCell_) {
+        coupledValue_ = (cfg_->twoCellFaultType_ == TwoCellFaultType::Sa) ? cfg_->VI_ : cfg_->AI_;
+    }
+}
+
+// === NCellPatternTrigger ===
+NCellPatternTrigger::NCellPatternTrigger(const std::vector<int>& cells, int cols,
+                                         std::shared_ptr<const FaultConfig> cfg,
+                                         std::shared_ptr<MemoryState> mem) {
+    bind(cells, cols, std::move(cfg), std::move(mem));
+}
+
+void NCellPatternTrigger::bind(const std::vector<int>& cells, int cols,
+                               std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem) {
+    const int n = static_cast<int>(cells.size());
+    if (!NeighborhoodLayout::valid(n) || static_cast<int>(cfg->cellStates_.size()) != n)
+        throw std::invalid_argument("NCellPatternTrigger: 鄰域大小與 fault 設定不符");
+    cells_.assign(cells.begin(), cells.end());
+    cols_ = cols;
+    cfg_ = std::move(cfg);
+    mem_ = std::move(mem);
+    const int vic = cells_[NeighborhoodLayout::victimIndex(n)];
+    vicRow_ = vic / cols_;
+    vicCol_ = vic % cols_;
+    setTrigCond();
+    packed_ = 0;
+    synced_ = false;
+    matched_ = false;
+}
+
+void NCellPatternTrigger::feed(int addr, const SingleOp& op, int beforeValue) {
+    if (!synced_) {
+        // 記憶體在 fault 建立後才被重置，因此延到第一次操作才載入鄰域
+        packed_ = 0;
+        for (std::size_t k = 0; k < cells_.size(); ++k)
+            if (mem_->read(cells_[k])) packed_ |= (1u << k);
+        synced_ = true;
+    }
+    if (slotOf(addr) != cfg_->triggerCell_) {
+        matched_ = false;
+        return;
+    }
+    matched_ = matcher_.feed({beforeValue, op}) && (packed_ & careMask_) == careValue_;
+}
+
+void NCellPatternTrigger::setTrigCond() {
+    matcher_.setPattern(cfg_->triggerInitialValue(), cfg_->trigger_);
+    careMask_ = careValue_ = 0;
+    for (std::size_t k = 0; k < cfg_->cellStates_.size(); ++k) {
+        const int state = cfg_->cellStates_[k];
+        if (static_cast<int>(k) == cfg_->triggerCell_ || state < 0) continue;
+        careMask_ |= (1u << k);
+        if (state) careValue_ |= (1u << k);
+    }
+}
+
 // === IFault::injectFault ===
 void IFault::payload() {
     // 假設 FaultConfig 帶有 victim address & fault value
@@ -94,7 +200,9 @@ void IFault::payload() {
 std::unique_ptr<OneCellFault> OneCellFault::create(std::shared_ptr<const FaultConfig> cfg,
                                                    std::shared_ptr<MemoryState> mem,
                                                    int vicAddr) {
-    auto trig = std::make_unique<OneCellSequenceTrigger>(vicAddr, cfg);
+    std::unique_ptr<ITrigger> trig;
+    if (cfg->hasRepeatedOps()) trig = std::make_unique<CountedSequenceTrigger>(vicAddr, -1, cfg, mem);
+    else                       trig = std::make_unique<OneCellSequenceTrigger>(vicAddr, cfg);
     return std::unique_ptr<OneCellFault>(new OneCellFault(
         std::move(cfg), std::move(mem), std::move(trig), vicAddr));
 }
@@ -124,7 +232,14 @@ std::unique_ptr<TwoCellFault> TwoCellFault::create(std::shared_ptr<const FaultCo
                                                    std::shared_ptr<MemoryState> mem,
                                                    int aggrAddr,
                                                    int vicAddr) {
-    auto trig = std::make_unique<TwoCellCoupledTrigger>(aggrAddr, vicAddr, cfg, mem);
+    std::unique_ptr<ITrigger> trig;
+    if (cfg->hasRepeatedOps()) {
+        const bool onAggr = cfg->twoCellFaultType_ == TwoCellFaultType::Sa;
+        trig = std::make_unique<CountedSequenceTrigger>(onAggr ? aggrAddr : vicAddr,
+                                                        onAggr ? vicAddr : aggrAddr, cfg, mem);
+    } else {
+        trig = std::make_unique<TwoCellCoupledTrigger>(aggrAddr, vicAddr, cfg, mem);
+    }
     return std::unique_ptr<TwoCellFault>(new TwoCellFault(std::move(cfg), std::move(mem), std::move(trig), 
                                                          aggrAddr, vicAddr));
 }
@@ -147,4 +262,449 @@ int TwoCellFault::readProcess(int addr, const SingleOp& op) {
         return cfg_->finalReadValue_; // 返回故障後的值
     }
     return mem_->read(addr);
+}
+
+// === NCellFault ===
+std::unique_ptr<NCellFault> NCellFault::create(std::shared_ptr<const FaultConfig> cfg,
+                                               std::shared_ptr<MemoryState> mem,
+                                               const std::vector<int>& cells,
+                                               int cols) {
+    auto trig = std::make_unique<NCellPatternTrigger>(cells, cols, cfg, mem);
+    const int vicAddr = cells[NeighborhoodLayout::victimIndex(static_cast<int>(cells.size()))];
+    return std::unique_ptr<NCellFault>(new NCellFault(std::move(cfg), std::move(mem), std::move(trig), vicAddr));
+}
+
+void NCellFault::bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+                      const std::vector<int>& cells, int cols) {
+    pattern_->bind(cells, cols, cfg, mem);
+    rebind(std::move(cfg), std::move(mem),
+           cells[NeighborhoodLayout::victimIndex(static_cast<int>(cells.size()))]);
+}
+
+void NCellFault::writeProcess(int addr, const SingleOp& op) {
+    int before = mem_->read(addr);
+    trigger_->feed(addr, op, before);
+    const bool hit = trigger_->matched();
+    mem_->write(addr, op.value_);
+    pattern_->observe(addr, op.value_);
+    if (hit) {
+        payload();
+        pattern_->observe(vicAddr_, cfg_->faultValue_);
+    }
+}
+
+int NCellFault::readProcess(int addr, const SingleOp& op) {
+    int before = mem_->read(addr);
+    trigger_->feed(addr, op, before);
+    if (trigger_->matched()) {
+        payload();
+        pattern_->observe(vicAddr_, cfg_->faultValue_);
+        if (addr == vicAddr_) return cfg_->finalReadValue_;
+    }
+    return mem_->read(addr);
+}
+
+// === DecoderFault ===
+std::unique_ptr<DecoderFault> DecoderFault::create(std::shared_ptr<const FaultConfig> cfg,
+                                                   std::shared_ptr<MemoryState> mem,
+                                                   int addr,
+                                                   int partner) {
+    auto table = std::make_shared<DecodeTable>();
+    fillTable(*table, *cfg, addr, partner);
+    return std::make_unique<DecoderFault>(std::move(mem), std::move(table),
+                                          cfg->faultValue_, cfg->faultValue_ == 1, addr);
+}
+
+void DecoderFault::fillTable(DecodeTable& table, const FaultConfig& cfg, int addr, int partner) {
+    table.clear();
+    switch (cfg.decoderKind_) {
+        case DecoderFaultKind::NoAccess:  table.remap(addr, {}); break;
+        case DecoderFaultKind::MultiCell: table.remap(addr, { addr, partner }); break;
+        case DecoderFaultKind::WrongCell: table.remap(addr, { partner }); break;
+        case DecoderFaultKind::None:
+            throw std::invalid_argument("DecoderFault: fault 設定不是 address decoder fault");
+    }
+}
+
+void DecoderFault::writeProcess(int addr, const SingleOp& op) {
+    const std::vector<int>* cells = table_->lookup(addr);
+    if (!cells) {
+        mem_->write(addr, op.value_);
+        return;
+    }
+    for (int cell : *cells) mem_->write(cell, op.value_);
+}
+
+int DecoderFault::readProcess(int addr, const SingleOp& op) {
+    (void)op;
+    const std::vector<int>* cells = table_->lookup(addr);
+    if (!cells) return mem_->read(addr);
+    if (cells->empty()) return floatingValue_;
+    int value = mem_->read(cells->front());
+    for (std::size_t i = 1; i < cells->size(); ++i) {
+        const int v = mem_->read((*cells)[i]);
+        value = wiredOr_ ? (value | v) : (value & v);
+    }
+    return value;
+}
+
+// === LineFault ===
+std::unique_ptr<LineFault> LineFault::create(std::shared_ptr<const FaultConfig> cfg,
+                                             std::shared_ptr<MemoryState> mem,
+                                             int vicAddr,
+                                             LineRange line) {
+    if (!line.contains(vicAddr))
+        throw std::invalid_argument("LineFault: 觸發 cell 不在 row / column 上");
+    std::unique_ptr<ITrigger> trig;
+    if (cfg->hasRepeatedOps()) trig = std::make_unique<CountedSequenceTrigger>(vicAddr, -1, cfg, mem);
+    else                       trig = std::make_unique<OneCellSequenceTrigger>(vicAddr, cfg);
+    return std::unique_ptr<LineFault>(new LineFault(std::move(cfg), std::move(mem), std::move(trig),
+                                                    vicAddr, line));
+}
+
+void LineFault::bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+                     int vicAddr, LineRange line) {
+    if (!line.contains(vicAddr))
+        throw std::invalid_argument("LineFault: 觸發 cell 不在 row / column 上");
+    rebind(std::move(cfg), std::move(mem), vicAddr);
+    line_ = line;
+}
+
+void LineFault::writeProcess(int addr, const SingleOp& op) {
+    int before = mem_->read(addr);
+    mem_->write(addr, op.value_);
+    trigger_->feed(addr, op, before);
+    if (trigger_->matched()) payload();
+}
+
+int LineFault::readProcess(int addr, const SingleOp& op) {
+    int before = mem_->read(addr);
+    trigger_->feed(addr, op, before);
+    if (trigger_->matched()) {
+        payload();
+        return cfg_->finalReadValue_;
+    }
+    return mem_->read(addr);
+}
+
+// === RetentionFault ===
+std::unique_ptr<RetentionFault> RetentionFault::create(std::shared_ptr<const FaultConfig> cfg,
+                                                       std::shared_ptr<MemoryState> mem,
+                                                       int vicAddr) {
+    if (!cfg->isTimed() || cfg->retentionTime_ <= 0)
+        throw std::invalid_argument("RetentionFault: fault 設定沒有 retention time");
+    return std::make_unique<RetentionFault>(std::move(cfg), std::move(mem), vicAddr);
+}
+
+void RetentionFault::bind(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem, int vicAddr) {
+    if (!cfg->isTimed() || cfg->retentionTime_ <= 0)
+        throw std::invalid_argument("RetentionFault: fault 設定沒有 retention time");
+    rebind(std::move(cfg), std::move(mem), vicAddr);
+    deadline_ = kNever;
+}
+
+void RetentionFault::restore(int value) {
+    deadline_ = (clock_ && value == cfg_->VI_) ? clock_->now() + cfg_->retentionTime_ : kNever;
+}
+
+void RetentionFault::attachClock(const SimClock* clock) {
+    IFault::attachClock(clock);
+    restore(mem_->read(vicAddr_));
+}
+
+void RetentionFault::writeProcess(int addr, const SingleOp& op) {
+    mem_->write(addr, op.value_);
+    if (addr == vicAddr_) restore(op.value_);
+}
+
+int RetentionFault::readProcess(int addr, const SingleOp& op) {
+    (void)op;
+    const int value = mem_->read(addr);
+    if (addr == vicAddr_ && cfg_->timeKind_ == TimeFaultKind::Leakage) restore(value);
+    return value;
+}
+
+void RetentionFault::onEvent(SimTime now) {
+    if (deadline_ > now) return;
+    payload();
+    restore(cfg_->faultValue_);
+}
+
+// === FaultPool ===
+IFault& FaultPool::acquire(std::shared_ptr<const FaultConfig> cfg, std::shared_ptr<MemoryState> mem,
+                           int aggrAddr, int vicAddr, const std::vector<int>& cells, int cols,
+                           const LineRange& line) {
+    // slot 為空時建立 fault 與 trigger，否則兩者都以新的參數 bind
+    auto reuse = [&](auto& slot, auto makeTrigger, auto makeFault, auto bindTrigger, auto bindFault) -> IFault& {
+        if (!slot.fault) {
+            auto trig = makeTrigger();
+            slot.trigger = trig.get();
+            slot.fault = makeFault(std::move(trig));
+        } else {
+            bindTrigger(*slot.trigger);
+            bindFault(*slot.fault);
+        }
+        return *slot.fault;
+    };
+    using OneTrig = OneCellSequenceTrigger;
+    using CountTrig = CountedSequenceTrigger;
+    const bool counted = cfg->hasRepeatedOps();
+
+    if (cfg->isNCell()) {
+        if (!nCell_) nCell_ = NCellFault::create(cfg, mem, cells, cols);
+        else         nCell_->bind(cfg, mem, cells, cols);
+        return *nCell_;
+    }
+    if (cfg->isDecoder()) {
+        if (!decodeTable_) decodeTable_ = std::make_shared<DecodeTable>();
+        DecoderFault::fillTable(*decodeTable_, *cfg, vicAddr, aggrAddr);
+        if (!decoder_) decoder_ = std::make_unique<DecoderFault>(mem, decodeTable_, cfg->faultValue_,
+                                                                 cfg->faultValue_ == 1, vicAddr);
+        else           decoder_->bind(*cfg, mem, vicAddr);
+        return *decoder_;
+    }
+    if (cfg->isTimed()) {
+        if (!retention_) retention_ = RetentionFault::create(cfg, mem, vicAddr);
+        else             retention_->bind(cfg, mem, vicAddr);
+        return *retention_;
+    }
+    if (cfg->isLine()) {
+        auto makeFault = [&](std::unique_ptr<ITrigger> trig) {
+            if (!line.contains(vicAddr))
+                throw std::invalid_argument("LineFault: 觸發 cell 不在 row / column 上");
+            return std::make_unique<LineFault>(cfg, mem, std::move(trig), vicAddr, line);
+        };
+        auto bindFault = [&](LineFault& f) { f.bind(cfg, mem, vicAddr, line); };
+        if (counted)
+            return reuse(lineCounted_, [&] { return std::make_unique<CountTrig>(vicAddr, -1, cfg, mem); },
+                         makeFault, [&](CountTrig& t) { t.bind(vicAddr, -1, cfg, mem); }, bindFault);
+        return reuse(line_, [&] { return std::make_unique<OneTrig>(vicAddr, cfg); },
+                     makeFault, [&](OneTrig& t) { t.bind(vicAddr, cfg); }, bindFault);
+    }
+    if (cfg->is_twoCell_) {
+        auto makeFault = [&](std::unique_ptr<ITrigger> trig) {
+            return std::make_unique<TwoCellFault>(cfg, mem, std::move(trig), aggrAddr, vicAddr);
+        };
+        auto bindFault = [&](TwoCellFault& f) { f.bind(cfg, mem, aggrAddr, vicAddr); };
+        if (counted) {
+            const bool onAggr = cfg->twoCellFaultType_ == TwoCellFaultType::Sa;
+            const int trigAddr = onAggr ? aggrAddr : vicAddr;
+            const int coupledAddr = onAggr ? vicAddr : aggrAddr;
+            return reuse(twoCellCounted_,
+                         [&] { return std::make_unique<CountTrig>(trigAddr, coupledAddr, cfg, mem); },
+                         makeFault, [&](CountTrig& t) { t.bind(trigAddr, coupledAddr, cfg, mem); }, bindFault);
+        }
+        return reuse(twoCell_, [&] { return std::make_unique<TwoCellCoupledTrigger>(aggrAddr, vicAddr, cfg, mem); },
+                     makeFault, [&](TwoCellCoupledTrigger& t) { t.bind(aggrAddr, vicAddr, cfg, mem); }, bindFault);
+    }
+    auto makeFault = [&](std::unique_ptr<ITrigger> trig) {
+        return std::make_unique<OneCellFault>(cfg, mem, std::move(trig), vicAddr);
+    };
+    auto bindFault = [&](OneCellFault& f) { f.bind(cfg, mem, vicAddr); };
+    if (counted)
+        return reuse(oneCellCounted_, [&] { return std::make_unique<CountTrig>(vicAddr, -1, cfg, mem); },
+                     makeFault, [&](CountTrig& t) { t.bind(vicAddr, -1, cfg, mem); }, bindFault);
+    return reuse(oneCell_, [&] { return std::make_unique<OneTrig>(vicAddr, cfg); },
+                 makeFault, [&](OneTrig& t) { t.bind(vicAddr, cfg); }, bindFault);
+}
+
+// === FaultOverlay ===
+int FaultOverlay::add(std::unique_ptr<IFault> fault, const std::vector<int>& cells) {
+    const int id = static_cast<int>(faults_.size());
+    for (int addr : cells) {
+        if (addr < 0 || addr >= static_cast<int>(owner_.size()))
+            throw std::out_of_range("FaultOverlay: 位址超出範圍 " + std::to_string(addr));
+        if (owner_[addr] != -1)
+            throw std::logic_error("FaultOverlay: 位址已被其他 fault 佔用 " + std::to_string(addr));
+        owner_[addr] = id;
+        claimed_.push_back(addr);
+    }
+    if (fault->timed()) timed_.push_back(id);
+    faults_.push_back(std::move(fault));
+    return id;
+}
+
+void FaultOverlay::clear() {
+    for (int addr : claimed_) owner_[addr] = -1;
+    claimed_.clear();
+    faults_.clear();
+    timed_.clear();
+}
+
+void FaultOverlay::writeProcess(int addr, const SingleOp& op) {
+    const int owner = ownerOf(addr);
+    if (owner < 0) {
+        mem_->write(addr, op.value_);
+        return;
+    }
+    faults_[owner]->writeProcess(addr, op);
+}
+
+int FaultOverlay::readProcess(int addr, const SingleOp& op) {
+    const int owner = ownerOf(addr);
+    if (owner < 0) return mem_->read(addr);
+    return faults_[owner]->readProcess(addr, op);
+}
+
+void FaultOverlay::reset() {
+    for (auto& f : faults_) f->reset();
+}
+
+void FaultOverlay::attachClock(const SimClock* clock) {
+    IFault::attachClock(clock);
+    for (auto& f : faults_) f->attachClock(clock);
+}
+
+SimTime FaultOverlay::nextEvent() const {
+    SimTime next = kNever;
+    for (int id : timed_) next = std::min(next, faults_[id]->nextEvent());
+    return next;
+}
+
+void FaultOverlay::onEvent(SimTime now) {
+    for (int id : timed_)
+        if (faults_[id]->nextEvent() <= now) faults_[id]->onEvent(now);
+}
+
+// === LinkedFault ===
+int LinkedFault::senseAll(int addr, const SingleOp& op, bool& blocksWrite) {
+    const int before = mem_->read(addr);
+    int last = -1;
+    blocksWrite = false;
+    for (std::size_t i = 0; i < members_.size(); ++i) {
+        matched_[i] = members_[i]->sense(addr, op, before);
+        if (matched_[i]) {
+            last = static_cast<int>(i);
+            blocksWrite = blocksWrite || members_[i]->overridesWrite();
+        }
+    }
+    return last;
+}
+
+void LinkedFault::writeProcess(int addr, const SingleOp& op) {
+    bool blocksWrite;
+    const int last = senseAll(addr, op, blocksWrite);
+    if (!blocksWrite) mem_->write(addr, op.value_);
+    if (last < 0) return;
+    for (std::size_t i = 0; i < members_.size(); ++i) {
+        if (matched_[i]) members_[i]->inject();
+    }
+}
+
+int LinkedFault::readProcess(int addr, const SingleOp& op) {
+    bool blocksWrite;
+    const int last = senseAll(addr, op, blocksWrite);
+    if (last < 0) return mem_->read(addr);
+    for (std::size_t i = 0; i < members_.size(); ++i) {
+        if (matched_[i]) members_[i]->inject();
+    }
+    return members_[last]->finalRead();
+}
+
+void LinkedFault::reset() {
+    for (auto& m : members_) m->reset();
+}
+
+// === ProbabilisticFault ===
+bool ProbabilisticFault::activated(int addr, const SingleOp& op) {
+    if (!inner_->sense(addr, op, mem_->read(addr))) return false;
+    return probability_ >= 1.0 || coin_.uniform() < probability_;
+}
+
+void ProbabilisticFault::writeProcess(int addr, const SingleOp& op) {
+    const bool hit = activated(addr, op);
+    if (!(hit && inner_->overridesWrite())) mem_->write(addr, op.value_);
+    if (hit) inner_->inject();
+}
+
+int ProbabilisticFault::readProcess(int addr, const SingleOp& op) {
+    if (!activated(addr, op)) return mem_->read(addr);
+    inner_->inject();
+    return inner_->finalRead();
+}
+
+// === WordLaneFault ===
+WordLaneFault::WordLaneFault(std::shared_ptr<const FaultConfig> cfg,
+                             std::shared_ptr<WordMemoryState> mem,
+                             int wordAddr)
+    : cfg_(std::move(cfg)), mem_(std::move(mem)), wordAddr_(wordAddr),
+      mask_(mem_->mask()) {
+    for (const auto& op : cfg_->trigger_)
+        trig_.insert(trig_.end(), op.repeat_, SingleOp{op.type_, op.value_});
+    prefix_.assign(trig_.size() + 1, 0);
+    if (!cfg_->is_twoCell_)            valid_ = mask_;
+    else if (cfg_->is_A_less_than_V_)  valid_ = mask_ & ~uint64_t{1};
+    else                               valid_ = mask_ >> 1;
+    reload();
+}
+
+void WordLaneFault::reset() {
+    std::fill(prefix_.begin(), prefix_.end(), 0);
+}
+
+void WordLaneFault::reload() {
+    vic_ = mem_->read(wordAddr_);
+    reset();
+}
+
+uint64_t WordLaneFault::aggressorLanes(uint64_t word) const {
+    return cfg_->is_A_less_than_V_ ? ((word << 1) & mask_) : (word >> 1);
+}
+
+uint64_t WordLaneFault::feed(OpType type, uint64_t good, uint64_t value) {
+    const bool onAggressor = cfg_->is_twoCell_ && cfg_->twoCellFaultType_ == TwoCellFaultType::Sa;
+    const uint64_t before = onAggressor ? aggressorLanes(good) : vic_;
+    if (onAggressor) value = aggressorLanes(value);
+
+    // shift-and：由後往前更新，prefix_[0] 恆為全部 lanes
+    const auto& trig = trig_;
+    prefix_[0] = mask_;
+    for (std::size_t k = trig.size(); k > 0; --k) {
+        const int stepBefore = (k == 1) ? (onAggressor ? cfg_->AI_ : cfg_->VI_) : trig[k - 2].value_;
+        uint64_t cond = (trig[k - 1].type_ == type) ? mask_ : 0;
+        cond &= ~(before ^ lanesOf(stepBefore));
+        cond &= ~(value ^ lanesOf(trig[k - 1].value_));
+        prefix_[k] = prefix_[k - 1] & cond;
+    }
+    uint64_t matched = prefix_[trig.size()];
+
+    // 耦合條件：Sa 看 victim 的值，Sv 看 aggressor 的值
+    if (cfg_->is_twoCell_) {
+        matched &= (cfg_->twoCellFaultType_ == TwoCellFaultType::Sa)
+                       ? ~(vic_ ^ lanesOf(cfg_->VI_))
+                       : ~(aggressorLanes(good) ^ lanesOf(cfg_->AI_));
+    }
+    return matched & valid_;
+}
+
+void WordLaneFault::writeProcess(int addr, uint64_t data) {
+    if (addr != wordAddr_) {
+        mem_->write(addr, data);
+        return;
+    }
+    const uint64_t matched = feed(OpType::W, mem_->read(addr), data);
+    vic_ = (data & ~matched) | (lanesOf(cfg_->faultValue_) & matched);
+    mem_->write(addr, data);
+}
+
+uint64_t WordLaneFault::readProcess(int addr, uint64_t expected) {
+    const uint64_t good = mem_->read(addr);
+    const uint64_t goodDiff = good ^ expected; // fault-free 的 bit 本身就讀錯 (例如未初始化就讀)
+    if (addr != wordAddr_) return goodDiff ? valid_ : 0;
+
+    const uint64_t matched = feed(OpType::R, good, expected);
+    vic_ = (vic_ & ~matched) | (lanesOf(cfg_->faultValue_) & matched);
+    uint64_t laneDiff;
+    if (cfg_->finalReadValue_ < 0) {
+        laneDiff = ((vic_ ^ expected) & ~matched) | matched; // 讀到不確定值，一律視為不一致
+    } else {
+        const uint64_t returned = (vic_ & ~matched) | (lanesOf(cfg_->finalReadValue_) & matched);
+        laneDiff = returned ^ expected;
+    }
+    laneDiff &= valid_;
+
+    // universe j 的 word = fault-free word 只把 bit j 換成 lane j
+    if (goodDiff == 0) return laneDiff;
+    if (goodDiff & (goodDiff - 1)) return valid_;        // 其他 bit 至少一個讀錯
+    return (valid_ & ~goodDiff) | (laneDiff & goodDiff); // 只有一個 bit 讀錯
 }
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "../include/FaultLibrary.hpp"
+
+#include <utility>
+
+FaultLibrary::FaultLibrary() : FaultLibrary(std::vector<FaultConfig>{}) {}
+
+FaultLibrary::FaultLibrary(std::vector<FaultConfig> faults) {
+    auto index = std::make_shared<std::unordered_map<FaultID, std::size_t>>();
+    index->reserve(faults.size());
+    for (std::size_t i = 0; i < faults.size(); ++i) index->emplace(faults[i].id_, i);
+    faults_ = std::make_shared<const std::vector<FaultConfig>>(std::move(faults));
+    index_ = std::move(index);
+}
+
+long FaultLibrary::find(const FaultID& id) const {
+    auto it = index_->find(id);
+    return it == index_->end() ? -1 : static_cast<long>(it->second);
+}
@@ -1,55 +1,662 @@
 # include "../include/FaultSimulator.hpp"
+# include <algorithm>
+# include <atomic>
+# include <bit>
+# include <cmath>
+# include <iostream>
+# include <stdexcept>
+# include <thread>
 
-OneByOneFaultSimulator::OneByOneFaultSimulator(std::vector<FaultConfig>& faultConfigs,
+namespace {
+
+// 依 fault 種類配置位址 (OneByOne / Monte-Carlo 共用)；cells 只有 N-cell fault 使用
+void allocateFor(AddressAllocator& allocator, const FaultConfig& faultConfig,
+                 int& aggressorAddr, int& victimAddr, std::vector<int>& cells) {
+    if (faultConfig.isNCell()) {
+        allocator.allocateNeighborhood(faultConfig, cells);
+        aggressorAddr = -1;
+        victimAddr = cells[NeighborhoodLayout::victimIndex(faultConfig.cellNumber_)];
+    } else if (faultConfig.isDecoder()) {
+        // aggressorAddr 為 partner cell，victimAddr 為故障的位址
+        std::tie(aggressorAddr, victimAddr) = allocator.allocateDecoder(faultConfig);
+    } else if (faultConfig.isLine()) {
+        // victimAddr 為觸發 cell，整條 row / column 在 buildFault() 中由 lineOf() 取得
+        aggressorAddr = -1;
+        victimAddr = allocator.allocateLine(faultConfig);
+    } else {
+        // Allocate addresses for the aggressor and victim cells
+        std::tie(aggressorAddr, victimAddr) = allocator.allocate(faultConfig);
+    }
+}
+
+// 依 fault 種類建立 IFault (位址由 allocateFor 決定)
+std::unique_ptr<IFault> buildFault(const FaultConfig& faultConfig, const std::shared_ptr<MemoryState>& mem,
+                                   const AddressAllocator& allocator, int aggressorAddr, int victimAddr,
+                                   const std::vector<int>& cells, int cols) {
+    auto shared = std::make_shared<const FaultConfig>(faultConfig);
+    if (faultConfig.isNCell())   return FaultFactory::makeNCellFault(shared, mem, cells, cols);
+    if (faultConfig.isDecoder()) return FaultFactory::makeDecoderFault(shared, mem, victimAddr, aggressorAddr);
+    if (faultConfig.isTimed())   return FaultFactory::makeRetentionFault(shared, mem, victimAddr);
+    if (faultConfig.isLine())
+        return FaultFactory::makeLineFault(shared, mem, victimAddr,
+                                           allocator.lineOf(faultConfig.lineScope_, victimAddr));
+    if (faultConfig.is_twoCell_) return FaultFactory::makeTwoCellFault(shared, mem, aggressorAddr, victimAddr);
+    return FaultFactory::makeOneCellFault(shared, mem, victimAddr);
+}
+
+// 不擁有的 shared_ptr (aliasing 建構子，不配置控制區塊)：FaultPool 中的 fault 只在模擬期間使用 cfg
+std::shared_ptr<const FaultConfig> borrow(const FaultConfig& faultConfig) {
+    return std::shared_ptr<const FaultConfig>(std::shared_ptr<const FaultConfig>(), &faultConfig);
+}
+
+// 以 pool 中的 fault 跑一次 March test；回傳 collector 的報告 (下一次模擬前有效)
+const DetectionReport& simulateOnce(const FaultConfig& faultConfig, const std::shared_ptr<MemoryState>& mem,
+                  const AddressAllocator& allocator, FaultPool& pool, OneByOneResultCollector& collector,
+                  const MarchProgram& program, int aggressorAddr, int victimAddr,
+                  const std::vector<int>& cells, int rows, int cols, bool bothDirections) {
+    // Reset memory state for each fault configuration
+    // (PagedMemoryState 只還原上一個 fault 寫過的 page)
+    mem->reset();
+    collector.reset();
+    const LineRange line = faultConfig.isLine() ? allocator.lineOf(faultConfig.lineScope_, victimAddr)
+                                                : LineRange{ victimAddr, 1, 1 };
+    IFault& fault = pool.acquire(borrow(faultConfig), mem, aggressorAddr, victimAddr, cells, cols, line);
+    SequenceExecutor executor(rows * cols, collector);
+    executor.setBothDirections(bothDirections);
+    executor.execute(program, fault);
+    return collector.report();
+}
+
+// 過濾掉的 fault 共用的結果
+const DetectionReport kUndetected {};
+
+} // namespace
+
+OneByOneFaultSimulator::OneByOneFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+                                               const std::vector<MarchElement>& marchTest,
+                                               int rows, int cols, int seed, ResultStore& results)
+    : OneByOneFaultSimulator(faultConfigs, marchTest, std::make_shared<const MarchProgram>(marchTest, rows, cols),
+                             rows, cols, seed, results) {}
+
+OneByOneFaultSimulator::OneByOneFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
                                                const std::vector<MarchElement>& marchTest,
-                                               int rows, int cols, int seed)
-    : cfg_(faultConfigs), marchTest_(marchTest), rows_(rows), cols_(cols) {
-    collector_ = std::make_unique<OneByOneResultCollector>();
+                                               std::shared_ptr<const MarchProgram> program,
+                                               int rows, int cols, int seed, ResultStore& results)
+    : cfg_(faultConfigs), marchTest_(marchTest), rows_(rows), cols_(cols),
+      program_(std::move(program)), results_(results), last_(faultConfigs.size()),
+      filter_(marchTest), analytical_(marchTest, rows * cols) {
+    if (results_.faultCount() != cfg_.size())
+        throw std::invalid_argument("ResultStore 的 fault 數與 fault library 不符");
+    if (program_->memorySize() != rows * cols)
+        throw std::invalid_argument("March program 的記憶體大小與模擬器不符");
     addrAllocator_ = std::make_unique<AddressAllocator>(rows, cols, seed);
 }
 
-void OneByOneFaultSimulator::run_0() {
-    mem_ = std::make_shared<DenseMemoryState>(rows_, cols_, 0);
-    for (auto& faultConfig : cfg_) {
-        // Reset memory state for each fault configuration
-        mem_->reset();
-        collector_->reset();
+void OneByOneFaultSimulator::setFaultRange(std::size_t first, std::size_t last) {
+    if (first > last || last > cfg_.size())
+        throw std::invalid_argument("fault 範圍超出 fault library");
+    first_ = first;
+    last_ = last;
+    cursor_ = { 0, first };
+    placed_ = {};
+}
+
+void OneByOneFaultSimulator::restart() {
+    cursor_ = { 0, first_ };
+    placed_ = {};
+}
+
+void OneByOneFaultSimulator::skipTo(const RunCursor& target) {
+    const long long end = target.done(cfg_.size());
+    int aggressorAddr, victimAddr;
+    while (placed_.done(cfg_.size()) < end) {
+        allocateFor(*addrAllocator_, cfg_[placed_.fault], aggressorAddr, victimAddr, cells_);
+        placed_ = placed_.fault + 1 < cfg_.size() ? RunCursor{ placed_.init, placed_.fault + 1 }
+                                                  : RunCursor{ placed_.init + 1, 0 };
+    }
+}
+
+void OneByOneFaultSimulator::runInit(int initValue) {
+    mem_ = MemoryState::create(rows_, cols_, initValue, memoryKind_);
+    // 這個 init 之後的位置：下一個 init 的範圍起點，兩個 init 都做完則結束
+    const RunCursor after = initValue == 0 ? RunCursor{ 1, first_ } : RunCursor{ 2, 0 };
+    const std::size_t begin = cursor_.init == initValue ? cursor_.fault : first_;
+    skipTo({ initValue, begin });
+    for (std::size_t i = begin; i < last_; ++i) {
+        const DetectionReport& report = evaluate(cfg_[i], initValue);
+        placed_ = i + 1 < cfg_.size() ? RunCursor{ initValue, i + 1 } : RunCursor{ initValue + 1, 0 };
+        results_.set(i, initValue, report);
+        if (observer_) observer_(i, initValue, report);
+        if (report.isDetected_) detectedCount_++;
+        cursor_ = i + 1 < last_ ? RunCursor{ initValue, i + 1 } : after;
+        // 範圍結束時先抽掉到下一段之前的 placement，讓回呼看到的亂數狀態與 cursor_ 一致 (檢查點)
+        skipTo(cursor_);
+        if (progress_) progress_(cursor_);
+    }
+    if (begin >= last_) {
+        cursor_ = after;
+        skipTo(cursor_);
+    }
+}
+
+void OneByOneFaultSimulator::resumeAt(const RunCursor& cursor, const std::string& allocatorState) {
+    if (cursor.init < 0 || cursor.init > 2 || (cursor.finished() && cursor.fault != 0)
+        || (!cursor.finished() && (cursor.fault < first_ || cursor.fault > last_)))
+        throw std::invalid_argument("檢查點的進度超出 fault library 的範圍");
+    addrAllocator_->restore(allocatorState);
+    cursor_ = cursor;
+    placed_ = cursor;
+    resumed_ = true;
+    detectedCount_ = 0;
+    for (int init = 0; init < 2; ++init) {
+        const std::size_t end = init < cursor.init ? last_ : init == cursor.init ? cursor.fault : first_;
+        for (std::size_t i = first_; i < end; ++i) detectedCount_ += results_.detected(i, init);
+    }
+}
+
+const DetectionReport& OneByOneFaultSimulator::evaluate(const FaultConfig& faultConfig, int initValue) {
+    int aggressorAddr, victimAddr;
+    allocateFor(*addrAllocator_, faultConfig, aggressorAddr, victimAddr, cells_);
+
+    // 觸發序列不可能出現在此 March test 上 → 直接判定未偵測
+    // (仍先 allocate，讓後續 fault 的位址與未過濾時一致)
+    if (!filter_.canTrigger(faultConfig, initValue)) return kUndetected;
+
+    // 位址平移的 orbit 只針對 1-cell / 2-cell fault 的五段切分成立
+    // (line fault 的 payload 範圍隨 row / column 而變、time-dependent fault 與時間有關，皆不適用)
+    const bool shaped = faultConfig.isNCell() || faultConfig.isDecoder() || faultConfig.isLine()
+                     || faultConfig.isTimed();
+    // 解析式引擎與 orbit 都假設 ⇕ 以遞增執行，兩個方向都評估時一律模擬
+    const bool forked = bothDirections_ && program_->hasBoth();
+    SymmetryReducer* symmetry = (shaped || forked) ? nullptr : symmetry_.get();
+    SymmetryReducer::OrbitKey orbit;
+    if (symmetry) {
+        orbit = symmetry->orbitKey(faultConfig, initValue, aggressorAddr, victimAddr);
+        if (symmetry->derive(orbit, aggressorAddr, victimAddr, derived_)) return derived_;
+    }
+
+    const DetectionReport* report;
+    if (analyticalMode_ != AnalyticalMode::Off && !forked && analytical_.supports(faultConfig)) {
+        analytical_.evaluate(faultConfig, initValue, aggressorAddr, victimAddr, analyticalResult_);
+        const DetectionReport& fast = analyticalResult_.report;
+        // ResultStore 只保存 syndrome；victim 位址只有 observer、對稱性換算與 cross-check 會用到，需要時才展開
+        if (observer_ || symmetry || analyticalMode_ == AnalyticalMode::CrossCheck)
+            analyticalResult_.expandAddresses();
+        if (analyticalMode_ == AnalyticalMode::FastPath) {
+            report = &fast;
+        } else {
+            report = &simulate(faultConfig, aggressorAddr, victimAddr, cells_);
+            if (!(fast == *report)) {
+                ++crossCheckMismatches_;
+                std::cerr << "Cross-check mismatch: " << faultConfig.id_.faultName_
+                          << " subcase " << faultConfig.id_.subcaseIdx_
+                          << " init " << initValue << "\n";
+            }
+        }
+    } else {
+        report = &simulate(faultConfig, aggressorAddr, victimAddr, cells_);
+    }
+    if (symmetry) symmetry->record(orbit, aggressorAddr, victimAddr, *report);
+    return *report;
+}
+
+const DetectionReport& OneByOneFaultSimulator::simulate(const FaultConfig& faultConfig, int aggressorAddr,
+                                                        int victimAddr, const std::vector<int>& cells) {
+    return simulateOnce(faultConfig, mem_, *addrAllocator_, pool_, collector_, *program_,
+                        aggressorAddr, victimAddr, cells, rows_, cols_, bothDirections_);
+}
+
+// === SingleFaultSimulator ===
+SingleFaultSimulator::SingleFaultSimulator(const std::vector<MarchElement>& marchTest, int rows, int cols,
+                                           uint64_t seed, MemoryKind kind)
+    : SingleFaultSimulator(marchTest, std::make_shared<const MarchProgram>(marchTest, rows, cols),
+                           rows, cols, seed, kind) {}
+
+SingleFaultSimulator::SingleFaultSimulator(const std::vector<MarchElement>& marchTest,
+                                           std::shared_ptr<const MarchProgram> program, int rows, int cols,
+                                           uint64_t seed, MemoryKind kind)
+    : rows_(rows), cols_(cols), rng_(seed), program_(std::move(program)),
+      mem_{ MemoryState::create(rows, cols, 0, kind), MemoryState::create(rows, cols, 1, kind) },
+      allocator_(rows, cols, 0), filter_(marchTest) {
+    if (program_->memorySize() != rows * cols)
+        throw std::invalid_argument("March program 的記憶體大小與模擬器不符");
+}
+
+void SingleFaultSimulator::run(const FaultConfig& cfg, uint64_t seq) {
+    allocator_.reseed(static_cast<unsigned int>(rng_.bits(seq, 0)));
+    for (int initValue = 0; initValue < 2; ++initValue) {
+        DetectionReport& report = reports_[initValue];
         int aggressorAddr, victimAddr;
-        // Allocate addresses for the aggressor and victim cells
-        std::tie(aggressorAddr, victimAddr) = addrAllocator_->allocate(faultConfig);
+        allocateFor(allocator_, cfg, aggressorAddr, victimAddr, cells_);
+        if (!filter_.canTrigger(cfg, initValue)) {
+            report = DetectionReport();
+            continue;
+        }
+        report = simulateOnce(cfg, mem_[initValue], allocator_, pool_, collector_, *program_,
+                              aggressorAddr, victimAddr, cells_, rows_, cols_, bothDirections_);
+    }
+}
 
-        // Execute the March test sequence
-        auto fault = faultConfig.is_twoCell_ ?
-            FaultFactory::makeTwoCellFault(std::make_shared<const FaultConfig>(faultConfig), mem_, aggressorAddr, victimAddr) :
-            FaultFactory::makeOneCellFault(std::make_shared<const FaultConfig>(faultConfig), mem_, victimAddr);
-        SequenceExecutor executor(rows_ * cols_, *collector_);
-        executor.execute(marchTest_, *fault);
-        faultConfig.init0_healthReport_ = collector_->getReport();
-        if (faultConfig.init0_healthReport_.isDetected_) {
-            detectedCount_++;
+// === SpatialFaultSimulator ===
+SpatialFaultSimulator::SpatialFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+                                             const std::vector<MarchElement>& marchTest,
+                                             int rows, int cols, ResultStore& results)
+    : cfg_(faultConfigs), marchTest_(marchTest), rows_(rows), cols_(cols),
+      program_(marchTest, rows, cols), results_(results), planner_(rows, cols), filter_(marchTest) {
+    if (results_.faultCount() != cfg_.size())
+        throw std::invalid_argument("ResultStore 的 fault 數與 fault library 不符");
+}
+
+void SpatialFaultSimulator::store(std::size_t fault, int initValue, const DetectionReport& report) {
+    results_.set(fault, initValue, report);
+    if (observer_) observer_(fault, initValue, report);
+    if (report.isDetected_) detectedCount_++;
+}
+
+void SpatialFaultSimulator::runInit(int initValue) {
+    mem_ = MemoryState::create(rows_, cols_, initValue, memoryKind_);
+    overlay_ = std::make_unique<FaultOverlay>(mem_, rows_ * cols_);
+    planner_.clear();
+    std::vector<std::size_t> batch;
+
+    for (std::size_t i = 0; i < cfg_.size(); ++i) {
+        const FaultConfig& faultConfig = cfg_[i];
+        if (!filter_.canTrigger(faultConfig, initValue)) {
+            store(i, initValue, DetectionReport());
+            continue;
+        }
+        if (faultConfig.isNCell()) {
+            auto cells = planner_.placeNeighborhood(faultConfig);
+            if (cells.empty()) {
+                flushBatch(initValue, batch);
+                cells = planner_.placeNeighborhood(faultConfig);
+                if (cells.empty())
+                    throw std::runtime_error("SpatialFaultSimulator: 記憶體太小，無法放入 N-cell 鄰域");
+            }
+            overlay_->add(FaultFactory::makeNCellFault(std::make_shared<const FaultConfig>(faultConfig),
+                                                       mem_, cells, cols_), cells);
+            batch.push_back(i);
+            continue;
+        }
+        if (faultConfig.isLine()) {
+            int trigAddr = planner_.placeLine(faultConfig);
+            if (trigAddr < 0) {
+                flushBatch(initValue, batch);
+                trigAddr = planner_.placeLine(faultConfig);
+                if (trigAddr < 0)
+                    throw std::runtime_error("SpatialFaultSimulator: 記憶體太小，無法放入 line fault");
+            }
+            // 整條線都屬於此 fault，線上任何 cell 讀錯都算偵測到
+            const LineRange line = planner_.lineOf(faultConfig.lineScope_, trigAddr);
+            std::vector<int> owned;
+            for (int k = 0; k < line.count; ++k) owned.push_back(line.first + k * line.stride);
+            overlay_->add(FaultFactory::makeLineFault(std::make_shared<const FaultConfig>(faultConfig),
+                                                      mem_, trigAddr, line), owned);
+            batch.push_back(i);
+            continue;
+        }
+        auto placement = planner_.place(faultConfig);
+        if (placement.second < 0) {
+            // 記憶體已滿：先把目前這批跑完，再從空的記憶體重新安排
+            flushBatch(initValue, batch);
+            placement = planner_.place(faultConfig);
+            if (placement.second < 0)
+                throw std::runtime_error("SpatialFaultSimulator: 記憶體太小，無法放入任何 fault");
         }
+        auto shared = std::make_shared<const FaultConfig>(faultConfig);
+        if (faultConfig.isDecoder()) {
+            std::vector<int> owned = { placement.second };
+            if (placement.first >= 0) owned.push_back(placement.first);
+            overlay_->add(FaultFactory::makeDecoderFault(shared, mem_, placement.second, placement.first), owned);
+        } else if (faultConfig.isTimed()) {
+            overlay_->add(FaultFactory::makeRetentionFault(shared, mem_, placement.second), { placement.second });
+        } else if (faultConfig.is_twoCell_) {
+            overlay_->add(FaultFactory::makeTwoCellFault(shared, mem_, placement.first, placement.second),
+                          { placement.first, placement.second });
+        } else {
+            overlay_->add(FaultFactory::makeOneCellFault(shared, mem_, placement.second),
+                          { placement.second });
+        }
+        batch.push_back(i);
     }
+    flushBatch(initValue, batch);
 }
 
-void OneByOneFaultSimulator::run_1() {
-    mem_ = std::make_shared<DenseMemoryState>(rows_, cols_, 1);
-    for (auto& faultConfig : cfg_) {
-        // Reset memory state for each fault configuration
+void SpatialFaultSimulator::flushBatch(int initValue, std::vector<std::size_t>& batch) {
+    if (!batch.empty()) {
         mem_->reset();
-        collector_->reset();
-        int aggressorAddr, victimAddr;
-        // Allocate addresses for the aggressor and victim cells
-        std::tie(aggressorAddr, victimAddr) = addrAllocator_->allocate(faultConfig);
+        SpatialResultCollector collector(*overlay_);
+        collector.reset();
+        SequenceExecutor executor(rows_ * cols_, collector);
+        executor.execute(program_, *overlay_);
+        ++batchCount_;
+
+        for (std::size_t k = 0; k < batch.size(); ++k)
+            store(batch[k], initValue, collector.reportOf(static_cast<int>(k)));
+    }
+    batch.clear();
+    overlay_->clear();
+    planner_.clear();
+}
+
+// === LinkedFaultSimulator ===
+LinkedFaultSimulator::LinkedFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+                                           const std::vector<MarchElement>& marchTest,
+                                           int rows, int cols, int order, int threads)
+    : cfg_(faultConfigs), marchTest_(marchTest), rows_(rows), cols_(cols),
+      order_(order), threads_(threads), program_(marchTest, rows, cols), filter_(marchTest) {
+    if (order != 2 && order != 3)
+        throw std::invalid_argument("linked fault 只支援 2 或 3 個 fault 的組合");
+    if (rows < 3 || cols < 3)
+        throw std::invalid_argument("linked fault 模擬需要至少 3x3 的記憶體");
+    if (threads_ <= 0)
+        threads_ = std::max(1u, std::thread::hardware_concurrency());
+}
+
+bool LinkedFaultSimulator::mayInteract(const FaultConfig& a, const FaultConfig& b) {
+    if (a.faultValue_ < 0 || b.faultValue_ < 0 || a.faultValue_ == b.faultValue_) return false;
+    return a.faultValue_ == b.VI_ || b.faultValue_ == a.VI_;
+}
+
+void LinkedFaultSimulator::enumerate() {
+    const int n = static_cast<int>(cfg_.size());
+    reports_.clear();
+
+    // 在此 March test 上根本不會觸發的 fault 不可能遮蔽或被遮蔽
+    std::vector<int> live;
+    // N-cell fault 需要整個鄰域、decoder fault 沒有 victim cell、line fault 的 victim 是整條線、
+    // time-dependent fault 沒有觸發序列，皆不參與共用 victim 的組合
+    for (int i = 0; i < n; ++i) {
+        if (cfg_[i].isNCell() || cfg_[i].isDecoder() || cfg_[i].isLine() || cfg_[i].isTimed()) continue;
+        if (filter_.canTrigger(cfg_[i], 0) || filter_.canTrigger(cfg_[i], 1)) live.push_back(i);
+    }
+
+    // adj[i]：與 i 可能互相影響、且索引較大的 fault
+    std::vector<std::vector<int>> adj(n);
+    for (std::size_t x = 0; x < live.size(); ++x) {
+        for (std::size_t y = x + 1; y < live.size(); ++y) {
+            if (mayInteract(cfg_[live[x]], cfg_[live[y]])) adj[live[x]].push_back(live[y]);
+        }
+    }
+    auto linked = [&](int a, int b) {
+        if (a > b) std::swap(a, b);
+        return std::binary_search(adj[a].begin(), adj[a].end(), b);
+    };
+
+    const long long nn = n;
+    if (order_ == 2) {
+        candidates_ = nn * (nn - 1) / 2;
+        for (int i : live) {
+            for (int j : adj[i]) {
+                LinkedDetectionReport r;
+                r.members_ = { i, j };
+                reports_.push_back(std::move(r));
+            }
+        }
+        return;
+    }
+
+    // triple：三個 fault 之間至少要有兩條互動關係才會相連
+    candidates_ = nn * (nn - 1) * (nn - 2) / 6;
+    std::vector<std::vector<int>> nbr(n);
+    for (int i : live) {
+        for (int j : adj[i]) { nbr[i].push_back(j); nbr[j].push_back(i); }
+    }
+    for (int c : live) {
+        std::sort(nbr[c].begin(), nbr[c].end());
+        for (std::size_t x = 0; x < nbr[c].size(); ++x) {
+            for (std::size_t y = x + 1; y < nbr[c].size(); ++y) {
+                const int a = nbr[c][x], b = nbr[c][y];
+                // 三條邊都存在時會被三個中心各產生一次，只保留最小的中心
+                if (linked(a, b) && std::min(a, b) < c) continue;
+                std::vector<int> members = { a, b, c };
+                std::sort(members.begin(), members.end());
+                LinkedDetectionReport r;
+                r.members_ = std::move(members);
+                reports_.push_back(std::move(r));
+            }
+        }
+    }
+}
+
+std::vector<std::pair<int,int>> LinkedFaultSimulator::placements(const std::vector<int>& members) const {
+    const int vic = (rows_ / 2) * cols_ + cols_ / 2;
+    const int lower[3]  = { vic - 1, vic - cols_, vic - cols_ - 1 };
+    const int higher[3] = { vic + 1, vic + cols_, vic + cols_ + 1 };
+    int usedLower = 0, usedHigher = 0;
+    std::vector<std::pair<int,int>> slots;
+    for (int m : members) {
+        const FaultConfig& cfg = cfg_[m];
+        if (!cfg.is_twoCell_) {
+            slots.push_back({ -1, vic });
+        } else if (cfg.is_A_less_than_V_) {
+            slots.push_back({ lower[usedLower++ % 3], vic });
+        } else {
+            slots.push_back({ higher[usedHigher++ % 3], vic });
+        }
+    }
+    return slots;
+}
+
+bool LinkedFaultSimulator::detectedWith(const std::vector<int>& members,
+                                        const std::vector<std::pair<int,int>>& slots,
+                                        std::size_t only, int initValue,
+                                        OneByOneResultCollector& collector) const {
+    auto mem = MemoryState::create(rows_, cols_, initValue);
+    std::vector<std::unique_ptr<IFault>> faults;
+    for (std::size_t k = 0; k < members.size(); ++k) {
+        if (only < members.size() && k != only) continue;
+        auto shared = std::make_shared<const FaultConfig>(cfg_[members[k]]);
+        faults.push_back(cfg_[members[k]].is_twoCell_
+            ? FaultFactory::makeTwoCellFault(shared, mem, slots[k].first, slots[k].second)
+            : FaultFactory::makeOneCellFault(shared, mem, slots[k].second));
+    }
+    LinkedFault linked(mem, std::move(faults));
+    collector.reset();
+    SequenceExecutor executor(rows_ * cols_, collector);
+    executor.execute(program_, linked);
+    return collector.report().isDetected_;
+}
+
+void LinkedFaultSimulator::evaluate(LinkedDetectionReport& report,
+                                    OneByOneResultCollector& collector) const {
+    const auto slots = placements(report.members_);
+    for (int init = 0; init < 2; ++init) {
+        report.detected_[init] = detectedWith(report.members_, slots, report.members_.size(), init, collector);
+        bool aloneDetected = false;
+        for (std::size_t k = 0; k < report.members_.size() && !aloneDetected; ++k) {
+            aloneDetected = detectedWith(report.members_, slots, k, init, collector);
+        }
+        report.masked_[init] = aloneDetected && !report.detected_[init];
+    }
+}
+
+void LinkedFaultSimulator::run() {
+    enumerate();
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        OneByOneResultCollector collector;
+        for (std::size_t i = next++; i < reports_.size(); i = next++) {
+            evaluate(reports_[i], collector);
+        }
+    };
+    const int n = std::min<int>(threads_, std::max<std::size_t>(1, reports_.size()));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < n; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
 
-        // Execute the March test sequence
-        auto fault = faultConfig.is_twoCell_ ?
-            FaultFactory::makeTwoCellFault(std::make_shared<const FaultConfig>(faultConfig), mem_, aggressorAddr, victimAddr) :
-            FaultFactory::makeOneCellFault(std::make_shared<const FaultConfig>(faultConfig), mem_, victimAddr);
-        SequenceExecutor executor(rows_ * cols_, *collector_);
-        executor.execute(marchTest_, *fault);
-        faultConfig.init1_healthReport_ = collector_->getReport();
-        if (faultConfig.init1_healthReport_.isDetected_) {
-            detectedCount_++;
+double LinkedFaultSimulator::getDetectedRate() {
+    if (reports_.empty()) return 0.0;
+    long long detected = 0;
+    for (const auto& r : reports_) detected += r.detected_[0] + r.detected_[1];
+    return static_cast<double>(detected) / (2.0 * reports_.size());
+}
+
+// === WordFaultSimulator ===
+WordFaultSimulator::WordFaultSimulator(const std::vector<FaultConfig>& faultConfigs,
+                                       const std::vector<MarchElement>& marchTest,
+                                       int rows, int cols, int width,
+                                       std::vector<DataBackground> backgrounds)
+    : cfg_(faultConfigs), marchTest_(marchTest), backgrounds_(std::move(backgrounds)) {
+    if (width < 1 || width > 64)
+        throw std::invalid_argument("word width 必須介於 1 到 64");
+    for (const auto& elem : marchTest)
+        if (!elem.order_.linear())
+            throw std::invalid_argument("word-oriented 模擬只支援 linear 位址順序");
+    mem_ = std::make_shared<WordMemoryState>(rows, cols, width);
+}
+
+void WordFaultSimulator::run() {
+    reports_.assign(cfg_.size(), WordDetectionReport());
+    WordResultCollector collector;
+    WordSequenceExecutor executor(*mem_, collector);
+    const int faultAddr = mem_->size() / 2;
+
+    for (std::size_t i = 0; i < cfg_.size(); ++i) {
+        // N-cell fault 的鄰域是二維的、decoder fault 作用在整個 word 的位址上、
+        // line fault 跨越多個 word，word 內的 bit lane 無法表示；word 模式沒有模擬時鐘，
+        // time-dependent fault 也不列入 (validLanes_ 為 0)
+        if (cfg_[i].isNCell() || cfg_[i].isDecoder() || cfg_[i].isLine() || cfg_[i].isTimed()) continue;
+        WordLaneFault fault(std::make_shared<const FaultConfig>(cfg_[i]), mem_, faultAddr);
+        WordDetectionReport& report = reports_[i];
+        report.validLanes_ = fault.validLanes();
+        for (int init = 0; init < 2; ++init) {
+            report.detected_[init].clear();
+            for (DataBackground bg : backgrounds_) {
+                mem_->fill(bg, init == 1);
+                fault.reload();
+                collector.reset();
+                executor.execute(marchTest_, fault);
+                report.detected_[init].push_back(collector.detectedLanes() & report.validLanes_);
+            }
         }
     }
-}
\ No newline at end of file
+}
+
+double WordFaultSimulator::getDetectedRate() {
+    long long detected = 0, total = 0;
+    for (const auto& report : reports_) {
+        total += 2 * std::popcount(report.validLanes_);
+        detected += std::popcount(report.detectedLanes(0)) + std::popcount(report.detectedLanes(1));
+    }
+    return total == 0 ? 0.0 : static_cast<double>(detected) / total;
+}
+
+// === MonteCarloSimulator ===
+struct MonteCarloSimulator::Worker {
+    Worker(int rows, int cols, MemoryKind kind)
+        : mem(MemoryState::create(rows, cols, 0, kind)), allocator(rows, cols, 0) {}
+    std::shared_ptr<MemoryState> mem;
+    AddressAllocator allocator;
+    OneByOneResultCollector collector;
+};
+
+MonteCarloSimulator::MonteCarloSimulator(const std::vector<FaultConfig>& faultConfigs,
+                                         const std::vector<MarchElement>& marchTest,
+                                         int rows, int cols, MonteCarloOptions options)
+    : cfg_(faultConfigs), marchTest_(marchTest), rows_(rows), cols_(cols),
+      program_(marchTest, rows, cols), opt_(options), rng_(options.seed), z_(zScore(options.confidence)) {
+    if (opt_.maxSamples < 1 || opt_.minSamples < 1)
+        throw std::invalid_argument("Monte-Carlo 樣本數必須至少為 1");
+    if (opt_.tolerance <= 0.0)
+        throw std::invalid_argument("Monte-Carlo 容許誤差必須大於 0");
+    if (opt_.activation < 0.0 || opt_.activation > 1.0)
+        throw std::invalid_argument("觸發機率必須介於 0 到 1");
+    if (opt_.threads <= 0)
+        opt_.threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+double MonteCarloSimulator::zScore(double confidence) {
+    if (confidence <= 0.0 || confidence >= 1.0)
+        throw std::invalid_argument("信賴水準必須介於 0 到 1");
+    // 解 erfc(z / sqrt(2)) = 1 - confidence (二分法，erfc 單調遞減)
+    double lo = 0.0, hi = 40.0;
+    for (int it = 0; it < 100; ++it) {
+        const double mid = 0.5 * (lo + hi);
+        if (std::erfc(mid / std::sqrt(2.0)) > 1.0 - confidence) lo = mid;
+        else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+std::pair<double, double> MonteCarloSimulator::wilson(long long k, long long n, double z) {
+    if (n <= 0) return { 0.0, 1.0 };
+    const double p = static_cast<double>(k) / n;
+    const double z2n = z * z / n;
+    const double center = (p + z2n / 2) / (1 + z2n);
+    const double half = z * std::sqrt(p * (1 - p) / n + z2n / (4.0 * n)) / (1 + z2n);
+    // k = 0 / k = n 時理論上恰為 0 / 1，避免捨入誤差讓區間不含 p
+    return { std::clamp(center - half, 0.0, p), std::clamp(center + half, p, 1.0) };
+}
+
+bool MonteCarloSimulator::sample(std::size_t i, uint64_t s, Worker& worker) const {
+    const FaultConfig& faultConfig = cfg_[i];
+    // stream = fault 編號；counter 的高 32 bit = sample 編號，
+    // 前半段給擺放與 power-up 內容，後半段 (bit 31) 給機率性觸發
+    CounterRngStream rng(rng_, i, s << 32);
+    worker.allocator.reseed(static_cast<unsigned int>(rng()));
+    int aggressorAddr, victimAddr;
+    std::vector<int> cells;
+    allocateFor(worker.allocator, faultConfig, aggressorAddr, victimAddr, cells);
+
+    // 隨機 power-up 內容：每 64 個 cell 取一次亂數
+    MemoryState& mem = *worker.mem;
+    mem.reset();
+    const int size = rows_ * cols_;
+    for (int base = 0; base < size; base += 64) {
+        const uint64_t bits = rng();
+        for (int k = 0; k < 64 && base + k < size; ++k) mem.write(base + k, static_cast<int>((bits >> k) & 1));
+    }
+
+    auto fault = buildFault(faultConfig, worker.mem, worker.allocator, aggressorAddr, victimAddr, cells, cols_);
+    // 機率性觸發只適用於以 sense / inject 分解的 1-cell / 2-cell 序列觸發型 fault
+    const bool sequenceFault = !faultConfig.isNCell() && !faultConfig.isDecoder()
+                            && !faultConfig.isLine() && !faultConfig.isTimed();
+    if (opt_.activation < 1.0 && sequenceFault) {
+        fault = std::make_unique<ProbabilisticFault>(worker.mem, std::move(fault), opt_.activation,
+                                                     CounterRngStream(rng_, i, (s << 32) | (1ULL << 31)));
+    }
+    worker.collector.reset();
+    SequenceExecutor executor(size, worker.collector);
+    executor.execute(program_, *fault);
+    return worker.collector.report().isDetected_;
+}
+
+void MonteCarloSimulator::estimate(std::size_t i, Worker& worker) {
+    MonteCarloReport& report = reports_[i];
+    report = MonteCarloReport();
+    for (uint64_t s = 0; s < static_cast<uint64_t>(opt_.maxSamples); ++s) {
+        report.detected_ += sample(i, s, worker);
+        ++report.samples_;
+        if (report.samples_ < opt_.minSamples) continue;
+        std::tie(report.lo_, report.hi_) = wilson(report.detected_, report.samples_, z_);
+        if ((report.hi_ - report.lo_) / 2 <= opt_.tolerance) {
+            report.converged_ = true;
+            return;
+        }
+    }
+    std::tie(report.lo_, report.hi_) = wilson(report.detected_, report.samples_, z_);
+}
+
+void MonteCarloSimulator::run() {
+    reports_.assign(cfg_.size(), MonteCarloReport());
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        Worker w(rows_, cols_, memoryKind_);
+        for (std::size_t i = next++; i < cfg_.size(); i = next++) estimate(i, w);
+    };
+    const int n = std::min<int>(opt_.threads, std::max<std::size_t>(1, cfg_.size()));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < n; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+double MonteCarloSimulator::getDetectedRate() {
+    if (reports_.empty()) return 0.0;
+    double sum = 0.0;
+    for (const auto& r : reports_) sum += r.estimate();
+    return sum / reports_.size();
+}
@@ -0,0 +1,43 @@
+#include "../include/MarchLibrary.hpp"
+
+namespace {
+
+bool sameAs(const StaticMarch& m, const std::vector<MarchElement>& marchTest) {
+    if (static_cast<int>(marchTest.size()) != m.elementCount) return false;
+    for (int e = 0; e < m.elementCount; ++e) {
+        const StaticElement& se = m.elems[e];
+        const MarchElement& elem = marchTest[e];
+        if (elem.addrOrder_ != se.dir || !elem.order_.linear()) return false;
+        if (static_cast<int>(elem.ops_.size()) != se.end - se.begin) return false;
+        for (int i = se.begin; i < se.end; ++i) {
+            const StaticOp& so = m.ops[i];
+            const PositionedOp& po = elem.ops_[i - se.begin];
+            if (po.op_.type_ != so.type || po.op_.value_ != so.value || po.op_.repeat_ != so.repeat) return false;
+            if (!(po.idx_ == MarchIdx(e, so.opIdx, i))) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int MarchLibrary::match(const std::vector<MarchElement>& marchTest) {
+    for (int i = 0; i < kCount; ++i)
+        if (sameAs(kTests[i].march, marchTest)) return i;
+    return -1;
+}
+
+std::vector<MarchElement> MarchLibrary::toElements(const StaticMarch& march) {
+    std::vector<MarchElement> result(march.elementCount);
+    for (int e = 0; e < march.elementCount; ++e) {
+        const StaticElement& se = march.elems[e];
+        MarchElement& elem = result[e];
+        elem.elemIdx_ = e;
+        elem.addrOrder_ = se.dir;
+        for (int i = se.begin; i < se.end; ++i) {
+            const StaticOp& so = march.ops[i];
+            elem.ops_.push_back({ SingleOp(so.type, so.value, so.repeat), MarchIdx(e, so.opIdx, i) });
+        }
+    }
+    return result;
+}
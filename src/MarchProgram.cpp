@@ -0,0 +1,53 @@
+#include "../include/MarchProgram.hpp"
+#include "../include/MarchLibrary.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+MarchProgram::MarchProgram(const std::vector<MarchElement>& marchTest, int rows, int cols)
+    : memorySize_(rows * cols) {
+    if (rows < 0 || cols < 0) throw std::invalid_argument("MarchProgram: 記憶體大小不可為負");
+    const int memorySize = memorySize_;
+    std::vector<AddressOrder> orders; // 與 sequences_ 對應
+    for (const auto& elem : marchTest) {
+        bool pause = !elem.ops_.empty();
+        for (const auto& pop : elem.ops_) {
+            const SingleOp& op = pop.op_;
+            Kind kind = Idle;
+            if (op.type_ == OpType::R)        kind = Read;
+            else if (op.type_ == OpType::W)   kind = Write;
+            else if (op.type_ == OpType::DEL) kind = Delay;
+            if (kind != Delay) pause = false;
+
+            kind_.push_back(kind);
+            value_.push_back(op.value_);
+            repeat_.push_back(op.repeat_);
+            bit_.push_back(-1);
+            delay_.push_back(kind == Delay ? op.value_ * kNsPerMs : 0);
+            op_.push_back(op);
+            idx_.push_back(pop.idx_);
+            if (kind == Read) readOp_.push_back(opCount() - 1);
+        }
+        elemOpBegin_.push_back(opCount());
+        elemPause_.push_back(pause);
+        // Direction::BOTH 以遞增順序執行 (見 both())
+        elemBoth_.push_back(elem.addrOrder_ == Direction::BOTH && !pause);
+        const bool desc = elem.addrOrder_ == Direction::DESC;
+        elemFirst_.push_back(desc ? memorySize - 1 : 0);
+        elemStep_.push_back(desc ? -1 : 1);
+        int seq = -1;
+        if (!elem.order_.linear() && memorySize > 0) {
+            seq = static_cast<int>(std::find(orders.begin(), orders.end(), elem.order_) - orders.begin());
+            if (seq == static_cast<int>(orders.size())) {
+                orders.push_back(elem.order_);
+                sequences_.push_back(AddressOrderRegistry::generate(elem.order_, rows, cols));
+            }
+        }
+        elemSeq_.push_back(seq);
+    }
+    // syndrome 的 bit 順序與 DiagnosticDictionary / 報告相同：依 overallIdx 排序
+    std::stable_sort(readOp_.begin(), readOp_.end(),
+                     [&](int a, int b) { return idx_[a].overallIdx < idx_[b].overallIdx; });
+    for (int b = 0; b < readCount(); ++b) bit_[readOp_[b]] = b;
+    builtin_ = MarchLibrary::match(marchTest);
+}
@@ -12,4 +12,127 @@ int DenseMemoryState::read(int address) const {
         return defaultValue_;
     }
     return data_[address];
-}
\ No newline at end of file
+}
+
+void DenseMemoryState::fillLine(const LineRange& line, int value) {
+    if (line.count <= 0) return;
+    const long long last = line.first + static_cast<long long>(line.count - 1) * line.stride;
+    if (line.first < 0 || last >= static_cast<long long>(data_.size())) {
+        MemoryState::fillLine(line, value); // 超出範圍的部分逐一略過
+        return;
+    }
+    if (line.stride == 1) {
+        std::fill_n(data_.begin() + line.first, line.count, value);
+        return;
+    }
+    for (int i = 0, addr = line.first; i < line.count; ++i, addr += line.stride) data_[addr] = value;
+}
+
+void DenseMemoryState::restore(const MemoryState& other) {
+    if (const auto* dense = dynamic_cast<const DenseMemoryState*>(&other)) {
+        data_ = dense->data_;
+        return;
+    }
+    for (int addr = 0; addr < static_cast<int>(data_.size()); ++addr) data_[addr] = other.read(addr);
+}
+
+bool DenseMemoryState::sameContents(const MemoryState& other) const {
+    if (const auto* dense = dynamic_cast<const DenseMemoryState*>(&other)) return data_ == dense->data_;
+    for (int addr = 0; addr < static_cast<int>(data_.size()); ++addr)
+        if (data_[addr] != other.read(addr)) return false;
+    return true;
+}
+
+// === MemoryState factory ===
+std::shared_ptr<MemoryState> MemoryState::create(int rows, int cols, int defaultValue, MemoryKind kind) {
+    const long long cells = static_cast<long long>(rows) * cols;
+    if (kind == MemoryKind::Paged || (kind == MemoryKind::Auto && cells >= kPagedThreshold)) {
+        return std::make_shared<PagedMemoryState>(rows, cols, defaultValue);
+    }
+    return std::make_shared<DenseMemoryState>(rows, cols, defaultValue);
+}
+
+// === PagedMemoryState ===
+PagedMemoryState::PagedMemoryState(int row, int col, int defaultValue)
+    : MemoryState(defaultValue), size_(row * col),
+      pages_((static_cast<long long>(row) * col + kPageSize - 1) >> kPageBits) {}
+
+std::vector<int>& PagedMemoryState::writablePage(int pageIdx) {
+    auto& page = pages_[pageIdx];
+    if (!page) {
+        if (spare_.empty()) {
+            page = std::make_shared<Page>(kPageSize, defaultValue_);
+        } else {
+            page = std::move(spare_.back());
+            spare_.pop_back();
+            std::fill(page->begin(), page->end(), defaultValue_);
+        }
+        touched_.push_back(pageIdx);
+    } else if (page.use_count() > 1) {
+        page = std::make_shared<Page>(*page); // 與 clone 共用中，先複製再寫
+    }
+    return *page;
+}
+
+void PagedMemoryState::reset() {
+    for (int pageIdx : touched_) {
+        auto& page = pages_[pageIdx];
+        // 只有自己持有的 page 可以留給下次寫入 (與 clone 共用的 page 直接放掉)
+        if (page.use_count() == 1) spare_.push_back(std::move(page));
+        else page.reset();
+    }
+    touched_.clear();
+}
+
+void PagedMemoryState::restore(const MemoryState& other) {
+    reset();
+    if (const auto* paged = dynamic_cast<const PagedMemoryState*>(&other)) {
+        pages_ = paged->pages_;
+        touched_ = paged->touched_;
+        return;
+    }
+    for (int addr = 0; addr < size_; ++addr) {
+        const int value = other.read(addr);
+        if (value != defaultValue_) write(addr, value);
+    }
+}
+
+bool PagedMemoryState::sameContents(const MemoryState& other) const {
+    const auto* paged = dynamic_cast<const PagedMemoryState*>(&other);
+    for (int pageIdx = 0; pageIdx < static_cast<int>(pages_.size()); ++pageIdx) {
+        if (paged && pages_[pageIdx] == paged->pages_[pageIdx]) continue;
+        const int first = pageIdx << kPageBits;
+        const int last = std::min(first + kPageSize, size_);
+        for (int addr = first; addr < last; ++addr)
+            if (read(addr) != other.read(addr)) return false;
+    }
+    return true;
+}
+
+void PagedMemoryState::fillLine(const LineRange& line, int value) {
+    if (line.stride != 1) {
+        MemoryState::fillLine(line, value);
+        return;
+    }
+    int addr = std::max(line.first, 0);
+    const int end = std::min(line.first + line.count, size_);
+    while (addr < end) {
+        const int offset = addr & (kPageSize - 1);
+        const int n = std::min(end - addr, kPageSize - offset);
+        auto& page = writablePage(addr >> kPageBits);
+        std::fill_n(page.begin() + offset, n, value);
+        addr += n;
+    }
+}
+
+// === WordMemoryState ===
+WordMemoryState::WordMemoryState(int rows, int cols, int width)
+    : cols_(cols), width_(width), mask_(wordMask(width)),
+      data_(rows * cols, 0), backgrounds_(rows * cols, 0) {}
+
+void WordMemoryState::fill(DataBackground bg, bool invert) {
+    for (int addr = 0; addr < static_cast<int>(data_.size()); ++addr) {
+        backgrounds_[addr] = backgroundWord(bg, addr / cols_, addr % cols_, width_);
+        data_[addr] = pattern(addr, invert);
+    }
+}
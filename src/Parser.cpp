@@ -1,10 +1,15 @@
 #include "../include/Parser.hpp"
+#include "../include/Neighborhood.hpp"
+#include "../include/BufferedWriter.hpp"
+#include "../include/MarchLibrary.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <sstream>
 #include <stdexcept>
 #include <regex>
+#include <unordered_map>
 
 
 // ─────────────── helper ───────────────────────────────────────────────
@@ -28,8 +33,9 @@ std::vector<SingleOp> Parser::explodeOpToken(const std::string& tok) const
     std::vector<SingleOp> out;
     if (tok == "-" || tok.empty()) return out;
 
-    // 允許任意長度：regex 逐段比對 (大小寫皆可)
-    static const std::regex pat(R"(([A-Z]+)(\d+))", std::regex::icase);
+    // 允許任意長度：regex 逐段比對 (大小寫皆可)；op^N 表示同一 cell 上連續重複 N 次
+    // CO 可以不帶數字 (March-CM24)；Del<N> 為暫停 N ms
+    static const std::regex pat(R"(([A-Z]+)(\d*)(?:\^(\d+))?)", std::regex::icase);
     auto begin = std::sregex_iterator(tok.begin(), tok.end(), pat);
     auto end   = std::sregex_iterator();
 
@@ -38,7 +44,7 @@ std::vector<SingleOp> Parser::explodeOpToken(const std::string& tok) const
 
     for (auto it = begin; it != end; ++it) {
         std::string opStr = it->str(1);
-        int         val   = std::stoi(it->str(2));
+        int         val   = (*it)[2].length() ? std::stoi(it->str(2)) : -1;
 
         OpType type = OpType::UNKNOWN;
         std::string opStrLower = opStr;
@@ -48,11 +54,19 @@ std::vector<SingleOp> Parser::explodeOpToken(const std::string& tok) const
         else if (opStrLower == "w")   type = OpType::W;
         else if (opStrLower == "ci")  type = OpType::CI;
         else if (opStrLower == "co")  type = OpType::CO;
+        else if (opStrLower == "del") type = OpType::DEL;
 
         if (type == OpType::UNKNOWN)
             throw std::runtime_error("不支援的操作碼: " + opStr);
+        if (val < 0 && type != OpType::CO)
+            throw std::runtime_error("操作缺少數值：" + tok);
 
-        out.push_back({type, val});
+        int repeat = 1;
+        if ((*it)[3].matched) {
+            repeat = std::stoi(it->str(3));
+            if (repeat < 1) throw std::runtime_error("重複次數必須至少為 1：" + tok);
+        }
+        out.push_back({type, val, repeat});
     }
     return out;
 }
@@ -68,99 +82,156 @@ std::vector<FaultConfig> Parser::parseFaults(const std::string& filename) const
         throw std::runtime_error("fault.json 根節點應為 array");  // :contentReference[oaicite:3]{index=3}
 
     std::vector<FaultConfig> out;
-
-    for (const auto& jfault : jRoot) {
-        const std::string name       = jfault.at("name").get<std::string>();
-        const int         cellNum    = jfault.at("cell_number").get<int>();
-        const auto&       conditions = jfault.at("conditions");              // array<string>
-
-        for (std::size_t subIdx = 0; subIdx < conditions.size(); ++subIdx) {
-            std::string raw = conditions.at(subIdx).get<std::string>();
-
-            // 去除 '{' , '}', 空白
-            raw.erase(std::remove_if(raw.begin(), raw.end(),
-                       [](unsigned char c){ return std::isspace(c) || c=='{'||c=='}'; }),
-                      raw.end());
-            
-            std::vector<std::string> parts;
-            std::stringstream ss(raw);
-            std::string item;
-            while (std::getline(ss, item, ',')) {
-                item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
-                parts.push_back(item);
-            }
-
-            FaultConfig cfg;
-            cfg.id_.faultName_  = name;
-            cfg.id_.subcaseIdx_ = static_cast<int>(subIdx);
-
-            if (cellNum == 1) {                             // ── 1-cell fault
-                if (parts.size() != 5)
-                    throw std::runtime_error("1-cell 條目必須 5 欄；" + name);
-                cfg.VI_             = toInt(parts[0]);
-                cfg.trigger_        = explodeOpToken(parts[1]);
-                cfg.faultValue_     = toInt(parts[3]);
-                cfg.finalReadValue_ = toInt(parts[4]);
-                cfg.is_twoCell_     = false;
-            }
-            else if (cellNum == 2) {                        // ── 2-cell fault
-                if (parts.size() != 8)
-                    throw std::runtime_error("2-cell 條目必須 8 欄；" + name);
-
-                cfg.is_twoCell_       = true;
-                cfg.is_A_less_than_V_ = (toInt(parts[0]) == 1);
-                cfg.AI_               = toInt(parts[1]);
-                cfg.VI_               = toInt(parts[2]);
-
-                std::string leftT  = parts[3];
-                std::string rightT = parts[4];
-                bool useLeft       = (leftT != "-" && !leftT.empty());
-                cfg.twoCellFaultType_ = useLeft ? TwoCellFaultType::Sa
-                                                : TwoCellFaultType::Sv;
-                cfg.trigger_          = explodeOpToken(useLeft ? leftT : rightT);
-
-                cfg.faultValue_       = toInt(parts[6]);
-                cfg.finalReadValue_   = toInt(parts[7]);
-            } else {
-                throw std::runtime_error("未知 cell_number = " + std::to_string(cellNum));
-            }
-            out.push_back(std::move(cfg));       // 保留 JSON 順序
-        }
-    }
+    for (const auto& jfault : jRoot)
+        parseFaultEntry(jfault, [&](FaultConfig&& cfg) { out.push_back(std::move(cfg)); }); // 保留 JSON 順序
     return out;
 }
 
-// ─────────────── parseMarchTest ───────────────────────────────────────
-std::vector<MarchElement>
-Parser::parseMarchTest_menu(const std::string& filename)
+// ─────────────── streamFaults ─────────────────────────────────────────
+// 以 nlohmann 的 parser callback 逐一處理 root array 的元素：
+// 每個 fault 物件解析完就展開成 FaultConfig 交給 emit，並從 DOM 中丟棄，
+// 因此記憶體只與單一 fault 條目有關，與 fault library 的大小無關。
+void Parser::streamFaults(const std::string& filename,
+                          const std::function<void(FaultConfig&&)>& emit) const
 {
     std::ifstream ifs(filename);
     if (!ifs) throw std::runtime_error("無法開啟檔案: " + filename);
 
-    json jf;  ifs >> jf;
-    if (!jf.is_array()) throw std::runtime_error("marchTest.json 根節點必須是 array");
-
-    /* ── ① 列出所有可用 pattern 名稱 ─────────────────── */
-    std::vector<std::string> marchNames;
-    for (const auto& j : jf)
-        marchNames.push_back(j.at("name").get<std::string>());
-
-    std::cout << "Available March patterns:\n";
-    for (std::size_t i = 0; i < marchNames.size(); ++i)
-        std::cout << i + 1 << ". " << marchNames[i] << "\n";
+    json::parser_callback_t onEvent = [&](int depth, json::parse_event_t event, json& parsed) {
+        if (depth == 0 && event == json::parse_event_t::object_start)
+            throw std::runtime_error("fault.json 根節點應為 array");
+        if (depth == 1 && event == json::parse_event_t::object_end) {
+            parseFaultEntry(parsed, emit);
+            return false;
+        }
+        return true;
+    };
+    const json jRoot = json::parse(ifs, onEvent); // 元素都已丟棄，只剩空的 root
+    if (!jRoot.is_array())
+        throw std::runtime_error("fault.json 根節點應為 array");
+}
 
-    std::cout << "Select a March pattern by number: ";
-    std::size_t choice = 0;
-    std::cin  >> choice;
-    if (choice < 1 || choice > marchNames.size())
-        throw std::runtime_error("Invalid selection");
+// 一個 fault 條目 (名稱 + 多個 conditions) → 每個 subcase 一個 FaultConfig
+void Parser::parseFaultEntry(const json& jfault, const std::function<void(FaultConfig&&)>& emit) const
+{
+    const std::string name       = jfault.at("name").get<std::string>();
+    const std::string kind       = jfault.value("kind", std::string("cell"));
+    const LineScope   line       = (kind == "row")    ? LineScope::Row
+                                 : (kind == "column") ? LineScope::Column : LineScope::None;
+    // row / column line fault 沿用 1-cell 的欄位，觸發在線上的一個 cell
+    const int         cellNum    = (kind == "cell") ? jfault.at("cell_number").get<int>()
+                                 : (line != LineScope::None) ? 1 : 0;
+    const auto&       conditions = jfault.at("conditions");              // array<string>
+
+    for (std::size_t subIdx = 0; subIdx < conditions.size(); ++subIdx) {
+        std::string raw = conditions.at(subIdx).get<std::string>();
+
+        // 去除 '{' , '}', 空白
+        raw.erase(std::remove_if(raw.begin(), raw.end(),
+                   [](unsigned char c){ return std::isspace(c) || c=='{'||c=='}'; }),
+                  raw.end());
+        
+        std::vector<std::string> parts;
+        std::stringstream ss(raw);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+            parts.push_back(item);
+        }
 
-    const json& jSel = jf[choice - 1];
-    marchTestName_ = marchNames[choice - 1];
-    std::string pattern = jSel.at("pattern").get<std::string>();
-    /* ───────────────────────────────────────────────────── */
+        FaultConfig cfg;
+        cfg.id_.faultName_  = name;
+        cfg.id_.subcaseIdx_ = static_cast<int>(subIdx);
+
+        if (kind == "decoder") {                        // ── address decoder fault
+            // {no-access | multi-cell | wrong-cell}, {讀值}
+            // no-access 的讀值為浮動值；multi-cell 的 0 / 1 代表 wired-AND / wired-OR
+            if (parts.size() != 2)
+                throw std::runtime_error("decoder 條目必須 2 欄；" + name);
+            cfg.decoderKind_       = parseDecoderFaultKind(parts[0]);
+            cfg.faultValue_        = toInt(parts[1]);
+            cfg.is_twoCell_        = false;
+            cfg.is_A_less_than_V_  = false;
+        }
+        else if (kind == "retention" || kind == "leakage") { // ── time-dependent fault
+            // {保持的值}, {retention time}, {fault value}
+            if (parts.size() != 3)
+                throw std::runtime_error(kind + " 條目必須 3 欄；" + name);
+            cfg.timeKind_          = (kind == "retention") ? TimeFaultKind::Retention
+                                                           : TimeFaultKind::Leakage;
+            cfg.VI_                = toInt(parts[0]);
+            cfg.retentionTime_     = parseSimTime(parts[1]);
+            cfg.faultValue_        = toInt(parts[2]);
+            cfg.is_twoCell_        = false;
+            cfg.is_A_less_than_V_  = false;
+        }
+        else if (kind != "cell" && line == LineScope::None) {
+            throw std::runtime_error("未知 fault kind = " + kind);
+        }
+        else if (cellNum == 1) {                        // ── 1-cell fault
+            if (parts.size() != 5)
+                throw std::runtime_error("1-cell 條目必須 5 欄；" + name);
+            cfg.VI_             = toInt(parts[0]);
+            cfg.trigger_        = explodeOpToken(parts[1]);
+            cfg.faultValue_     = toInt(parts[3]);
+            cfg.finalReadValue_ = toInt(parts[4]);
+            cfg.is_twoCell_     = false;
+            cfg.lineScope_      = line;
+        }
+        else if (cellNum == 2) {                        // ── 2-cell fault
+            if (parts.size() != 8)
+                throw std::runtime_error("2-cell 條目必須 8 欄；" + name);
+
+            cfg.is_twoCell_       = true;
+            cfg.is_A_less_than_V_ = (toInt(parts[0]) == 1);
+            cfg.AI_               = toInt(parts[1]);
+            cfg.VI_               = toInt(parts[2]);
+
+            std::string leftT  = parts[3];
+            std::string rightT = parts[4];
+            bool useLeft       = (leftT != "-" && !leftT.empty());
+            cfg.twoCellFaultType_ = useLeft ? TwoCellFaultType::Sa
+                                            : TwoCellFaultType::Sv;
+            cfg.trigger_          = explodeOpToken(useLeft ? leftT : rightT);
+
+            cfg.faultValue_       = toInt(parts[6]);
+            cfg.finalReadValue_   = toInt(parts[7]);
+        }
+        else if (NeighborhoodLayout::valid(cellNum)) {   // ── N-cell fault (3-cell CF / NPSF)
+            // {鄰域狀態}, {trigger cell}, {trigger 操作}, {fault value}, {final read}
+            // 鄰域狀態依 NeighborhoodLayout 順序，每格為 0 / 1 / -；trigger cell 為 - 時即 victim
+            if (parts.size() != 5)
+                throw std::runtime_error(std::to_string(cellNum) + "-cell 條目必須 5 欄；" + name);
+            if (static_cast<int>(parts[0].size()) != cellNum)
+                throw std::runtime_error("鄰域狀態長度應為 " + std::to_string(cellNum) + "；" + name);
+
+            cfg.cellNumber_ = cellNum;
+            for (char c : parts[0]) cfg.cellStates_.push_back(toInt(std::string(1, c)));
+            const int vic = NeighborhoodLayout::victimIndex(cellNum);
+            cfg.triggerCell_ = (parts[1] == "-") ? vic : std::stoi(parts[1]);
+            if (cfg.triggerCell_ < 0 || cfg.triggerCell_ >= cellNum)
+                throw std::runtime_error("trigger cell 超出鄰域範圍；" + name);
+            if (cfg.cellStates_[cfg.triggerCell_] < 0)
+                throw std::runtime_error("trigger cell 的初始狀態不可為 -；" + name);
+
+            cfg.VI_             = cfg.cellStates_[vic];
+            cfg.trigger_        = explodeOpToken(parts[2]);
+            cfg.faultValue_     = toInt(parts[3]);
+            cfg.finalReadValue_ = toInt(parts[4]);
+            cfg.is_twoCell_     = false;
+            cfg.lineScope_      = line;
+        } else {
+            throw std::runtime_error("未知 cell_number = " + std::to_string(cellNum));
+        }
+        emit(std::move(cfg));
+    }
+}
 
-    /* ── ② 將 pattern 字串拆解成 MarchElement ─────────── */
+// ─────────────── March pattern ────────────────────────────────────────
+// "b(w0);a[gray](r0,w1);..."：方向字元後可選擇以 [name<k>] 指定位址順序 (見 AddressOrder.hpp)，
+// 沒有指定的 element 使用 defaultOrder_
+std::vector<MarchElement> Parser::parsePattern(const std::string& pattern) const
+{
     std::vector<MarchElement> result;
     std::stringstream segSS(pattern);
     std::string seg;
@@ -186,6 +257,18 @@ Parser::parseMarchTest_menu(const std::string& filename)
         if (l == std::string::npos || r == std::string::npos || r <= l + 1)
             throw std::runtime_error("pattern 格式錯誤：" + seg);
 
+        // 位址順序 a[gray](...)
+        AddressOrder order = defaultOrder_;
+        if (l > 1) {
+            if (seg[1] != '[' || seg[l - 1] != ']' || l < 4)
+                throw std::runtime_error("位址順序格式錯誤 (應為 a[name](...))：" + seg);
+            try {
+                order = AddressOrderRegistry::parse(seg.substr(2, l - 3));
+            } catch (const std::invalid_argument& e) {
+                throw std::runtime_error(std::string(e.what()) + "；" + seg);
+            }
+        }
+
         std::string opList = seg.substr(l + 1, r - l - 1);
 
         // 分割成個別 token
@@ -201,6 +284,7 @@ Parser::parseMarchTest_menu(const std::string& filename)
         MarchElement elem;
         elem.elemIdx_   = elemIdx;
         elem.addrOrder_ = dir;
+        elem.order_     = order;
 
         int opLocalIdx = 0;
         for (const auto& tk : tokens) {
@@ -221,99 +305,114 @@ Parser::parseMarchTest_menu(const std::string& filename)
     return result;
 }
 
+// ─────────────── parseMarchTest ───────────────────────────────────────
 std::vector<MarchElement>
-Parser::parseMarchTest(const std::string& filename)
+Parser::parseMarchTest_menu(const std::string& filename)
 {
-    std::ifstream ifs(filename);
-    if (!ifs) throw std::runtime_error("無法開啟檔案: " + filename);
+    /* ── ① 列出所有可用 pattern 名稱 ─────────────────── */
+    const std::vector<std::string> marchNames = marchTestNames(filename);
 
-    json jf;  ifs >> jf;
-    if (!jf.is_object()) throw std::runtime_error("marchTest.json 根節點必須是 object");
-    marchTestName_ = jf.at("name").get<std::string>();
-    std::string pattern = jf.at("pattern").get<std::string>();
+    std::cout << "Available March patterns:\n";
+    for (std::size_t i = 0; i < marchNames.size(); ++i)
+        std::cout << i + 1 << ". " << marchNames[i] << "\n";
+
+    std::cout << "Select a March pattern by number: ";
+    std::size_t choice = 0;
+    std::cin  >> choice;
+    if (choice < 1 || choice > marchNames.size())
+        throw std::runtime_error("Invalid selection");
     /* ───────────────────────────────────────────────────── */
 
-    /* ── ② 將 pattern 字串拆解成 MarchElement ─────────── */
-    std::vector<MarchElement> result;
-    std::stringstream segSS(pattern);
-    std::string seg;
+    return parseMarchTest(filename, marchNames[choice - 1]);
+}
 
-    int elemIdx = 0;
-    int overallIdx = 0;                     // 全域遞增 op 編號
+namespace {
 
-    while (std::getline(segSS, seg, ';')) {
-        // 去空白
-        seg.erase(std::remove_if(seg.begin(), seg.end(), ::isspace), seg.end());
-        if (seg.empty()) continue;
+json loadMarchLibrary(const std::string& filename) {
+    std::ifstream ifs(filename);
+    if (!ifs) throw std::runtime_error("無法開啟檔案: " + filename);
+    json jf;  ifs >> jf;
+    if (!jf.is_array()) throw std::runtime_error("marchTest.json 根節點必須是 array");
+    return jf;
+}
 
-        // 解析 direction 字元 ('b'/'a'/'d') 與括號
-        char dirC = std::tolower(seg[0]);
-        Direction dir;
-        if      (dirC == 'a') dir = Direction::ASC;
-        else if (dirC == 'd') dir = Direction::DESC;
-        else if (dirC == 'b') dir = Direction::BOTH;
-        else throw std::runtime_error("未知 direction: " + seg);
+} // namespace
 
-        auto l = seg.find('(');
-        auto r = seg.find(')', l);
-        if (l == std::string::npos || r == std::string::npos || r <= l + 1)
-            throw std::runtime_error("pattern 格式錯誤：" + seg);
+std::vector<std::string> Parser::marchTestNames(const std::string& filename) const
+{
+    std::vector<std::string> marchNames;
+    for (const auto& j : loadMarchLibrary(filename))
+        marchNames.push_back(j.at("name").get<std::string>());
+    return marchNames;
+}
 
-        std::string opList = seg.substr(l + 1, r - l - 1);
+std::vector<MarchElement>
+Parser::parseMarchTest(const std::string& filename, const std::string& name)
+{
+    for (const auto& j : loadMarchLibrary(filename)) {
+        if (j.at("name").get<std::string>() != name) continue;
+        marchTestName_ = name;
+        return parsePattern(j.at("pattern").get<std::string>());
+    }
+    throw std::runtime_error("March test 庫中找不到 " + name + ": " + filename);
+}
 
-        // 分割成個別 token
-        std::vector<std::string> tokens;
-        std::stringstream tokSS(opList);
-        std::string tok;
-        while (std::getline(tokSS, tok, ',')) {
-            tok.erase(std::remove_if(tok.begin(), tok.end(), ::isspace), tok.end());
-            if (!tok.empty()) tokens.push_back(tok);
-        }
+std::vector<MarchElement>
+Parser::parseMarchPattern(const std::string& pattern)
+{
+    marchTestName_ = pattern;
+    return parsePattern(pattern);
+}
 
-        // 建立 MarchElement
-        MarchElement elem;
-        elem.elemIdx_   = elemIdx;
-        elem.addrOrder_ = dir;
+std::vector<MarchElement>
+Parser::parseMarchTest(const std::string& filename)
+{
+    // "builtin:March C-"：直接取用內建 March test 庫，不讀檔
+    const std::string builtinPrefix = "builtin:";
+    if (filename.rfind(builtinPrefix, 0) == 0) {
+        const std::string name = filename.substr(builtinPrefix.size());
+        const int i = MarchLibrary::find(name);
+        if (i < 0) throw std::runtime_error("找不到內建 March test: " + name);
+        marchTestName_ = name;
+        auto result = MarchLibrary::toElements(MarchLibrary::kTests[i].march);
+        for (auto& elem : result) elem.order_ = defaultOrder_;
+        return result;
+    }
 
-        int opLocalIdx = 0;
-        for (const auto& tk : tokens) {
-            for (SingleOp sop : explodeOpToken(tk)) {
-                
-                PositionedOp po{ sop,
-                                 { elemIdx,
-                                   opLocalIdx,
-                                   overallIdx++ } };
-                elem.ops_.push_back(std::move(po));
-            }
-            ++opLocalIdx;
-        }
+    std::ifstream ifs(filename);
+    if (!ifs) throw std::runtime_error("無法開啟檔案: " + filename);
 
-        result.push_back(std::move(elem));
-        ++elemIdx;
-    }
-    return result;
+    json jf;  ifs >> jf;
+    if (!jf.is_object()) throw std::runtime_error("marchTest.json 根節點必須是 object");
+    marchTestName_ = jf.at("name").get<std::string>();
+    std::string pattern = jf.at("pattern").get<std::string>();
+    /* ───────────────────────────────────────────────────── */
+
+    return parsePattern(pattern);
 }
 
 // ─────────────── writeDetectionReport ─────────────────────────────────
 void Parser::writeDetectionReport(const std::vector<FaultConfig>& faults,
+                                  const ResultStore& results,
                                   double detectedRate,
                                   const std::string& filename) const {
     std::ofstream ofs(filename);
     if (!ofs) throw std::runtime_error("無法開啟輸出檔案: " + filename);
     ofs << "Detected Rate: " << detectedRate * 100 << "%\n\n";
-    for (const auto& fault : faults) {
+    const auto& reads = results.reads();
+    for (std::size_t f = 0; f < faults.size(); ++f) {
+        const FaultConfig& fault = faults[f];
         ofs << fault.id_.faultName_ << "\nSubcase " << fault.id_.subcaseIdx_ << " ";
         ofs << processSFR(fault) << "\n";
-        // init0 健康報告
-        ofs << "Init 0: ";
-        // Output syndrome
-        if (!fault.init0_healthReport_.isDetected_) {
-            ofs << "No detection\n";
-        } else {
-            std::string bits;
-            for (const auto& it : fault.init0_healthReport_.detected_) {
-                bits += (it.second == 1) ? '1' : '0';
+        // init0 / init1 健康報告
+        for (int init = 0; init < 2; ++init) {
+            ofs << "Init " << init << ": ";
+            // Output syndrome
+            if (!results.detected(f, init)) {
+                ofs << "No detection\n";
+                continue;
             }
+            const std::string bits = results.syndrome(f, init).toString();
             ofs << bits << " (";
             // Convert bits string to hex
             if (!bits.empty()) {
@@ -322,52 +421,311 @@ void Parser::writeDetectionReport(const std::vector<FaultConfig>& faults,
             }
             ofs << ")\n";
 
-            for (const auto& it : fault.init0_healthReport_.detected_) {
-                if (it.second) {
-                    ofs << "M" << it.first.marchIdx << "(" << it.first.opIdx << ") ";
+            for (std::size_t i = 0; i < reads.size(); ++i) {
+                if (bits[i] == '1') {
+                    ofs << "M" << reads[i].marchIdx << "(" << reads[i].opIdx << ") ";
                 }
             }
-            ofs << "\n";
+            ofs << (init ? "\n\n" : "\n");
         }
-        // init1 健康報告
-        ofs << "Init 1: ";
-        // Output syndrome
-        if (!fault.init1_healthReport_.isDetected_) {
-            ofs << "No detection\n";
-            continue;
-        } else {
-            std::string bits;
-            for (const auto& it : fault.init1_healthReport_.detected_) {
-                bits += (it.second == 1) ? '1' : '0';
-            }
-            ofs << bits << " (";
-            // Convert bits string to hex
-            if (!bits.empty()) {
-                unsigned long long value = std::stoull(bits, nullptr, 2);
-                ofs << "0x" << std::hex << value << std::dec;
+    }
+}
+
+// ─────────────── 結構化輸出 (CSV / NDJSON / columnar) ─────────────────
+// March test 中所有 read 操作，依 overallIdx 排序；syndrome 的第 i 個 bit 對應第 i 個 read
+std::vector<MarchIdx> Parser::readOps(const std::vector<MarchElement>& marchTest) {
+    std::vector<MarchIdx> reads;
+    for (const auto& elem : marchTest)
+        for (const auto& op : elem.ops_)
+            if (op.op_.type_ == OpType::R) reads.push_back(op.idx_);
+    std::sort(reads.begin(), reads.end());
+    return reads;
+}
+
+namespace {
+
+// syndrome → '0' / '1' 字串 (寫入 bits，沿用其容量)
+void fillSyndrome(const Syndrome& syndrome, std::string& bits) {
+    bits.assign(syndrome.size(), '0');
+    for (int i = 0; i < syndrome.size(); ++i)
+        if (syndrome.test(i)) bits[i] = '1';
+}
+
+// MSB 在前的 bit 字串 → 十六進位 (去掉前導 0，與 text report 的 0x... 相同)
+void toHex(const std::string& bits, std::string& hex) {
+    static const char digits[] = "0123456789abcdef";
+    hex.clear();
+    const std::size_t lead = (4 - bits.size() % 4) % 4;
+    int nibble = 0, count = 0;
+    for (std::size_t k = 0; k < lead + bits.size(); ++k) {
+        nibble = (nibble << 1) | (k >= lead && bits[k - lead] == '1');
+        if (++count == 4) {
+            if (nibble || !hex.empty()) hex += digits[nibble];
+            nibble = count = 0;
+        }
+    }
+    if (hex.empty()) hex = "0";
+}
+
+// CSV 欄位一律加引號，內部的引號重複一次
+void putQuoted(BufferedWriter& out, std::string_view text) {
+    out.put('"');
+    for (char c : text) {
+        if (c == '"') out.put('"');
+        out.put(c);
+    }
+    out.put('"');
+}
+
+// JSON 字串：跳脫引號、反斜線與控制字元
+void putJsonString(BufferedWriter& out, std::string_view text) {
+    static const char digits[] = "0123456789abcdef";
+    out.put('"');
+    for (char c : text) {
+        if (c == '"' || c == '\\') out.put('\\').put(c);
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out.put("\\u00").put(digits[(c >> 4) & 0xF]).put(digits[c & 0xF]);
+        else out.put(c);
+    }
+    out.put('"');
+}
+
+} // namespace
+
+void Parser::writeCsvReport(const std::vector<FaultConfig>& faults,
+                            const ResultStore& results,
+                            const std::string& filename) const {
+    BufferedWriter out(filename);
+    writeCsvHeader(out);
+    for (std::size_t f = 0; f < faults.size(); ++f)
+        writeCsvRows(out, faults[f], results.syndrome(f, 0), results.syndrome(f, 1), results.reads());
+    out.flush();
+}
+
+void Parser::writeCsvHeader(BufferedWriter& out) const {
+    out.put("fault,subcase,sfr,init,detected,syndrome,hex,detect_ops\n");
+}
+
+void Parser::writeCsvRows(BufferedWriter& out, const FaultConfig& fault,
+                          const Syndrome& init0, const Syndrome& init1,
+                          const std::vector<MarchIdx>& reads) const {
+    const std::string sfr = processSFR(fault);
+    std::string bits, hex; // 兩列共用
+    for (int init = 0; init < 2; ++init) {
+        const Syndrome& syndrome = init ? init1 : init0;
+        fillSyndrome(syndrome, bits);
+        toHex(bits, hex);
+        putQuoted(out, fault.id_.faultName_.str());
+        out.put(',').num(fault.id_.subcaseIdx_).put(',');
+        putQuoted(out, sfr);
+        out.put(',').num(init).put(',').num(syndrome.any() ? 1 : 0).put(',');
+        out.put(bits).put(",0x").put(hex).put(',');
+        bool first = true;
+        for (std::size_t i = 0; i < reads.size(); ++i) {
+            if (bits[i] != '1') continue;
+            if (!first) out.put(' ');
+            out.put('M').num(reads[i].marchIdx).put('(').num(reads[i].opIdx).put(')');
+            first = false;
+        }
+        out.put('\n');
+    }
+}
+
+// NDJSON：每列一個物件，欄位與 CSV 相同 (detect_ops 為字串陣列)
+void Parser::writeJsonRows(BufferedWriter& out, const FaultConfig& fault,
+                           const Syndrome& init0, const Syndrome& init1,
+                           const std::vector<MarchIdx>& reads) const {
+    const std::string sfr = processSFR(fault);
+    std::string bits, hex;
+    for (int init = 0; init < 2; ++init) {
+        const Syndrome& syndrome = init ? init1 : init0;
+        fillSyndrome(syndrome, bits);
+        toHex(bits, hex);
+        out.put("{\"fault\":");
+        putJsonString(out, fault.id_.faultName_.str());
+        out.put(",\"subcase\":").num(fault.id_.subcaseIdx_).put(",\"sfr\":");
+        putJsonString(out, sfr);
+        out.put(",\"init\":").num(init).put(",\"detected\":").put(syndrome.any() ? "true" : "false");
+        out.put(",\"syndrome\":\"").put(bits).put("\",\"hex\":\"0x").put(hex).put("\",\"detect_ops\":[");
+        bool first = true;
+        for (std::size_t i = 0; i < reads.size(); ++i) {
+            if (bits[i] != '1') continue;
+            if (!first) out.put(',');
+            out.put("\"M").num(reads[i].marchIdx).put('(').num(reads[i].opIdx).put(")\"");
+            first = false;
+        }
+        out.put("]}\n");
+    }
+}
+
+// Columnar binary (.fscol)，整數皆為 little-endian：
+//   "FSCOL001"
+//   uint32 rows, uint32 reads, uint32 strings
+//   reads   x {int32 marchIdx, int32 opIdx}
+//   strings x {uint32 length, bytes}           fault 名稱與 <S/F/R> 的字串表
+//   int32  fault[rows], int32 subcase[rows], int32 sfr[rows]   (fault / sfr 為字串表索引)
+//   uint8  init[rows], uint8 detected[rows]
+//   uint64 syndrome[rows][(reads + 63) / 64]   第 i 個 bit (LSB 起算) = 第 i 個 read
+void Parser::writeColumnarReport(const std::vector<FaultConfig>& faults,
+                                 const ResultStore& results,
+                                 const std::string& filename) const {
+    const auto& reads = results.reads();
+    const std::size_t rows = faults.size() * 2;
+    const std::size_t words = results.stride(); // 與 ResultStore 的列相同
+
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, int32_t> stringId;
+    auto intern = [&](std::string text) {
+        auto [it, added] = stringId.emplace(std::move(text), static_cast<int32_t>(strings.size()));
+        if (added) strings.push_back(it->first);
+        return it->second;
+    };
+    std::vector<int32_t> faultCol, subcaseCol, sfrCol;
+    std::vector<uint8_t> initCol, detectedCol;
+    std::vector<uint64_t> syndromeCol;
+    faultCol.reserve(rows); subcaseCol.reserve(rows); sfrCol.reserve(rows);
+    initCol.reserve(rows); detectedCol.reserve(rows); syndromeCol.reserve(rows * words);
+
+    for (std::size_t f = 0; f < faults.size(); ++f) {
+        const FaultConfig& fault = faults[f];
+        const int32_t name = intern(fault.id_.faultName_.str());
+        const int32_t sfr = intern(processSFR(fault));
+        for (int init = 0; init < 2; ++init) {
+            faultCol.push_back(name);
+            subcaseCol.push_back(fault.id_.subcaseIdx_);
+            sfrCol.push_back(sfr);
+            initCol.push_back(static_cast<uint8_t>(init));
+            detectedCol.push_back(results.detected(f, init) ? 1 : 0);
+            const uint64_t* syndrome = results.words(f, init);
+            syndromeCol.insert(syndromeCol.end(), syndrome, syndrome + words);
+        }
+    }
+
+    BufferedWriter out(filename);
+    out.put("FSCOL001");
+    out.bin(static_cast<uint32_t>(rows)).bin(static_cast<uint32_t>(reads.size()))
+       .bin(static_cast<uint32_t>(strings.size()));
+    for (const auto& idx : reads) out.bin(static_cast<int32_t>(idx.marchIdx)).bin(static_cast<int32_t>(idx.opIdx));
+    for (const auto& text : strings) out.bin(static_cast<uint32_t>(text.size())).put(text);
+    out.bin(faultCol).bin(subcaseCol).bin(sfrCol).bin(initCol).bin(detectedCol).bin(syndromeCol);
+    out.flush();
+}
+
+// ─────────────── writeWordDetectionReport ─────────────────────────────
+void Parser::writeWordDetectionReport(const std::vector<FaultConfig>& faults,
+                                      const std::vector<WordDetectionReport>& reports,
+                                      const std::vector<DataBackground>& backgrounds,
+                                      int width,
+                                      double detectedRate,
+                                      const std::string& filename) const {
+    std::ofstream ofs(filename);
+    if (!ofs) throw std::runtime_error("無法開啟輸出檔案: " + filename);
+    ofs << "Detected Rate: " << detectedRate * 100 << "%\n";
+    ofs << "Word width: " << width << ", Backgrounds:";
+    for (DataBackground bg : backgrounds) ofs << " " << toString(bg);
+    ofs << "\n\n";
+    for (std::size_t i = 0; i < faults.size() && i < reports.size(); ++i) {
+        const FaultConfig& fault = faults[i];
+        const WordDetectionReport& report = reports[i];
+        ofs << fault.id_.faultName_ << "\nSubcase " << fault.id_.subcaseIdx_ << " ";
+        ofs << processSFR(fault) << "\n";
+        for (int init = 0; init < 2; ++init) {
+            // 偵測到的 bit 位置數 / 有意義的 bit 位置數，以及各 background 的 lane mask
+            ofs << "Init " << init << ": " << std::popcount(report.detectedLanes(init))
+                << "/" << std::popcount(report.validLanes_) << " bits (";
+            for (std::size_t b = 0; b < backgrounds.size() && b < report.detected_[init].size(); ++b) {
+                if (b) ofs << ", ";
+                ofs << toString(backgrounds[b]) << " 0x" << std::hex
+                    << report.detected_[init][b] << std::dec;
             }
             ofs << ")\n";
+        }
+        ofs << "\n";
+    }
+}
 
-            for (const auto& it : fault.init1_healthReport_.detected_) {
-                if (it.second) {
-                    ofs << "M" << it.first.marchIdx << "(" << it.first.opIdx << ") ";
-                }
-            }
-            ofs << "\n\n";
+// ─────────────── writeLinkedDetectionReport ───────────────────────────
+void Parser::writeLinkedDetectionReport(const std::vector<FaultConfig>& faults,
+                                        const std::vector<LinkedDetectionReport>& reports,
+                                        int order, long long candidates,
+                                        double detectedRate,
+                                        const std::string& filename) const {
+    std::ofstream ofs(filename);
+    if (!ofs) throw std::runtime_error("無法開啟輸出檔案: " + filename);
+    ofs << "Detected Rate: " << detectedRate * 100 << "%\n";
+    ofs << "Linked order: " << order << ", Candidates: " << candidates
+        << ", Simulated: " << reports.size()
+        << ", Pruned: " << candidates - static_cast<long long>(reports.size()) << "\n\n";
+    // 只列出至少一種初值下未被偵測的組合
+    for (const auto& r : reports) {
+        if (r.detected_[0] && r.detected_[1]) continue;
+        for (std::size_t k = 0; k < r.members_.size(); ++k) {
+            const FaultConfig& fault = faults[r.members_[k]];
+            ofs << (k ? "  + " : "") << fault.id_.faultName_ << " Subcase "
+                << fault.id_.subcaseIdx_ << " " << processSFR(fault) << "\n";
+        }
+        for (int init = 0; init < 2; ++init) {
+            ofs << "Init " << init << ": "
+                << (r.detected_[init] ? "Detected" : (r.masked_[init] ? "No detection (masked)" : "No detection"))
+                << "\n";
         }
+        ofs << "\n";
+    }
+}
+
+// ─────────────── writeMonteCarloReport ────────────────────────────────
+void Parser::writeMonteCarloReport(const std::vector<FaultConfig>& faults,
+                                   const std::vector<MonteCarloReport>& reports,
+                                   const MonteCarloOptions& options,
+                                   double detectedRate,
+                                   const std::string& filename) const {
+    std::ofstream ofs(filename);
+    if (!ofs) throw std::runtime_error("無法開啟輸出檔案: " + filename);
+    ofs << "Detected Rate: " << detectedRate * 100 << "%\n";
+    ofs << "Monte-Carlo: confidence " << options.confidence * 100 << "%, tolerance "
+        << options.tolerance * 100 << "%, max samples " << options.maxSamples
+        << ", activation " << options.activation << ", seed " << options.seed << "\n\n";
+    for (std::size_t i = 0; i < faults.size() && i < reports.size(); ++i) {
+        const FaultConfig& fault = faults[i];
+        const MonteCarloReport& report = reports[i];
+        ofs << fault.id_.faultName_ << "\nSubcase " << fault.id_.subcaseIdx_ << " ";
+        ofs << processSFR(fault) << "\n";
+        ofs << "P(detect) = " << report.estimate() * 100 << "% ["
+            << report.lo_ * 100 << "%, " << report.hi_ * 100 << "%], "
+            << report.detected_ << "/" << report.samples_ << " samples"
+            << (report.converged_ ? "" : " (sample limit)") << "\n\n";
     }
 }
 
 // ─────────────── processSFR ───────────────────────────────────────────
 std::string Parser::processSFR(const FaultConfig& fault) const {
     std::string out;
-    if (fault.is_twoCell_) {
+    if (fault.isTimed()) {
+        out += std::string("< ") + (fault.timeKind_ == TimeFaultKind::Retention ? "DRF " : "leak ");
+        out += std::to_string(fault.VI_) + " ~" + formatSimTime(fault.retentionTime_);
+        out += " / " + std::to_string(fault.faultValue_) + " >";
+    } else if (fault.isDecoder()) {
+        out += std::string("< AF ") + toString(fault.decoderKind_) + " / " + std::to_string(fault.faultValue_) + " >";
+    } else if (fault.isNCell()) {
+        // < 鄰域狀態 @trigger cell 觸發序列 / fault value / final read >
+        out += "< ";
+        for (int st : fault.cellStates_) out += (st < 0) ? '-' : static_cast<char>('0' + st);
+        out += " @" + std::to_string(fault.triggerCell_) + " ";
+        for (const auto& sop : fault.trigger_) {
+            out += sop.type_ == OpType::R ? 'R' : 'W';
+            out += std::to_string(sop.value_);
+            if (sop.repeat_ > 1) out += "^" + std::to_string(sop.repeat_);
+        }
+        out += " / " + std::to_string(fault.faultValue_);
+        out += " / " + std::to_string(fault.finalReadValue_) + " >";
+    } else if (fault.is_twoCell_) {
         
         out += "< " + std::to_string(fault.AI_);
         if (fault.twoCellFaultType_ == TwoCellFaultType::Sa) {
             for (const auto& sop : fault.trigger_) {
                 out += sop.type_ == OpType::R ? 'R' : 'W';
                 out += std::to_string(sop.value_);
+                if (sop.repeat_ > 1) out += "^" + std::to_string(sop.repeat_);
             }
             out += "; " + std::to_string(fault.VI_);
         } else if (fault.twoCellFaultType_ == TwoCellFaultType::Sv) {
@@ -375,6 +733,7 @@ std::string Parser::processSFR(const FaultConfig& fault) const {
             for (const auto& sop : fault.trigger_) {
                 out += sop.type_ == OpType::R ? 'R' : 'W';
                 out += std::to_string(sop.value_);
+                if (sop.repeat_ > 1) out += "^" + std::to_string(sop.repeat_);
             }
         }
         
@@ -383,10 +742,14 @@ std::string Parser::processSFR(const FaultConfig& fault) const {
         out += " >";
         out += (fault.is_A_less_than_V_ ? " (A<V)" : " (A>V) ");
     } else {
-        out += "< " + std::to_string(fault.VI_);
+        out += "< ";
+        if (fault.lineScope_ == LineScope::Row)    out += "row ";
+        if (fault.lineScope_ == LineScope::Column) out += "column ";
+        out += std::to_string(fault.VI_);
         for (const auto& sop : fault.trigger_) {
             out += sop.type_ == OpType::R ? 'R' : 'W';
             out += std::to_string(sop.value_);
+            if (sop.repeat_ > 1) out += "^" + std::to_string(sop.repeat_);
         }
         out += " / " + std::to_string(fault.faultValue_);
         out += " / " + std::to_string(fault.finalReadValue_) + " >";
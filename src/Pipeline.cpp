@@ -0,0 +1,163 @@
+#include "../include/Pipeline.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "../include/BoundedQueue.hpp"
+#include "../include/BufferedWriter.hpp"
+#include "../include/FaultSimulator.hpp"
+#include "../include/Parser.hpp"
+#include "../include/ResultStore.hpp"
+
+namespace {
+
+struct Item {
+    uint64_t seq {0};
+    FaultConfig cfg;
+    Syndrome syndromes[2]; // [init]，由 worker 填入
+};
+
+// 同時存在的 fault 名額；abort() 之後 acquire 一律失敗
+class Window {
+public:
+    explicit Window(std::size_t size) : free_(size), size_(size) {}
+
+    bool acquire() {
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [&] { return aborted_ || free_ > 0; });
+        if (aborted_) return false;
+        --free_;
+        peak_ = std::max(peak_, size_ - free_);
+        return true;
+    }
+    void release() {
+        std::lock_guard<std::mutex> lock(mu_);
+        ++free_;
+        cv_.notify_one();
+    }
+    void abort() {
+        std::lock_guard<std::mutex> lock(mu_);
+        aborted_ = true;
+        cv_.notify_all();
+    }
+    std::size_t peak() const { return peak_; }
+
+private:
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::size_t free_;
+    const std::size_t size_;
+    std::size_t peak_ {0};
+    bool aborted_ {false};
+};
+
+// loader 在 pipeline 中止時用來跳出 Parser::streamFaults
+struct Aborted {};
+
+} // namespace
+
+SimulationPipeline::SimulationPipeline(const std::vector<MarchElement>& marchTest, PipelineOptions options)
+    : marchTest_(marchTest), opt_(options) {
+    if (opt_.workers <= 0)
+        opt_.workers = std::max(1u, std::thread::hardware_concurrency());
+    if (opt_.queueDepth == 0) opt_.queueDepth = 1;
+    window_ = 2 * opt_.queueDepth + static_cast<std::size_t>(opt_.workers);
+}
+
+PipelineStats SimulationPipeline::run(const std::string& faultFile, const std::string& outFile) {
+    const Parser parser;
+    const auto reads = Parser::readOps(marchTest_);
+    BoundedQueue<Item> input(opt_.queueDepth);
+    BoundedQueue<Item> output(opt_.queueDepth);
+    Window window(window_);
+    PipelineStats stats;
+    // 所有 worker 共用同一份編譯後的 March program (唯讀)
+    const auto program = std::make_shared<const MarchProgram>(marchTest_, opt_.rows, opt_.cols);
+
+    // 任一階段失敗：記下第一個例外，讓其他階段盡快結束
+    std::mutex errorMu;
+    std::exception_ptr error;
+    auto fail = [&](std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(errorMu);
+            if (!error) error = e;
+        }
+        window.abort();
+        input.close();
+        output.close();
+    };
+
+    BufferedWriter out(outFile);
+    if (opt_.format == StreamFormat::Csv) parser.writeCsvHeader(out);
+
+    std::thread writer([&] {
+        try {
+            std::map<uint64_t, Item> pending; // 提早完成、尚未輪到的 fault
+            uint64_t next = 0;
+            Item item;
+            for (;;) {
+                if (!output.tryPop(item)) {
+                    out.flush();                       // 暫時沒有新結果：先讓已完成的列可見
+                    if (!output.pop(item)) break;
+                }
+                pending.emplace(item.seq, std::move(item));
+                for (auto it = pending.begin(); it != pending.end() && it->first == next; it = pending.begin()) {
+                    const Item& done = it->second;
+                    const Syndrome* syn = done.syndromes;
+                    if (opt_.format == StreamFormat::Csv) parser.writeCsvRows(out, done.cfg, syn[0], syn[1], reads);
+                    else parser.writeJsonRows(out, done.cfg, syn[0], syn[1], reads);
+                    stats.detected += syn[0].any() + syn[1].any();
+                    pending.erase(it);
+                    ++next;
+                    window.release();
+                }
+            }
+            out.flush();
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < opt_.workers; ++w) {
+        workers.emplace_back([&] {
+            try {
+                SingleFaultSimulator sim(marchTest_, program, opt_.rows, opt_.cols, opt_.seed, opt_.memoryKind);
+                sim.setBothDirections(opt_.bothDirections);
+                Item item;
+                while (input.pop(item)) {
+                    sim.run(item.cfg, item.seq);
+                    for (int init = 0; init < 2; ++init)
+                        item.syndromes[init] = ResultStore::toSyndrome(sim.report(init), reads);
+                    if (!output.push(std::move(item))) break;
+                }
+            } catch (...) {
+                fail(std::current_exception());
+            }
+        });
+    }
+
+    try {
+        uint64_t seq = 0;
+        parser.streamFaults(faultFile, [&](FaultConfig&& cfg) {
+            if (!window.acquire() || !input.push({ seq, std::move(cfg), {} })) throw Aborted{};
+            ++seq;
+        });
+        stats.faults = static_cast<long long>(seq);
+    } catch (const Aborted&) {
+        // 其他階段已失敗，例外已記錄
+    } catch (...) {
+        fail(std::current_exception());
+    }
+    input.close();
+    for (auto& t : workers) t.join();
+    output.close();
+    writer.join();
+
+    if (error) std::rethrow_exception(error);
+    stats.peakInFlight = window.peak();
+    return stats;
+}
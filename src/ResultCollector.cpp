@@ -1,10 +1,57 @@
 # include "../include/ResultCollector.hpp"
+# include "../include/Fault.hpp"
     
 void OneByOneResultCollector::opRecord(const MarchIdx& idx, int addr, bool isDetected) {
-    report_.detected_[idx] = report_.detected_[idx] || isDetected;
+    bool& detected = report_.detected_[idx];
+    detected = detected || isDetected;
     report_.isDetected_ = report_.isDetected_ || isDetected; // At least one detection occurred
     if (isDetected) {
-        report_.detectedVicAddrs_.insert(addr); // Add the detected victim address
+        // Add the detected victim address (reusing a spare node when there is one)
+        auto& addrs = report_.detectedVicAddrs_;
+        if (spareAddrs_.empty() || addrs.count(addr)) {
+            addrs.insert(addr);
+        } else {
+            spareAddrs_.back().value() = addr;
+            addrs.insert(std::move(spareAddrs_.back()));
+            spareAddrs_.pop_back();
+        }
     }
 }
 
+void OneByOneResultCollector::reset() {
+    report_.isDetected_ = false;
+    for (auto& entry : report_.detected_) entry.second = false;
+    auto& addrs = report_.detectedVicAddrs_;
+    while (!addrs.empty()) spareAddrs_.push_back(addrs.extract(addrs.begin()));
+}
+
+void SpatialResultCollector::opRecord(const MarchIdx& idx, int addr, bool isDetected) {
+    const int owner = overlay_.ownerOf(addr);
+    if (owner < 0) {
+        if (isDetected) ++unattributed_;
+        return;
+    }
+    if (owner >= static_cast<int>(reports_.size())) reports_.resize(owner + 1);
+    DetectionReport& report = reports_[owner];
+    report.detected_[idx] = report.detected_[idx] || isDetected;
+    report.isDetected_ = report.isDetected_ || isDetected;
+    if (isDetected) {
+        report.detectedVicAddrs_.insert(addr);
+    }
+}
+
+DetectionReport SpatialResultCollector::getReport() const {
+    DetectionReport merged;
+    for (const auto& r : reports_) {
+        merged.isDetected_ = merged.isDetected_ || r.isDetected_;
+        merged.detectedVicAddrs_.insert(r.detectedVicAddrs_.begin(), r.detectedVicAddrs_.end());
+        for (const auto& it : r.detected_)
+            merged.detected_[it.first] = merged.detected_[it.first] || it.second;
+    }
+    return merged;
+}
+
+void SpatialResultCollector::reset() {
+    reports_.assign(overlay_.size(), DetectionReport());
+    unattributed_ = 0;
+}
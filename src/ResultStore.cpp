@@ -0,0 +1,207 @@
+#include "../include/ResultStore.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = { 'F', 'S', 'R', 'E', 'S', '0', '0', '1' };
+
+struct SpillHeader {
+    char magic[8];
+    uint64_t faults;
+    uint32_t reads;
+    uint32_t stride;
+};
+static_assert(sizeof(SpillHeader) == 24 && sizeof(SpillHeader) % sizeof(uint64_t) == 0);
+
+// 對 report 中每個失敗的 read 呼叫 fn(bit)，bit 為它在 reads 中的位置
+template <typename Fn>
+void forEachFailedRead(const DetectionReport& report, const std::vector<MarchIdx>& reads, Fn fn) {
+    std::size_t i = 0;
+    // detected_ 與 reads 同樣依 overallIdx 排序，一起往前走即可
+    for (const auto& [idx, failed] : report.detected_) {
+        while (i < reads.size() && reads[i] < idx) ++i;
+        if (i == reads.size()) break;
+        if (failed && reads[i] == idx) fn(i);
+    }
+}
+
+} // namespace
+
+// === Syndrome ===
+std::string Syndrome::toString() const {
+    std::string bits(bits_, '0');
+    for (int i = 0; i < bits_; ++i)
+        if (test(i)) bits[i] = '1';
+    return bits;
+}
+
+Syndrome Syndrome::fromString(const std::string& bits) {
+    Syndrome s(static_cast<int>(bits.size()));
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        if (bits[i] == '1') s.set(static_cast<int>(i));
+        else if (bits[i] != '0') throw std::invalid_argument("syndrome 只能包含 0 / 1：" + bits);
+    }
+    return s;
+}
+
+// === ResultStore ===
+ResultStore::ResultStore(std::size_t faults, const std::vector<MarchElement>& marchTest,
+                         const std::string& spillFile)
+    : faults_(faults) {
+    for (const auto& elem : marchTest)
+        for (const auto& op : elem.ops_)
+            if (op.op_.type_ == OpType::R) reads_.push_back(op.idx_);
+    std::sort(reads_.begin(), reads_.end());
+    stride_ = (reads_.size() + 63) / 64;
+
+    if (spillFile.empty()) {
+        heap_.assign(faults_ * 2 * stride_, 0);
+        data_ = heap_.data();
+        return;
+    }
+    mapSpill(spillFile, true);
+}
+
+ResultStore ResultStore::reopen(const std::string& spillFile, std::size_t faults,
+                                const std::vector<MarchElement>& marchTest) {
+    ResultStore store(0, marchTest);
+    store.faults_ = faults;
+    store.mapSpill(spillFile, false);
+    return store;
+}
+
+void ResultStore::mapSpill(const std::string& spillFile, bool create) {
+#ifdef _WIN32
+    (void)create;
+    throw std::runtime_error("此平台不支援 spill 檔：" + spillFile);
+#else
+    const int fd = ::open(spillFile.c_str(), create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644);
+    if (fd < 0) throw std::runtime_error((create ? "無法建立 spill 檔: " : "無法開啟 spill 檔: ") + spillFile);
+    mapBytes_ = sizeof(SpillHeader) + faults_ * 2 * stride_ * sizeof(uint64_t);
+    if (create) {
+        // ftruncate 產生的是 sparse file：未寫入的列不佔用磁碟，讀出為 0
+        if (::ftruncate(fd, static_cast<off_t>(mapBytes_)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("無法配置 spill 檔: " + spillFile);
+        }
+    } else {
+        SpillHeader header {};
+        const bool ok = ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+                     && std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0
+                     && header.faults == faults_ && header.reads == reads_.size()
+                     && header.stride == stride_ && ::lseek(fd, 0, SEEK_END) == static_cast<off_t>(mapBytes_);
+        if (!ok) {
+            ::close(fd);
+            throw std::runtime_error("spill 檔與本次的 fault library / March test 不符: " + spillFile);
+        }
+    }
+    void* map = ::mmap(nullptr, mapBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // mapping 不依賴檔案描述子
+    if (map == MAP_FAILED) throw std::runtime_error("無法 mmap spill 檔: " + spillFile);
+    map_ = map;
+    heap_.clear();
+
+    if (create) {
+        SpillHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.faults = faults_;
+        header.reads = static_cast<uint32_t>(reads_.size());
+        header.stride = static_cast<uint32_t>(stride_);
+        std::memcpy(map_, &header, sizeof(header));
+    }
+    data_ = reinterpret_cast<uint64_t*>(static_cast<char*>(map_) + sizeof(SpillHeader));
+#endif
+}
+
+void ResultStore::flush() {
+#ifndef _WIN32
+    if (map_ && ::msync(map_, mapBytes_, MS_SYNC) != 0)
+        throw std::runtime_error("無法寫回 spill 檔");
+#endif
+}
+
+ResultStore::~ResultStore() { release(); }
+
+ResultStore::ResultStore(ResultStore&& other) noexcept { *this = std::move(other); }
+
+ResultStore& ResultStore::operator=(ResultStore&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    reads_ = std::move(other.reads_);
+    faults_ = std::exchange(other.faults_, 0);
+    stride_ = std::exchange(other.stride_, 0);
+    heap_ = std::move(other.heap_);
+    data_ = std::exchange(other.data_, nullptr);
+    map_ = std::exchange(other.map_, nullptr);
+    mapBytes_ = std::exchange(other.mapBytes_, 0);
+    return *this;
+}
+
+void ResultStore::release() {
+#ifndef _WIN32
+    if (map_) ::munmap(map_, mapBytes_);
+#endif
+    map_ = nullptr;
+    mapBytes_ = 0;
+    data_ = nullptr;
+    heap_.clear();
+}
+
+void ResultStore::set(std::size_t fault, int init, const DetectionReport& report) {
+    uint64_t* words = row(fault, init);
+    std::fill(words, words + stride_, 0);
+    forEachFailedRead(report, reads_, [&](std::size_t i) { words[i >> 6] |= uint64_t{1} << (i & 63); });
+}
+
+void ResultStore::set(std::size_t fault, int init, const Syndrome& syndrome) {
+    if (syndrome.size() != readCount())
+        throw std::invalid_argument("syndrome 長度與 ResultStore 的 read 數不符");
+    std::copy(syndrome.words().begin(), syndrome.words().end(), row(fault, init));
+}
+
+bool ResultStore::detected(std::size_t fault, int init) const {
+    const uint64_t* words = row(fault, init);
+    for (std::size_t k = 0; k < stride_; ++k)
+        if (words[k]) return true;
+    return false;
+}
+
+DetectionReport ResultStore::report(std::size_t fault, int init) const {
+    DetectionReport report;
+    const uint64_t* words = row(fault, init);
+    for (std::size_t i = 0; i < reads_.size(); ++i) {
+        const bool failed = (words[i >> 6] >> (i & 63)) & 1;
+        report.detected_.emplace_hint(report.detected_.end(), reads_[i], failed);
+        report.isDetected_ = report.isDetected_ || failed;
+    }
+    return report;
+}
+
+long long ResultStore::detectedCount() const {
+    long long count = 0;
+    for (std::size_t f = 0; f < faults_; ++f)
+        count += detected(f, 0) + detected(f, 1);
+    return count;
+}
+
+void ResultStore::copyRows(const ResultStore& other, std::size_t first, std::size_t last) {
+    if (other.reads_ != reads_ || other.faults_ != faults_ || first > last || last > faults_)
+        throw std::invalid_argument("ResultStore 的 fault 數或 read 順序不同，無法複製");
+    // 同一個 fault 的兩列相鄰，[first, last) 是一整段連續的 word
+    std::copy(other.row(first, 0), other.row(first, 0) + (last - first) * 2 * stride_, row(first, 0));
+}
+
+Syndrome ResultStore::toSyndrome(const DetectionReport& report, const std::vector<MarchIdx>& reads) {
+    Syndrome s(static_cast<int>(reads.size()));
+    forEachFailedRead(report, reads, [&](std::size_t i) { s.set(static_cast<int>(i)); });
+    return s;
+}
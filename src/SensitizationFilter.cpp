@@ -0,0 +1,59 @@
+#include "../include/SensitizationFilter.hpp"
+
+SensitizationFilter::SensitizationFilter(const std::vector<MarchElement>& marchTest) {
+    for (int init = 0; init < 2; ++init) {
+        int value = init; // 進入目前 element 時 cell 的 fault-free 值
+        streams_[init].reserve(marchTest.size());
+        for (const auto& elem : marchTest) {
+            std::vector<OperationRun> stream;
+            for (const auto& pop : elem.ops_) {
+                const SingleOp op{pop.op_.type_, pop.op_.value_};
+                const int repeat = pop.op_.repeat_;
+                if (op.type_ == OpType::R) {
+                    if (op.value_ != value) consistent_[init] = false;
+                    appendRun(stream, {value, op}, repeat);
+                } else if (op.type_ == OpType::W) {
+                    appendRun(stream, {value, op}, 1);
+                    if (repeat > 1) appendRun(stream, {op.value_, op}, repeat - 1);
+                    value = op.value_;
+                }
+                // CI / CO / Del 不會餵給 trigger，不列入序列
+            }
+            streams_[init].push_back(std::move(stream));
+        }
+    }
+}
+
+bool SensitizationFilter::canTrigger(const FaultConfig& cfg, int initValue) const {
+    const int init = initValue & 1;
+    if (!consistent_[init]) return true;
+    if (cfg.isDecoder()) return true; // 沒有觸發序列，每次存取故障位址都會生效
+    if (cfg.isTimed()) return true;   // 由時間觸發，與操作序列無關
+    // 每個 fault 都會呼叫：pattern 重複使用同一塊 (每個 thread 一份) 空間，不逐次配置
+    thread_local std::vector<OperationRun> pattern;
+    toOperationRuns(cfg.triggerInitialValue(), cfg.trigger_, pattern);
+    for (std::size_t e = 0; e < streams_[init].size(); ++e) {
+        if (matchesElement(cfg, init, e, pattern)) return true;
+    }
+    return false;
+}
+
+bool SensitizationFilter::canTriggerInElement(const FaultConfig& cfg, int initValue,
+                                              std::size_t elemIdx) const {
+    return matchesElement(cfg, initValue, elemIdx, toOperationRuns(cfg.triggerInitialValue(), cfg.trigger_));
+}
+
+bool SensitizationFilter::matchesElement(const FaultConfig& cfg, int initValue, std::size_t elemIdx,
+                                         const std::vector<OperationRun>& pattern) const {
+    const auto& stream = streams_[initValue & 1].at(elemIdx);
+    // 空序列 (如 CFst)：只要該 cell 被存取就會比對成功
+    if (cfg.trigger_.empty()) return !stream.empty();
+
+    // pattern 第一個操作的 before value：trigger 所在 cell 的初值
+    // (Sa 為 aggressor，N-cell 為 triggerCell_，其餘為 victim)
+    if (stream.size() < pattern.size()) return false;
+    for (std::size_t s = 0; s + pattern.size() <= stream.size(); ++s) {
+        if (runsMatch(stream, s, pattern, false)) return true;
+    }
+    return false;
+}
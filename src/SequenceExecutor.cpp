@@ -1,39 +1,323 @@
 #include "../include/SequenceExecutor.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include "../include/MarchLibrary.hpp"
 
-void SequenceExecutor::execute( const std::vector<MarchElement>& marchTest, IFault& fault) {
+void SequenceExecutor::execute(const std::vector<MarchElement>& marchTest, IFault& fault) {
     if (memSize_ <= 0 || marchTest.empty()) {
         // No memory to simulate or no operations to execute
         return;
     }
-    for (const auto& elem : marchTest) {
-        fault.reset(); // Reset fault state for each March element
-        if (elem.addrOrder_ == Direction::ASC || elem.addrOrder_ == Direction::BOTH) {
-            // Process operations in ascending order
-            for (int addr = 0; addr < memSize_; ++addr) {
-                processElementAtAddr(elem, fault, addr);
+    execute(MarchProgram(marchTest, memSize_), fault);
+}
+
+// ─────────────── 內建 March test 的展開 kernel ───────────────────────
+//   與下面 execute() 的直譯迴圈逐一對應：kind / value / repeat / 方向 / 是否為暫停都是編譯期常數，
+//   每個 element 的操作以 fold expression 展開成直線程式碼。
+template <std::size_t... I>
+constexpr auto SequenceExecutor::kernels(std::index_sequence<I...>) {
+    return std::array<Kernel, sizeof...(I)>{ &SequenceExecutor::runBuiltin<static_cast<int>(I)>... };
+}
+
+template <int I>
+void SequenceExecutor::runBuiltin(IFault& fault) {
+    constexpr int count = MarchLibrary::kTests[I].march.elementCount;
+    [&]<int... E>(std::integer_sequence<int, E...>) {
+        (runElement<I, E>(fault), ...);
+    }(std::make_integer_sequence<int, count>{});
+}
+
+template <int I, int E>
+void SequenceExecutor::runElement(IFault& fault) {
+    static constexpr StaticElement elem = MarchLibrary::kTests[I].march.elems[E];
+    static constexpr auto ops = std::make_integer_sequence<int, elem.end - elem.begin>{};
+    constexpr bool pause = [] {
+        if (elem.begin == elem.end) return false;
+        for (int k = elem.begin; k < elem.end; ++k)
+            if (MarchLibrary::kTests[I].march.ops[k].type != OpType::DEL) return false;
+        return true;
+    }();
+
+    fault.reset();
+    auto body = [&]<int... K>(int addr, std::integer_sequence<int, K...>) {
+        (runOp<I, E, elem.begin + K>(fault, addr), ...);
+    };
+    if constexpr (pause) {
+        body(-1, ops);
+    } else if constexpr (elem.dir == Direction::DESC) {
+        for (int addr = memSize_ - 1; addr >= 0; --addr) body(addr, ops);
+    } else {
+        for (int addr = 0; addr < memSize_; ++addr) body(addr, ops);
+    }
+}
+
+template <int I, int E, int K>
+void SequenceExecutor::runOp(IFault& fault, int addr) {
+    static constexpr StaticOp so = MarchLibrary::kTests[I].march.ops[K];
+    static constexpr SingleOp op(so.type, so.value, so.repeat);
+    if constexpr (so.type == OpType::DEL) {
+        advance(fault, so.value * kNsPerMs);
+        return;
+    } else {
+        int times = 1;
+        if constexpr (so.repeat > 1) times = fault.observes(addr) ? so.repeat : 1;
+        if constexpr (so.type == OpType::R) {
+            static constexpr MarchIdx idx(E, so.opIdx, K);
+            bool mismatch = false;
+            for (int t = 0; t < times; ++t) {
+                if (fault.readProcess(addr, op) != so.value) mismatch = true;
             }
-        } else if (elem.addrOrder_ == Direction::DESC) {
-            // Process operations in descending order
-            for (int addr = memSize_ - 1; addr >= 0; --addr) {
-                processElementAtAddr(elem, fault, addr);
+            collector_.opRecord(idx, addr, mismatch);
+        } else if constexpr (so.type == OpType::W) {
+            for (int t = 0; t < times; ++t) fault.writeProcess(addr, op);
+        }
+        advance(fault, clock_.cycleTime() * so.repeat);
+    }
+}
+
+void SequenceExecutor::runElement(const MarchProgram& program, int e, IFault& fault, IResultCollector& collector,
+                                  bool reversed) {
+    fault.reset(); // Reset fault state for each March element
+    const int begin = program.opBegin(e), end = program.opEnd(e);
+    if (program.pause(e)) {
+        for (int i = begin; i < end; ++i) advance(fault, program.delay(i));
+        return;
+    }
+    const SimTime cycle = clock_.cycleTime();
+    int first = program.firstPos(e), step = program.posStep(e);
+    if (reversed) {
+        first += (memSize_ - 1) * step;
+        step = -step;
+    }
+    const int* addresses = program.addresses(e);
+    for (int n = 0, pos = first; n < memSize_; ++n, pos += step) {
+        const int addr = addresses ? addresses[pos] : pos;
+        for (int i = begin; i < end; ++i) {
+            // op^N：fault 不觀察的 cell 上重複讀寫的結果與做一次相同，只執行一次
+            const int repeat = program.repeat(i);
+            const int times = (repeat > 1 && fault.observes(addr)) ? repeat : 1;
+            switch (program.kind(i)) {
+                case MarchProgram::Read: {
+                    // 重複讀取時任一次讀錯即算偵測
+                    const SingleOp& op = program.op(i);
+                    const int expected = program.value(i);
+                    bool mismatch = false;
+                    for (int t = 0; t < times; ++t) {
+                        if (fault.readProcess(addr, op) != expected) mismatch = true;
+                    }
+                    collector.opRecord(program.index(i), addr, mismatch);
+                    break;
+                }
+                case MarchProgram::Write: {
+                    const SingleOp& op = program.op(i);
+                    for (int t = 0; t < times; ++t) fault.writeProcess(addr, op);
+                    break;
+                }
+                case MarchProgram::Delay:
+                    advance(fault, program.delay(i));
+                    continue;
+                case MarchProgram::Idle:
+                    break;
             }
+            // R / W / CI / CO 各佔一個 cycle (op^N 佔 N 個，不論實際執行幾次)
+            advance(fault, cycle * repeat);
         }
     }
 }
 
-void SequenceExecutor::processElementAtAddr(const MarchElement& elem, IFault& fault, int mem_idx) {
+void SequenceExecutor::execute(const MarchProgram& program, IFault& fault) {
+    if (memSize_ <= 0 || program.elementCount() == 0) return;
+    if (program.memorySize() != memSize_)
+        throw std::invalid_argument("MarchProgram 的記憶體大小與 SequenceExecutor 不符");
+    clock_.reset();
+    fault.attachClock(&clock_);
+    timed_ = fault.timed();
+    peakBranches_ = 1;
+    if (bothDirections_ && program.hasBoth()) {
+        executeForked(program, fault);
+        return;
+    }
+    if (program.builtin() >= 0) {
+        static constexpr auto table = kernels(std::make_index_sequence<MarchLibrary::kCount>{});
+        (this->*table[program.builtin()])(fault);
+        return;
+    }
+    for (int e = 0; e < program.elementCount(); ++e) runElement(program, e, fault, collector_, false);
+}
+
+// ─────────────── ⇕ 兩個方向的分岔 ───────────────────────
+namespace {
+
+// 一條路徑上讀錯的 read
+struct Hit {
+    MarchIdx idx;
+    int addr;
+};
+
+// 只記錄讀錯的 read；未偵測的 read 最後才一次補給真正的 collector
+class BranchCollector final : public IResultCollector {
+public:
+    explicit BranchCollector(std::vector<Hit>& hits) : hits_(hits) {}
+    void opRecord(const MarchIdx& idx, int addr, bool isDetected) override {
+        if (isDetected) hits_.push_back({ idx, addr });
+    }
+    DetectionReport getReport() const override { return {}; }
+    void reset() override { hits_.clear(); }
+private:
+    std::vector<Hit>& hits_;
+};
+
+struct Branch {
+    std::shared_ptr<MemoryState> mem; // 最近一次保存的記憶體；live 時以 fault 的記憶體為準
+    FaultForkState state;             // 同上，live 時以 fault 為準
+    std::vector<Hit> hits;
+    bool live {false};
+};
+
+// 讀錯過的 read (overallIdx，遞增且不重複；即 syndrome 中的 1)
+std::vector<int> failingReads(const std::vector<Hit>& hits) {
+    std::vector<int> ops;
+    ops.reserve(hits.size());
+    for (const Hit& h : hits) ops.push_back(h.idx.overallIdx);
+    std::sort(ops.begin(), ops.end());
+    ops.erase(std::unique(ops.begin(), ops.end()), ops.end());
+    return ops;
+}
+
+int detectedReads(const std::vector<Hit>& hits) { return static_cast<int>(failingReads(hits).size()); }
+
+// a 的偵測是否比 b 差：先看有沒有偵測，再看 syndrome 的 1 的個數，最後看讀錯的次數
+bool worse(const Branch& a, const Branch& b) {
+    if (a.hits.empty() != b.hits.empty()) return a.hits.empty();
+    const int ra = detectedReads(a.hits), rb = detectedReads(b.hits);
+    if (ra != rb) return ra < rb;
+    return a.hits.size() < b.hits.size();
+}
+
+// 之後不論再讀錯哪些 read，a 的偵測都不會比 b 好 (worse 意義下)：
+// a 讀錯過的 read 都在 b 中，且讀錯的次數不多於 b
+bool noBetterThan(const Branch& a, const Branch& b) {
+    if (a.hits.size() > b.hits.size()) return false;
+    const std::vector<int> ra = failingReads(a.hits), rb = failingReads(b.hits);
+    return std::includes(rb.begin(), rb.end(), ra.begin(), ra.end());
+}
+
+} // namespace
+
+void SequenceExecutor::executeForked(const MarchProgram& program, IFault& fault) {
+    MemoryState& mem = fault.memory();
+    std::vector<Branch> branches(1);
+    branches[0].live = true;
+
+    auto save = [&](Branch& b) {
+        if (b.mem) b.mem->restore(mem);
+        else       b.mem = mem.clone();
+        b.state = fault.saveState();
+    };
+    // 把 b 載入 fault 的記憶體 (先保存目前 live 的分支)
+    auto activate = [&](Branch& b) {
+        if (b.live) return;
+        for (Branch& other : branches) {
+            if (!other.live) continue;
+            save(other);
+            other.live = false;
+        }
+        mem.restore(*b.mem);
+        fault.restoreState(b.state);
+        b.live = true;
+    };
+    auto sameState = [&](const Branch& a, const Branch& b) {
+        const FaultForkState sa = a.live ? fault.saveState() : a.state;
+        const FaultForkState sb = b.live ? fault.saveState() : b.state;
+        return sa == sb && (a.live ? mem : *a.mem).sameContents(b.live ? mem : *b.mem);
+    };
+
+    for (int e = 0; e < program.elementCount(); ++e) {
+        const SimTime start = clock_.now(); // 每條路徑的操作數相同，element 結束時的時間也相同
+        if (!program.both(e)) {
+            for (Branch& b : branches) {
+                activate(b);
+                clock_.rewind(start);
+                BranchCollector collector(b.hits);
+                runElement(program, e, fault, collector, false);
+            }
+        } else {
+            // 每個分支分成 ⇑ (新分支) 與 ⇓ (沿用原分支)
+            std::vector<Branch> forks;
+            for (Branch& b : branches) {
+                activate(b);
+                clock_.rewind(start); // 前一個分支的 ⇓ 已把時鐘推到 element 結尾
+                save(b);
+                Branch asc;
+                asc.hits = b.hits;
+                BranchCollector ascCollector(asc.hits);
+                runElement(program, e, fault, ascCollector, false);
+                save(asc);
+
+                mem.restore(*b.mem);
+                fault.restoreState(b.state);
+                clock_.rewind(start);
+                BranchCollector descCollector(b.hits);
+                runElement(program, e, fault, descCollector, true);
+                forks.push_back(std::move(asc));
+            }
+            // ⇑ 排在前面：偵測相同時保留 ⇑ (與沒有分岔時的結果一致)
+            for (Branch& b : branches) forks.push_back(std::move(b));
+            branches = std::move(forks);
+        }
+
+        // 狀態相同的分支之後讀錯的 read 也相同；只有其中一個的偵測之後怎樣都不會比另一個好時
+        // 才合併 (保留它)，否則兩個都留到最後再比較。相同時保留前面的 (⇑)
+        for (std::size_t i = 0; i < branches.size(); ++i) {
+            for (std::size_t j = i + 1; j < branches.size();) {
+                if (!sameState(branches[i], branches[j])) {
+                    ++j;
+                    continue;
+                }
+                const bool keepI = noBetterThan(branches[i], branches[j]);
+                if (!keepI && !noBetterThan(branches[j], branches[i])) {
+                    ++j;
+                    continue;
+                }
+                if (!keepI) branches[i].hits = std::move(branches[j].hits);
+                branches[i].live = branches[i].live || branches[j].live;
+                branches.erase(branches.begin() + j);
+            }
+        }
+        peakBranches_ = std::max(peakBranches_, static_cast<int>(branches.size()));
+    }
+
+    std::size_t worst = 0;
+    for (std::size_t k = 1; k < branches.size(); ++k)
+        if (worse(branches[k], branches[worst])) worst = k;
+    activate(branches[worst]);
+    for (int b = 0; b < program.readCount(); ++b) collector_.opRecord(program.readIndex(b), -1, false);
+    for (const Hit& h : branches[worst].hits) collector_.opRecord(h.idx, h.addr, true);
+}
+
+// === WordSequenceExecutor ===
+void WordSequenceExecutor::execute(const std::vector<MarchElement>& marchTest, WordLaneFault& fault) {
+    const int size = mem_.size();
+    for (const auto& elem : marchTest) {
+        fault.reset();
+        if (elem.addrOrder_ == Direction::DESC) {
+            for (int addr = size - 1; addr >= 0; --addr) processElementAtAddr(elem, fault, addr);
+        } else {
+            for (int addr = 0; addr < size; ++addr) processElementAtAddr(elem, fault, addr);
+        }
+    }
+}
+
+void WordSequenceExecutor::processElementAtAddr(const MarchElement& elem, WordLaneFault& fault, int addr) {
     for (const auto& op : elem.ops_) {
+        const uint64_t data = mem_.pattern(addr, op.op_.value_ == 1);
         if (op.op_.type_ == OpType::R) {
-            // Read operation
-            int value = fault.readProcess(mem_idx, op.op_);
-            if (value != op.op_.value_) {
-                collector_.opRecord(op.idx_, mem_idx, true); // Record detection
-            } else {
-                collector_.opRecord(op.idx_, mem_idx, false); // Record no detection
-            }
+            uint64_t lanes = 0;
+            for (int t = 0; t < op.op_.repeat_; ++t) lanes |= fault.readProcess(addr, data);
+            collector_.opRecord(op.idx_, addr, lanes);
         } else if (op.op_.type_ == OpType::W) {
-            // Write operation
-            fault.writeProcess(mem_idx, op.op_);
+            for (int t = 0; t < op.op_.repeat_; ++t) fault.writeProcess(addr, data);
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,54 @@
+#include "../include/Shard.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include "../include/Checkpoint.hpp"
+
+ShardSpec ShardSpec::parse(const std::string& text) {
+    const auto slash = text.find('/');
+    ShardSpec spec;
+    try {
+        if (slash == std::string::npos) throw std::invalid_argument(text);
+        std::size_t used = 0;
+        spec.index = std::stoul(text.substr(0, slash), &used);
+        if (used != slash) throw std::invalid_argument(text);
+        spec.count = std::stoul(text.substr(slash + 1), &used);
+        if (used != text.size() - slash - 1) throw std::invalid_argument(text);
+    } catch (const std::exception&) {
+        throw std::invalid_argument("--shard 格式應為 K/N，例如 0/4：" + text);
+    }
+    if (spec.count == 0 || spec.index >= spec.count)
+        throw std::invalid_argument("--shard 的 K 須介於 0 與 N-1 之間：" + text);
+    return spec;
+}
+
+std::pair<std::size_t, std::size_t> ShardSpec::range(std::size_t faults) const {
+    const std::size_t q = faults / count, r = faults % count;
+    const std::size_t first = q * index + std::min(index, r);
+    return { first, first + q + (index < r ? 1 : 0) };
+}
+
+void mergeShards(const std::vector<std::string>& files, const std::string& job,
+                 const std::vector<MarchElement>& marchTest, ResultStore& merged) {
+    if (files.empty()) throw std::runtime_error("沒有指定要合併的 shard");
+    const std::size_t count = files.size();
+    std::vector<bool> seen(count, false);
+    for (const auto& file : files) {
+        const CheckpointState state = CheckpointState::load(CheckpointWriter::statePath(file));
+        // 依 job 摘要找出這是第幾個 shard
+        std::size_t index = count;
+        for (std::size_t k = 0; k < count && index == count; ++k)
+            if (state.job == ShardSpec{ k, count }.tag(job)) index = k;
+        if (index == count)
+            throw std::runtime_error("shard 的參數與本次不符或 shard 數不是 " + std::to_string(count)
+                                     + ": " + file + " (" + state.job + ")");
+        if (seen[index]) throw std::runtime_error("shard " + ShardSpec{ index, count }.toString() + " 重複: " + file);
+        if (!state.cursor.finished())
+            throw std::runtime_error("shard 尚未跑完，請以 --resume 繼續: " + file);
+        seen[index] = true;
+
+        const ResultStore shard = ResultStore::reopen(file, merged.faultCount(), marchTest);
+        const auto [first, last] = ShardSpec{ index, count }.range(merged.faultCount());
+        merged.copyRows(shard, first, last);
+    }
+}
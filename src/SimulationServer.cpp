@@ -0,0 +1,508 @@
+#include "../include/SimulationServer.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include "../include/AddressOrder.hpp"
+#include "../include/BoundedQueue.hpp"
+#include "../include/FaultSimulator.hpp"
+#include "../include/MarchLibrary.hpp"
+#include "../include/Parser.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using nlohmann::json;
+
+namespace {
+
+double millis(SimulationServer::Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+std::string dumpLine(const json& j) {
+    // 檔名等字串不一定是合法的 UTF-8，以替代字元輸出而不是讓整個回覆失敗
+    return j.dump(-1, ' ', false, json::error_handler_t::replace);
+}
+
+json failure(const json& job, const std::string& message) {
+    json reply;
+    reply["id"] = job.is_object() && job.contains("id") ? job["id"] : json();
+    reply["ok"] = false;
+    reply["error"] = message;
+    return reply;
+}
+
+std::filesystem::file_time_type modified(const std::string& path) {
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) throw std::runtime_error("無法開啟檔案: " + path);
+    return time;
+}
+
+std::string stringField(const json& job, const char* key) {
+    const auto it = job.find(key);
+    if (it == job.end() || !it->is_string())
+        throw std::invalid_argument(std::string("job 的 \"") + key + "\" 必須是字串");
+    return it->get<std::string>();
+}
+
+} // namespace
+
+// ────────────────────────────────────────────────
+// 回覆的輸出端：多個 worker 同時完成時以 mutex 保證每行完整
+// ────────────────────────────────────────────────
+class SimulationServer::Channel {
+public:
+    virtual ~Channel() = default;
+    virtual void send(const std::string& line) = 0;
+};
+
+class SimulationServer::StreamChannel final : public Channel {
+public:
+    explicit StreamChannel(std::ostream& out) : out_(out) {}
+    void send(const std::string& line) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        out_ << line << '\n' << std::flush;
+    }
+private:
+    std::mutex mu_;
+    std::ostream& out_;
+};
+
+#ifndef _WIN32
+class SimulationServer::SocketChannel final : public Channel {
+public:
+    explicit SocketChannel(int fd) : fd_(fd) {}
+    // 最後一個參考 (讀取端或尚未完成的 job) 消失時才關閉連線
+    ~SocketChannel() override { ::close(fd_); }
+    int fd() const { return fd_; }
+    void send(const std::string& line) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        const std::string data = line + '\n';
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+#ifdef MSG_NOSIGNAL
+            const ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+#else
+            const ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, 0);
+#endif
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return; // client 已離開，結果丟棄
+            sent += static_cast<std::size_t>(n);
+        }
+    }
+private:
+    std::mutex mu_;
+    int fd_;
+};
+#endif
+
+// ────────────────────────────────────────────────
+// 共用的 worker pool：每個 worker 一次執行一個 job；解構時處理完佇列中剩下的 job
+// ────────────────────────────────────────────────
+struct SimulationServer::Task {
+    json job;
+    std::shared_ptr<Channel> reply;
+    Clock::time_point queued;
+};
+
+class SimulationServer::Pool {
+public:
+    Pool(SimulationServer& server, int workers, std::size_t depth) : queue_(depth) {
+        for (int w = 0; w < workers; ++w)
+            threads_.emplace_back([this, &server] {
+                // 回覆後立即放掉 task：worker 閒置時不能還持有 client 的連線
+                for (Task task; queue_.pop(task); task = {})
+                    task.reply->send(dumpLine(server.execute(task.job, task.queued)));
+            });
+    }
+    ~Pool() {
+        queue_.close();
+        for (auto& t : threads_) t.join();
+    }
+    void push(Task task) { queue_.push(std::move(task)); }
+
+private:
+    BoundedQueue<Task> queue_;
+    std::vector<std::thread> threads_;
+};
+
+// === SimulationServer ===
+SimulationServer::SimulationServer(ServerOptions options) : opt_(options) {
+    if (opt_.rows <= 0 || opt_.cols <= 0)
+        throw std::invalid_argument("Row and column dimensions must be positive integers.");
+}
+
+SimulationServer::~SimulationServer() = default;
+
+int SimulationServer::workerCount() const {
+    if (opt_.workers > 0) return opt_.workers;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::string SimulationServer::handle(const std::string& line) {
+    const auto queued = Clock::now();
+    json job;
+    try {
+        job = json::parse(line);
+    } catch (const json::exception& e) {
+        ++jobs_;
+        ++failed_;
+        return dumpLine(failure(job, std::string("JSON 格式錯誤: ") + e.what()));
+    }
+    return dumpLine(execute(job, queued));
+}
+
+bool SimulationServer::dispatch(const std::string& line, const std::shared_ptr<Channel>& reply, Pool& pool,
+                                json& stopJob) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) return true;
+    const auto queued = Clock::now();
+    json job;
+    try {
+        job = json::parse(line);
+    } catch (const json::exception& e) {
+        ++jobs_;
+        ++failed_;
+        reply->send(dumpLine(failure(job, std::string("JSON 格式錯誤: ") + e.what())));
+        return true;
+    }
+    if (job.is_object() && job.value("cmd", "") == "shutdown") {
+        stopJob = job;
+        return false;
+    }
+    pool.push({ std::move(job), reply, queued });
+    return true;
+}
+
+json SimulationServer::execute(const json& job, Clock::time_point queued) {
+    ++jobs_;
+    try {
+        if (!job.is_object()) throw std::invalid_argument("job 必須是 JSON object");
+        const auto cmd = job.find("cmd");
+        if (cmd == job.end() || *cmd == "simulate") return simulate(job, queued);
+        if (!cmd->is_string()) throw std::invalid_argument("job 的 \"cmd\" 必須是字串");
+        return control(cmd->get<std::string>(), job);
+    } catch (const std::exception& e) {
+        ++failed_;
+        return failure(job, e.what());
+    }
+}
+
+json SimulationServer::control(const std::string& cmd, const json& job) {
+    json reply;
+    reply["id"] = job.contains("id") ? job["id"] : json();
+    reply["ok"] = true;
+    reply["cmd"] = cmd;
+    if (cmd == "ping" || cmd == "shutdown") return reply;
+    if (cmd == "stats") {
+        std::lock_guard<std::mutex> lock(cacheMu_);
+        std::size_t programs = 0;
+        for (const auto& [key, entry] : marches_) programs += entry.programs.size();
+        reply["jobs"] = jobs_.load();
+        reply["failed"] = failed_.load();
+        reply["workers"] = workerCount();
+        reply["cached"] = { { "libraries", libraries_.size() }, { "marches", marches_.size() },
+                            { "programs", programs } };
+        return reply;
+    }
+    if (cmd == "list_marches") {
+        // 與互動選單 (Parser::parseMarchTest_menu) 相同的清單；沒有指定檔案時列出內建 test
+        std::vector<std::string> names;
+        if (job.contains("file")) {
+            names = Parser().marchTestNames(stringField(job, "file"));
+        } else {
+            for (const auto& test : MarchLibrary::kTests) names.emplace_back("builtin:" + std::string(test.name));
+        }
+        reply["marches"] = names;
+        return reply;
+    }
+    if (cmd == "evict") {
+        std::lock_guard<std::mutex> lock(cacheMu_);
+        libraries_.clear();
+        marches_.clear();
+        return reply;
+    }
+    throw std::invalid_argument("未知的指令: " + cmd);
+}
+
+json SimulationServer::simulate(const json& job, Clock::time_point queued) {
+    const auto started = Clock::now();
+    const int rows = job.value("rows", opt_.rows);
+    const int cols = job.value("cols", opt_.cols);
+    const int seed = job.value("seed", opt_.seed);
+    if (rows <= 0 || cols <= 0)
+        throw std::invalid_argument("Row and column dimensions must be positive integers.");
+
+    bool libraryHit = false, marchHit = false, programHit = false;
+    const auto lib = library(stringField(job, "faults"), libraryHit);
+    std::string key;
+    const auto elements = march(job, key, marchHit);
+    const auto prog = program(key, elements, rows, cols, programHit);
+
+    // family：只模擬這些名稱的 fault (字串或字串 array)
+    std::vector<FaultConfig> selected;
+    const std::vector<FaultConfig>* faults = &lib->faults();
+    if (job.contains("family")) {
+        std::set<std::string> names;
+        const json& family = job["family"];
+        if (family.is_string()) {
+            names.insert(family.get<std::string>());
+        } else if (family.is_array()) {
+            for (const auto& name : family) names.insert(name.get<std::string>());
+        } else {
+            throw std::invalid_argument("job 的 \"family\" 必須是字串或字串 array");
+        }
+        for (const auto& fault : *lib)
+            if (names.count(fault.id_.faultName_.str())) selected.push_back(fault);
+        faults = &selected;
+    }
+    if (faults->empty()) throw std::invalid_argument("沒有要模擬的 fault");
+    const auto loaded = Clock::now();
+
+    ResultStore results(faults->size(), *elements);
+    OneByOneFaultSimulator faultSim(*faults, *elements, prog, rows, cols, seed, results);
+    if (job.value("analytical", false)) faultSim.setAnalyticalMode(AnalyticalMode::FastPath);
+    faultSim.setSymmetryReduction(job.value("symmetry", false));
+    faultSim.setMemoryKind(opt_.memoryKind);
+    faultSim.setBothDirections(job.value("both_directions", false));
+    faultSim.run();
+    const double detectedRate = faultSim.getDetectedRate();
+    if (job.contains("report"))
+        Parser().writeDetectionReport(*faults, results, detectedRate, stringField(job, "report"));
+    const auto finished = Clock::now();
+
+    json reply;
+    reply["id"] = job.contains("id") ? job["id"] : json();
+    reply["ok"] = true;
+    reply["faults"] = faults->size();
+    reply["detected"] = results.detectedCount();
+    reply["coverage"] = detectedRate;
+    if (job.value("detail", false)) {
+        json rowsOut = json::array();
+        for (std::size_t i = 0; i < faults->size(); ++i) {
+            const FaultID& id = (*faults)[i].id_;
+            rowsOut.push_back({ { "fault", id.faultName_.str() }, { "subcase", id.subcaseIdx_ },
+                                { "init0", results.syndrome(i, 0).toString() },
+                                { "init1", results.syndrome(i, 1).toString() } });
+        }
+        reply["results"] = std::move(rowsOut);
+    }
+    reply["timing_ms"] = { { "queue", millis(started - queued) }, { "load", millis(loaded - started) },
+                           { "simulate", millis(finished - loaded) }, { "total", millis(finished - queued) } };
+    auto state = [](bool hit) { return hit ? "hit" : "miss"; };
+    reply["cache"] = { { "faults", state(libraryHit) }, { "march", state(marchHit) },
+                       { "program", state(programHit) } };
+    return reply;
+}
+
+// ────────────────────────────────────────────────
+// 快取：查表與插入時持有 cacheMu_，載入 (解析 JSON、編譯) 時不持有，
+// 同一個檔案同時被兩個 job 載入時只是多做一次，結果相同
+// ────────────────────────────────────────────────
+std::shared_ptr<const FaultLibrary> SimulationServer::library(const std::string& path, bool& hit) {
+    const auto mtime = modified(path);
+    {
+        std::lock_guard<std::mutex> lock(cacheMu_);
+        const auto it = libraries_.find(path);
+        if (it != libraries_.end() && it->second.mtime == mtime) {
+            hit = true;
+            return it->second.library;
+        }
+    }
+    auto loaded = std::make_shared<const FaultLibrary>(Parser().parseFaults(path));
+    std::lock_guard<std::mutex> lock(cacheMu_);
+    libraries_[path] = { mtime, loaded };
+    hit = false;
+    return loaded;
+}
+
+std::shared_ptr<const SimulationServer::March>
+SimulationServer::march(const json& job, std::string& key, bool& hit) {
+    Parser parser;
+    AddressOrder order;
+    if (job.contains("address_order")) order = AddressOrderRegistry::parse(stringField(job, "address_order"));
+    parser.setDefaultAddressOrder(order);
+
+    // 來源：pattern 字串、March test 庫中的一筆，或單一檔案 / builtin:NAME (與命令列相同)
+    std::string file;
+    std::function<March()> load;
+    if (job.contains("pattern")) {
+        const std::string pattern = stringField(job, "pattern");
+        key = "pattern:" + pattern;
+        load = [&parser, pattern] { return parser.parseMarchPattern(pattern); };
+    } else if (job.contains("march_library")) {
+        file = stringField(job, "march_library");
+        const std::string name = stringField(job, "march_name");
+        key = "library:" + file + "#" + name;
+        load = [&parser, file, name] { return parser.parseMarchTest(file, name); };
+    } else if (job.contains("march")) {
+        const std::string spec = stringField(job, "march");
+        if (spec.rfind("builtin:", 0) != 0) file = spec;
+        key = "march:" + spec;
+        load = [&parser, spec] { return parser.parseMarchTest(spec); };
+    } else {
+        throw std::invalid_argument("job 缺少 March test (\"march\"、\"pattern\" 或 \"march_library\")");
+    }
+    key += " | order " + order.toString();
+
+    const auto mtime = file.empty() ? std::filesystem::file_time_type{} : modified(file);
+    {
+        std::lock_guard<std::mutex> lock(cacheMu_);
+        const auto it = marches_.find(key);
+        if (it != marches_.end() && it->second.mtime == mtime) {
+            hit = true;
+            return it->second.elements;
+        }
+    }
+    auto loaded = std::make_shared<const March>(load());
+    std::lock_guard<std::mutex> lock(cacheMu_);
+    marches_[key] = { mtime, loaded, {} };
+    hit = false;
+    return loaded;
+}
+
+std::shared_ptr<const MarchProgram>
+SimulationServer::program(const std::string& key, const std::shared_ptr<const March>& elements,
+                          int rows, int cols, bool& hit) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMu_);
+        const auto it = marches_.find(key);
+        if (it != marches_.end() && it->second.elements == elements) {
+            const auto prog = it->second.programs.find({ rows, cols });
+            if (prog != it->second.programs.end()) {
+                hit = true;
+                return prog->second;
+            }
+        }
+    }
+    auto compiled = std::make_shared<const MarchProgram>(*elements, rows, cols);
+    std::lock_guard<std::mutex> lock(cacheMu_);
+    // 編譯期間 March test 被重新載入時不放入快取 (這個 program 屬於舊的版本)
+    const auto it = marches_.find(key);
+    if (it != marches_.end() && it->second.elements == elements) it->second.programs[{ rows, cols }] = compiled;
+    hit = false;
+    return compiled;
+}
+
+// ────────────────────────────────────────────────
+// 傳輸端
+// ────────────────────────────────────────────────
+void SimulationServer::serve(std::istream& in, std::ostream& out) {
+    const auto reply = std::make_shared<StreamChannel>(out);
+    json stopJob;
+    bool shutdown = false;
+    {
+        Pool pool(*this, workerCount(), opt_.queueDepth);
+        for (std::string line; !stopping_ && std::getline(in, line);)
+            if (!dispatch(line, reply, pool, stopJob)) {
+                shutdown = true;
+                break;
+            }
+    } // 等 pool 處理完已排入的 job
+    if (shutdown) reply->send(dumpLine(execute(stopJob, Clock::now())));
+}
+
+#ifdef _WIN32
+void SimulationServer::serveUnix(const std::string&) {
+    throw std::runtime_error("此平台不支援 Unix domain socket，請改用 --serve (stdin / stdout)");
+}
+#else
+void SimulationServer::serveUnix(const std::string& path) {
+    sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        throw std::invalid_argument("socket 路徑長度不符: " + path);
+    std::copy(path.begin(), path.end(), addr.sun_path);
+
+    // 上次未正常結束留下的 socket 檔可以覆蓋，其他檔案不動
+    struct stat st {};
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) throw std::runtime_error("已存在同名的檔案: " + path);
+        ::unlink(path.c_str());
+    }
+    const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) throw std::runtime_error("無法建立 socket");
+    if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(listenFd, 16) != 0) {
+        ::close(listenFd);
+        throw std::runtime_error("無法在 " + path + " 上等待連線");
+    }
+
+    struct Connection {
+        std::shared_ptr<SocketChannel> channel;
+        std::thread reader;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+    std::vector<Connection> connections;
+    std::mutex stopMu;
+    json stopJob;
+    std::shared_ptr<Channel> stopReply;
+    {
+        Pool pool(*this, workerCount(), opt_.queueDepth);
+        while (!stopping_) {
+            // 已結束的連線先回收
+            for (auto it = connections.begin(); it != connections.end();) {
+                if (!*it->done) { ++it; continue; }
+                it->reader.join();
+                it = connections.erase(it);
+            }
+            pollfd pfd { listenFd, POLLIN, 0 };
+            if (::poll(&pfd, 1, 200) <= 0) continue; // timeout / EINTR：重新檢查 stopping_
+            const int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) continue;
+
+            Connection conn { std::make_shared<SocketChannel>(fd), {}, std::make_shared<std::atomic<bool>>(false) };
+            conn.reader = std::thread([this, &pool, &stopMu, &stopJob, &stopReply,
+                                       channel = conn.channel, done = conn.done] {
+                std::string buffer;
+                char chunk[4096];
+                json job;
+                bool open = true;
+                while (open && !stopping_) {
+                    const ssize_t n = ::recv(channel->fd(), chunk, sizeof(chunk), 0);
+                    if (n < 0 && errno == EINTR) continue;
+                    if (n <= 0) {
+                        // EOF：最後一行可以沒有換行
+                        open = false;
+                        buffer += '\n';
+                    } else {
+                        buffer.append(chunk, static_cast<std::size_t>(n));
+                    }
+                    std::size_t begin = 0;
+                    for (std::size_t nl; (nl = buffer.find('\n', begin)) != std::string::npos; begin = nl + 1) {
+                        if (dispatch(buffer.substr(begin, nl - begin), channel, pool, job)) continue;
+                        std::lock_guard<std::mutex> lock(stopMu);
+                        if (!stopReply) {
+                            stopJob = job;
+                            stopReply = channel;
+                        }
+                        stopping_ = true;
+                        open = false;
+                        break;
+                    }
+                    buffer.erase(0, begin);
+                }
+                *done = true;
+            });
+            connections.push_back(std::move(conn));
+        }
+        ::close(listenFd);
+        ::unlink(path.c_str());
+        // 讓還在等待資料的連線結束讀取；已排入的 job 仍會完成並回覆
+        for (auto& conn : connections) ::shutdown(conn.channel->fd(), SHUT_RD);
+        for (auto& conn : connections) conn.reader.join();
+    }
+    if (stopReply) stopReply->send(dumpLine(execute(stopJob, Clock::now())));
+}
+#endif
@@ -0,0 +1,111 @@
+#include "../include/SymmetryReducer.hpp"
+#include <algorithm>
+
+SymmetryReducer::SymmetryReducer(const std::vector<MarchElement>& marchTest, int memorySize)
+    : filter_(marchTest), memSize_(memorySize) {
+    for (const auto& elem : marchTest)
+        if (!elem.order_.linear()) linearOrder_ = false;
+    if (!marchTest.empty()) {
+        bool hasWrite = false, hasRead = false;
+        for (const auto& pop : marchTest.front().ops_) {
+            if (pop.op_.type_ == OpType::W) hasWrite = true;
+            if (pop.op_.type_ == OpType::R) hasRead = true;
+        }
+        firstElemWriteOnly_ = hasWrite && !hasRead;
+    }
+}
+
+bool SymmetryReducer::backgroundIndependent(const FaultConfig& cfg) const {
+    if (!firstElemWriteOnly_) return false;
+    // SensitizationFilter 的視窗比對是保守的：回傳 false 保證不會觸發
+    return !filter_.canTriggerInElement(cfg, 0, 0) && !filter_.canTriggerInElement(cfg, 1, 0);
+}
+
+SymmetryReducer::OrbitKey SymmetryReducer::orbitKey(const FaultConfig& cfg, int initValue,
+                                                    int aggrAddr, int vicAddr) const {
+    OrbitKey key;
+    key.reserve(16 + 3 * cfg.trigger_.size());
+    // fault 語意 (單 cell fault 不看 aggressor 相關欄位)
+    key.push_back(cfg.is_twoCell_);
+    if (cfg.is_twoCell_) {
+        key.push_back(static_cast<int>(cfg.twoCellFaultType_));
+        key.push_back(cfg.AI_);
+    }
+    key.push_back(cfg.VI_);
+    key.push_back(cfg.faultValue_);
+    key.push_back(cfg.finalReadValue_);
+    key.push_back(static_cast<int>(cfg.trigger_.size()));
+    for (const auto& op : cfg.trigger_) {
+        key.push_back(static_cast<int>(op.type_));
+        key.push_back(op.value_);
+        key.push_back(op.repeat_);
+    }
+
+    key.push_back(backgroundIndependent(cfg) ? -1 : (initValue & 1));
+
+    if (!linearOrder_) {
+        key.push_back(aggrAddr);
+        key.push_back(vicAddr);
+        return key;
+    }
+    // 位址形狀：A / V 先後，以及之前 / 之間 / 之後三段是否為空
+    const int lo = cfg.is_twoCell_ ? std::min(aggrAddr, vicAddr) : vicAddr;
+    const int hi = cfg.is_twoCell_ ? std::max(aggrAddr, vicAddr) : vicAddr;
+    if (cfg.is_twoCell_) key.push_back(aggrAddr < vicAddr);
+    key.push_back(lo > 0);
+    key.push_back(hi - lo > 1);
+    key.push_back(hi < memSize_ - 1);
+    return key;
+}
+
+bool SymmetryReducer::derive(const OrbitKey& key, int aggrAddr, int vicAddr, DetectionReport& out) {
+    auto it = orbits_.find(key);
+    if (it == orbits_.end()) return false;
+    const Representative& rep = it->second;
+
+    out.isDetected_ = rep.report.isDetected_;
+    out.detected_   = rep.report.detected_;
+    out.detectedVicAddrs_.clear();
+
+    // 代表中被偵測到的段，整段對應到目前的位址
+    bool hitSeg[5] = {false, false, false, false, false};
+    for (int addr : rep.report.detectedVicAddrs_) {
+        hitSeg[segmentOf(addr, rep.aggrAddr, rep.vicAddr)] = true;
+    }
+    for (int seg = 0; seg < 5; ++seg) {
+        if (!hitSeg[seg]) continue;
+        auto range = segmentRange(seg, aggrAddr, vicAddr);
+        for (int addr = range.first; addr < range.second; ++addr) {
+            out.detectedVicAddrs_.insert(addr);
+        }
+    }
+    ++derived_;
+    return true;
+}
+
+void SymmetryReducer::record(const OrbitKey& key, int aggrAddr, int vicAddr,
+                             const DetectionReport& report) {
+    orbits_.emplace(key, Representative{report, aggrAddr, vicAddr});
+}
+
+int SymmetryReducer::segmentOf(int addr, int aggrAddr, int vicAddr) {
+    const int lo = (aggrAddr < 0) ? vicAddr : std::min(aggrAddr, vicAddr);
+    const int hi = std::max(aggrAddr, vicAddr);
+    if (addr < lo)  return 0;
+    if (addr == lo) return 1;
+    if (addr < hi)  return 2;
+    if (addr == hi) return 3;
+    return 4;
+}
+
+std::pair<int, int> SymmetryReducer::segmentRange(int seg, int aggrAddr, int vicAddr) const {
+    const int lo = (aggrAddr < 0) ? vicAddr : std::min(aggrAddr, vicAddr);
+    const int hi = std::max(aggrAddr, vicAddr);
+    switch (seg) {
+        case 0:  return { 0, lo };
+        case 1:  return { lo, lo + 1 };
+        case 2:  return { lo + 1, hi };
+        case 3:  return (hi == lo) ? std::make_pair(hi, hi) : std::make_pair(hi, hi + 1);
+        default: return { hi + 1, memSize_ };
+    }
+}
@@ -1,42 +1,373 @@
 #include "../include/Parser.hpp"
 #include "../include/FaultSimulator.hpp"
+#include "../include/CliOptions.hpp"
+#include "../include/DiagnosticDictionary.hpp"
+#include "../include/FaultLibrary.hpp"
+#include "../include/Pipeline.hpp"
+#include "../include/Shard.hpp"
+#include "../include/SimulationServer.hpp"
 #include <chrono>
+#include <csignal>
 #include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+// SIGINT / SIGTERM (例如 batch 節點被搶占)：逐一模擬在下一個 fault 完成時保存檢查點後結束
+volatile std::sig_atomic_t gStopRequested = 0;
+
+void requestStop(int) { gStopRequested = 1; }
+
+// --serve=SOCKET 時 SIGINT / SIGTERM 讓 server 停止接受連線，處理完已排入的 job 後結束
+SimulationServer* gServer = nullptr;
+
+void stopServer(int) {
+    if (gServer) gServer->stop();
+}
+
+// 會影響結果的參數摘要，檢查點與 shard 合併時比對；--symmetry / --memory 只影響速度，不列入
+std::string jobSummary(const std::vector<std::string>& args, int rows, int cols, int seed, const CliOptions& opts) {
+    std::ostringstream job;
+    job << args[0] << " | " << args[1] << " | " << rows << "x" << cols << " seed " << seed
+        << " | order " << opts.get("address-order", "linear")
+        << (opts.has("cross-check") ? " cross-check" : opts.has("analytical") ? " analytical" : "")
+        << (opts.has("both-directions") ? " both-directions" : "");
+    return job.str();
+}
+
+} // namespace
 
 int main(int argc, char* argv[])
 {
-    if (argc < 4) {
-        std::cerr << "Usage: " << argv[0] << 
-        " <faults.json> <marchTest.json> <detection_report.txt>\n";
+    CliOptions opts(argc, argv);
+    const auto& args = opts.positional();
+    if (opts.has("lookup")) {
+        // 診斷查詢：載入已保存的字典，不需重新模擬
+        try {
+            const auto dict = DiagnosticDictionary::load(opts.get("dictionary", "dictionary.json"));
+            std::stringstream ss(opts.get("lookup"));
+            for (std::string bits; std::getline(ss, bits, ',');) {
+                const Syndrome observed = Syndrome::fromString(bits);
+                const auto match = dict.nearest(observed);
+                std::cout << bits << ": ";
+                if (!observed.any()) {
+                    std::cout << "no failing read\n";
+                    continue;
+                }
+                if (match.distance < 0) {
+                    std::cout << "no match\n";
+                    continue;
+                }
+                std::cout << (match.distance == 0 ? "exact" : "distance " + std::to_string(match.distance));
+                for (int f : match.faults)
+                    std::cout << "\n  " << dict.faultId(f).faultName_ << " Subcase " << dict.faultId(f).subcaseIdx_;
+                std::cout << "\n";
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (opts.has("serve")) {
+        // 常駐模式：fault library 與 March test 留在記憶體中，由 JSON lines 接收 job
+        try {
+            ServerOptions so;
+            so.workers    = opts.getInt("threads", 0);
+            so.queueDepth = static_cast<std::size_t>(opts.getInt("queue-depth", 64));
+            const std::string memory = opts.get("memory", "auto");
+            if (memory == "dense")      so.memoryKind = MemoryKind::Dense;
+            else if (memory == "paged") so.memoryKind = MemoryKind::Paged;
+            else if (memory != "auto")
+                throw std::invalid_argument("--memory 只接受 auto / dense / paged");
+            SimulationServer server(so);
+            const std::string socketPath = opts.get("serve");
+            if (socketPath.empty()) {
+                server.serve(std::cin, std::cout);
+            } else {
+                gServer = &server;
+                std::signal(SIGINT, stopServer);
+                std::signal(SIGTERM, stopServer);
+                std::cerr << "Serving on " << socketPath << "\n";
+                server.serveUnix(socketPath);
+                gServer = nullptr;
+            }
+            std::cerr << "Served " << server.jobCount() << " job(s)\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (args.size() < 3) {
+        std::cerr << "Usage: " << argv[0] <<
+        " <faults.json> <marchTest.json | builtin:NAME> <detection_report.txt> [rows] [cols] [seed]"
+        " [--analytical | --cross-check] [--symmetry] [--spatial[=ROWSxCOLS]]"
+        " [--memory=auto|dense|paged] [--address-order=linear|gray|strideK|col|scrambleK] [--both-directions]"
+        " [--linked[=2|3] [--threads=N]]"
+        " [--word-width=N [--backgrounds=solid,checkerboard,row,column]]"
+        " [--monte-carlo[=MAX] [--tolerance=T] [--confidence=C] [--activation=P] [--threads=N]]"
+        " [--dictionary=FILE] [--csv=FILE] [--columnar=FILE] [--spill=FILE]"
+        " [--checkpoint=FILE [--checkpoint-interval=SEC] [--resume]] [--progress[=SEC]]"
+        " [--shard=K/N | --merge=SHARD,SHARD,...]"
+        " [--pipeline[=csv|ndjson] [--threads=N] [--queue-depth=N]]\n"
+        "       " << argv[0] << " --dictionary=FILE --lookup=SYNDROME[,SYNDROME...]\n"
+        "       " << argv[0] << " --serve[=SOCKET] [--threads=N] [--queue-depth=N] [--memory=auto|dense|paged]\n";
         return 1;
     }
 
     try {
         Parser parser;
-        auto faults = parser.parseFaults(argv[1]);
-        auto marchTest = parser.parseMarchTest(argv[2]);
+        if (opts.has("address-order"))
+            parser.setDefaultAddressOrder(AddressOrderRegistry::parse(opts.get("address-order")));
+        auto marchTest = parser.parseMarchTest(args[1]);
 
         int rows = 4;
         int cols = 4;
         int seed = 12345; // Default seed value
-        if (argc >= 5) {
-            rows = std::stoi(argv[4]);
+        if (args.size() >= 4) {
+            rows = std::stoi(args[3]);
         }
-        if (argc >= 6) {
-            cols = std::stoi(argv[5]);
+        if (args.size() >= 5) {
+            cols = std::stoi(args[4]);
         }
-        if (argc >= 7) {
-            seed = std::stoi(argv[6]);
+        if (args.size() >= 6) {
+            seed = std::stoi(args[5]);
         }
         if (rows <= 0 || cols <= 0) {
             throw std::invalid_argument("Row and column dimensions must be positive integers.");
         }
 
+        MemoryKind memoryKind = MemoryKind::Auto;
+        const std::string memory = opts.get("memory", "auto");
+        if (memory == "dense")      memoryKind = MemoryKind::Dense;
+        else if (memory == "paged") memoryKind = MemoryKind::Paged;
+        else if (memory != "auto")
+            throw std::invalid_argument("--memory 只接受 auto / dense / paged");
+
+        // ⇕ 兩個方向分岔只在逐一模擬 (含 pipeline) 中實作
+        const bool bothDirections = opts.has("both-directions");
+        if (bothDirections && (opts.has("word-width") || opts.has("monte-carlo") || opts.has("linked")
+                               || opts.has("spatial")))
+            throw std::invalid_argument("--both-directions 只能用於逐一模擬或 --pipeline");
+        // 結果表只有逐一 / 空間平行模擬使用
+        if (opts.has("spill") && (opts.has("word-width") || opts.has("monte-carlo") || opts.has("linked")
+                                  || opts.has("pipeline")))
+            throw std::invalid_argument("--spill 只能用於逐一模擬或 --spatial");
+        // --shard=K/N：只計算第 K 段 fault，輸出檔 (第三個參數) 即為此 shard 的結果檔與檢查點；
+        // --merge 再把 N 個結果檔合併成與不分 shard 相同的報告
+        const bool sharded = opts.has("shard");
+        const ShardSpec shard = sharded ? ShardSpec::parse(opts.get("shard")) : ShardSpec{};
+        const bool merging = opts.has("merge");
+        if ((opts.has("checkpoint") || opts.has("resume") || opts.has("progress") || sharded || merging)
+            && (opts.has("word-width") || opts.has("monte-carlo") || opts.has("linked")
+                || opts.has("pipeline") || opts.has("spatial")))
+            throw std::invalid_argument("--checkpoint / --resume / --progress / --shard / --merge 只能用於逐一模擬");
+        if (sharded && (merging || opts.has("checkpoint") || opts.has("spill") || opts.has("csv")
+                        || opts.has("columnar") || opts.has("dictionary")))
+            throw std::invalid_argument("--shard 的輸出檔即為結果檔；報告請在 --merge 時產生");
+        if (merging && (opts.has("checkpoint") || opts.has("resume") || opts.has("progress")))
+            throw std::invalid_argument("--merge 不模擬，不可搭配 --checkpoint / --resume / --progress");
+        // 檢查點：結果放在 FILE (與 --spill 相同的 mmap 檔)，進度與亂數狀態放在 FILE.ckpt
+        const std::string checkpointFile = sharded ? args[2] : opts.get("checkpoint");
+        const bool resume = opts.has("resume");
+        if (opts.has("checkpoint") && checkpointFile.empty())
+            throw std::invalid_argument("--checkpoint 需要指定檔案，例如 --checkpoint=run.res");
+        if (resume && checkpointFile.empty())
+            throw std::invalid_argument("--resume 需要搭配 --checkpoint=FILE 或 --shard");
+        if (!checkpointFile.empty() && opts.has("spill"))
+            throw std::invalid_argument("--checkpoint 已將結果放在 spill 檔，不可再指定 --spill");
+
         // 開始計時
         auto start = std::chrono::high_resolution_clock::now();
 
-        OneByOneFaultSimulator faultSim(faults, marchTest, rows, cols, seed);
-        faultSim.run();
+        if (opts.has("pipeline")) {
+            // 串流模式：邊讀 fault 邊模擬，結果依序寫成 CSV / NDJSON，不保留整個 fault library
+            PipelineOptions po;
+            po.rows = rows;
+            po.cols = cols;
+            po.seed = static_cast<uint64_t>(seed);
+            po.workers = opts.getInt("threads", 0);
+            po.queueDepth = static_cast<std::size_t>(opts.getInt("queue-depth", 64));
+            po.memoryKind = memoryKind;
+            po.bothDirections = bothDirections;
+            std::string format = opts.get("pipeline");
+            if (format.empty()) {
+                const std::string& out = args[2];
+                const bool json = out.ends_with(".ndjson") || out.ends_with(".jsonl") || out.ends_with(".json");
+                format = json ? "ndjson" : "csv";
+            }
+            if (format == "ndjson")   po.format = StreamFormat::NdJson;
+            else if (format != "csv") throw std::invalid_argument("--pipeline 只接受 csv / ndjson");
+            SimulationPipeline pipeline(marchTest, po);
+            const PipelineStats stats = pipeline.run(args[0], args[2]);
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+            std::cout << "Pipeline: " << stats.faults << " faults, peak " << stats.peakInFlight
+                      << " in flight (window " << pipeline.window() << ")\n";
+            std::cout << "Detected Rate: " << stats.detectedRate() * 100 << "%\n";
+            std::cout << "Execution time: " << duration.count() << " ms\n";
+            return 0;
+        }
+
+        // fault library 建立後不再修改，模擬結果另外放在 ResultStore
+        const FaultLibrary library(parser.parseFaults(args[0]));
+        const auto& faults = library.faults();
+        double detectedRate = 0.0;
+        if (opts.has("word-width")) {
+            // Word-oriented 模擬：rows x cols 個 word，每個 background 各跑一次
+            auto backgrounds = parseDataBackgrounds(opts.get("backgrounds", "solid,checkerboard,row,column"));
+            WordFaultSimulator faultSim(faults, marchTest, rows, cols, opts.getInt("word-width", 32), backgrounds);
+            faultSim.run();
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+            std::cout << "Execution time: " << duration.count() << " ms\n";
+            parser.writeWordDetectionReport(faults, faultSim.reports(), faultSim.backgrounds(),
+                                            faultSim.width(), faultSim.getDetectedRate(), args[2]);
+            return 0;
+        }
+        if (opts.has("monte-carlo")) {
+            // Monte-Carlo 估計：隨機擺放 / power-up 內容，信賴區間夠窄即提早停止
+            MonteCarloOptions mc;
+            mc.maxSamples = opts.getInt("monte-carlo", mc.maxSamples);
+            mc.tolerance  = opts.getDouble("tolerance", mc.tolerance);
+            mc.confidence = opts.getDouble("confidence", mc.confidence);
+            mc.activation = opts.getDouble("activation", mc.activation);
+            mc.threads    = opts.getInt("threads", 0);
+            mc.seed       = static_cast<uint64_t>(seed);
+            MonteCarloSimulator faultSim(faults, marchTest, rows, cols, mc);
+            faultSim.setMemoryKind(memoryKind);
+            faultSim.run();
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+            long long samples = 0;
+            for (const auto& r : faultSim.reports()) samples += r.samples_;
+            std::cout << "Monte-Carlo samples: " << samples << "\n";
+            std::cout << "Execution time: " << duration.count() << " ms\n";
+            parser.writeMonteCarloReport(faults, faultSim.reports(), faultSim.options(),
+                                         faultSim.getDetectedRate(), args[2]);
+            return 0;
+        }
+        if (opts.has("linked")) {
+            // Linked fault 模擬：列舉共用 victim 的 fault 組合
+            LinkedFaultSimulator faultSim(faults, marchTest, rows, cols,
+                                          opts.getInt("linked", 2), opts.getInt("threads", 0));
+            faultSim.run();
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+            std::cout << "Linked combinations: " << faultSim.reports().size() << " simulated, "
+                      << faultSim.prunedCount() << " pruned\n";
+            std::cout << "Execution time: " << duration.count() << " ms\n";
+            parser.writeLinkedDetectionReport(faults, faultSim.reports(), faultSim.order(),
+                                              faultSim.candidateCount(), faultSim.getDetectedRate(), args[2]);
+            return 0;
+        }
+        // --spill：結果表放在 mmap 的檔案中，百萬 fault 等級的 library 不需把結果留在 heap；
+        // --resume 則沿用上次的檔案與其中已完成的結果
+        const std::string job = jobSummary(args, rows, cols, seed, opts);
+        ResultStore results = resume
+            ? ResultStore::reopen(checkpointFile, faults.size(), marchTest)
+            : ResultStore(faults.size(), marchTest, checkpointFile.empty() ? opts.get("spill") : checkpointFile);
+        if (merging) {
+            // 合併 shard：不模擬，直接讀取各 shard 的結果檔
+            std::vector<std::string> files;
+            std::stringstream ss(opts.get("merge"));
+            for (std::string file; std::getline(ss, file, ',');)
+                if (!file.empty()) files.push_back(file);
+            mergeShards(files, job, marchTest, results);
+            detectedRate = static_cast<double>(results.detectedCount()) / (faults.size() * 2);
+            std::cout << "Merged " << files.size() << " shards\n";
+        } else if (opts.has("spatial")) {
+            // 空間平行模式：一塊大記憶體同時放入多個 fault (預設 64x64)
+            int spatialRows = 64, spatialCols = 64;
+            const std::string geom = opts.get("spatial");
+            if (!geom.empty()) {
+                auto x = geom.find('x');
+                if (x == std::string::npos)
+                    throw std::invalid_argument("--spatial 格式應為 ROWSxCOLS，例如 64x64");
+                spatialRows = std::stoi(geom.substr(0, x));
+                spatialCols = std::stoi(geom.substr(x + 1));
+            }
+            SpatialFaultSimulator faultSim(faults, marchTest, spatialRows, spatialCols, results);
+            faultSim.setMemoryKind(memoryKind);
+            faultSim.run();
+            detectedRate = faultSim.getDetectedRate();
+            std::cout << "Spatial batches: " << faultSim.batchCount() << "\n";
+        } else {
+            OneByOneFaultSimulator faultSim(faults, marchTest, rows, cols, seed, results);
+            if (opts.has("cross-check")) {
+                faultSim.setAnalyticalMode(AnalyticalMode::CrossCheck);
+            } else if (opts.has("analytical")) {
+                faultSim.setAnalyticalMode(AnalyticalMode::FastPath);
+            }
+            faultSim.setSymmetryReduction(opts.has("symmetry"));
+            faultSim.setMemoryKind(memoryKind);
+            faultSim.setBothDirections(bothDirections);
+
+            const auto [first, last] = shard.range(faults.size());
+            faultSim.setFaultRange(first, last);
+
+            std::unique_ptr<CheckpointWriter> checkpoint;
+            if (!checkpointFile.empty()) {
+                // --symmetry / --memory 不在 job 摘要中，resume 時可以更改
+                checkpoint = std::make_unique<CheckpointWriter>(results, CheckpointWriter::statePath(checkpointFile),
+                                                                sharded ? shard.tag(job) : job,
+                                                                opts.getDouble("checkpoint-interval", 60));
+                if (resume) {
+                    const CheckpointState state = CheckpointState::load(checkpoint->path());
+                    if (state.job != (sharded ? shard.tag(job) : job))
+                        throw std::runtime_error("檢查點的參數與本次不符: " + state.job);
+                    faultSim.resumeAt(state.cursor, state.rngState);
+                    std::cout << "Resumed at " << state.cursor.done(first, last) << " / "
+                              << (last - first) * 2 << " (fault, init)\n";
+                }
+                std::signal(SIGINT, requestStop);
+                std::signal(SIGTERM, requestStop);
+            }
+            std::unique_ptr<ProgressMeter> meter;
+            const long long total = static_cast<long long>(last - first) * 2;
+            if (opts.has("progress"))
+                meter = std::make_unique<ProgressMeter>(total, faultSim.cursor().done(first, last), std::cerr,
+                                                        opts.getDouble("progress", 5));
+            if (checkpoint || meter) {
+                faultSim.setProgressCallback([&](const RunCursor& next) {
+                    if (meter) meter->update(next.done(first, last));
+                    if (!checkpoint) return;
+                    if (gStopRequested) {
+                        checkpoint->save(next, faultSim.allocatorState());
+                        throw std::runtime_error("已中止並保存檢查點 (" + std::to_string(next.done(first, last))
+                                                 + " / " + std::to_string(total) + ")，以 --resume 繼續");
+                    }
+                    if (checkpoint->due()) checkpoint->save(next, faultSim.allocatorState());
+                });
+            }
+            faultSim.run();
+            if (checkpoint) checkpoint->save(faultSim.cursor(), faultSim.allocatorState());
+            if (meter) meter->finish(total);
+            detectedRate = faultSim.getDetectedRate();
+            if (sharded) {
+                // 報告在 --merge 時才產生
+                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - start);
+                std::cout << "Shard " << shard.toString() << ": faults [" << first << ", " << last
+                          << ") written to " << args[2] << "\n";
+                std::cout << "Execution time: " << duration.count() << " ms\n";
+                return 0;
+            }
+            if (const SymmetryReducer* sym = faultSim.symmetry()) {
+                std::cout << "Symmetry reduction: " << sym->representatives() << " computed, "
+                          << sym->derivedCount() << " derived\n";
+            }
+            if (opts.has("cross-check")) {
+                std::cout << "Analytical cross-check: " << faultSim.crossCheckMismatches()
+                          << " mismatch(es)\n";
+            }
+        }
 
         // 結束計時
         auto end = std::chrono::high_resolution_clock::now();
@@ -44,15 +375,26 @@ int main(int argc, char* argv[])
         std::cout << "Execution time: " << duration.count() << " ms\n";
 
         // Write detection report
-        parser.writeDetectionReport(faults, faultSim.getDetectedRate(), argv[3]);
+        parser.writeDetectionReport(faults, results, detectedRate, args[2]);
+        if (opts.has("csv"))      parser.writeCsvReport(faults, results, opts.get("csv"));
+        if (opts.has("columnar")) parser.writeColumnarReport(faults, results, opts.get("columnar"));
+
+        if (opts.has("dictionary")) {
+            // syndrome → fault 的反查字典，供 --lookup 診斷測試機資料
+            DiagnosticDictionary dict(faults, results);
+            dict.save(opts.get("dictionary", "dictionary.json"));
+            std::cout << "Diagnostic dictionary: " << dict.syndromeCount() << " syndromes, "
+                      << dict.equivalenceClasses().size() << " equivalence classes, resolution "
+                      << dict.resolution() * 100 << "%\n";
+        }
+
+
 
-        
 
-        
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
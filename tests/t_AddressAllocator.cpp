@@ -49,12 +49,75 @@ void testTwoCellFaultAggressorGreaterThanVictim() {
     assert(result.second >= 0 && result.second < 100); // Victim address should be within bounds
 }
 
+void testNeighborhoodTables() {
+    // 3-cell：同一列連續三格；5 / 9-cell：victim 不可在邊界
+    NeighborhoodTable row(4, 5, 3), cross(4, 5, 5), moore(4, 5, 9);
+    assert(row.size() == 4 * 3);
+    assert(cross.size() == 2 * 3);
+    assert(moore.size() == 2 * 3);
+    for (std::size_t i = 0; i < moore.size(); ++i) {
+        const int* c = moore.cells(i);
+        const int v = moore.victimOf(i);
+        assert(c[4] == v && c[0] == v - 5 - 1 && c[8] == v + 5 + 1);
+    }
+
+    AddressAllocator allocator(10, 10, 12345);
+    FaultConfig npsf;
+    npsf.cellNumber_ = 5;
+    for (int n = 0; n < 20; ++n) {
+        auto cells = allocator.allocateNeighborhood(npsf);
+        assert(cells.size() == 5);
+        const int v = cells[NeighborhoodLayout::victimIndex(5)];
+        assert(cells[0] == v - 10 && cells[1] == v - 1 && cells[3] == v + 1 && cells[4] == v + 10);
+        assert(v % 10 != 0 && v % 10 != 9);
+    }
+    assert(&allocator.table(5) == &allocator.table(5)); // 同一幾何只建一次
+}
+
+void testDecoderPartner() {
+    AddressAllocator allocator(6, 5, 12345);  // 30 個 cell，不是 2 的次方
+    FaultConfig af;
+    af.decoderKind_ = DecoderFaultKind::WrongCell;
+    for (int n = 0; n < 50; ++n) {
+        auto [partner, addr] = allocator.allocateDecoder(af);
+        assert(addr >= 0 && addr < 30 && partner >= 0 && partner < 30);
+        const int diff = addr ^ partner;
+        assert(diff != 0 && (diff & (diff - 1)) == 0);  // 只差一個位址 bit
+    }
+    af.decoderKind_ = DecoderFaultKind::NoAccess;
+    assert(allocator.allocateDecoder(af).first == -1);
+}
+
+void testLineOf() {
+    AddressAllocator allocator(6, 5, 12345);
+    const LineRange row = allocator.lineOf(LineScope::Row, 13);
+    assert(row.first == 10 && row.count == 5 && row.stride == 1);
+    const LineRange col = allocator.lineOf(LineScope::Column, 13);
+    assert(col.first == 3 && col.count == 6 && col.stride == 5);
+
+    // 放完一條 row 後，相鄰的 row 不能再放 (與其他 fault 一樣保留一圈間隔)
+    SpatialPlacementPlanner planner(6, 5);
+    FaultConfig line;
+    line.lineScope_ = LineScope::Row;
+    assert(planner.placeLine(line) == 2);       // row 0 的中央
+    assert(planner.placeLine(line) == 12);      // row 2
+    assert(planner.placeLine(line) == 22);      // row 4
+    assert(planner.placeLine(line) == -1);
+    line.lineScope_ = LineScope::Column;
+    assert(planner.placeLine(line) == -1);      // 每個 column 都已有 cell 被佔用
+    planner.clear();
+    assert(planner.placeLine(line) == 15);      // column 0 的中央 (row 3)
+}
+
 int main() {
     std::cout << "Running AddressAllocator tests...\n";
 
     testSingleCellFault();
     testTwoCellFaultAggressorLessThanVictim();
     testTwoCellFaultAggressorGreaterThanVictim();
+    testNeighborhoodTables();
+    testDecoderPartner();
+    testLineOf();
 
     std::cout << "All AddressAllocator tests passed!\n";
     return 0;
@@ -0,0 +1,129 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "../include/AddressOrder.hpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/Parser.cpp"
+#include "../src/AddressDecoder.cpp"
+#include "../src/DataBackground.cpp"
+#include "../src/Fault.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/MemoryState.cpp"
+#include "../src/ResultCollector.cpp"
+#include "../src/ResultStore.cpp"
+#include "../src/SequenceExecutor.cpp"
+
+static const char* kMarch = "t_AddressOrder.march.tmp.json";
+
+static std::vector<int> gen(const std::string& text, int rows, int cols) {
+    return AddressOrderRegistry::generate(AddressOrderRegistry::parse(text), rows, cols);
+}
+
+template <typename Fn>
+static bool throws(Fn fn) {
+    try { fn(); } catch (const std::invalid_argument&) { return true; }
+    return false;
+}
+
+void test_builtin_orders() {
+    assert(gen("linear", 2, 3) == std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+    assert(gen("gray", 2, 4) == std::vector<int>({ 0, 1, 3, 2, 6, 7, 5, 4 }));
+    // 6 不是 2 的冪：略過 >= 6 的 Gray code
+    assert(gen("gray", 2, 3) == std::vector<int>({ 0, 1, 3, 2, 5, 4 }));
+    assert(gen("stride1", 2, 4) == std::vector<int>({ 0, 2, 4, 6, 1, 3, 5, 7 }));
+    assert(gen("stride2", 1, 6) == std::vector<int>({ 0, 4, 1, 5, 2, 3 }));
+    assert(gen("stride0", 2, 2) == gen("linear", 2, 2));
+    assert(gen("col", 2, 3) == std::vector<int>({ 0, 3, 1, 4, 2, 5 }));
+
+    // scramble：同一個 key 結果固定，不同 key 不同
+    const auto s1 = gen("scramble1", 4, 4), s2 = gen("scramble2", 4, 4);
+    assert(s1 == gen("SCRAMBLE1", 4, 4));
+    assert(s1 != s2 && s1 != gen("linear", 4, 4));
+    std::cout << "test_builtin_orders passed\n";
+}
+
+void test_parse_and_register() {
+    const AddressOrder o = AddressOrderRegistry::parse("stride3");
+    assert(o.name == "stride" && o.param == 3 && o.toString() == "stride3");
+    assert(AddressOrderRegistry::parse("gray").toString() == "gray");
+    assert(throws([] { AddressOrderRegistry::parse("spiral"); }));
+
+    // 自訂順序 (例如 tester 的 scramble 表)
+    AddressOrderRegistry::add("reverse", [](int rows, int cols, int) {
+        std::vector<int> seq;
+        for (int a = rows * cols - 1; a >= 0; --a) seq.push_back(a);
+        return seq;
+    });
+    assert(gen("reverse", 1, 3) == std::vector<int>({ 2, 1, 0 }));
+
+    // 不是排列的產生器在使用時被拒絕
+    AddressOrderRegistry::add("broken", [](int, int, int) { return std::vector<int>{ 0, 0 }; });
+    assert(throws([] { gen("broken", 1, 2); }));
+    assert(throws([] { AddressOrderRegistry::add("bad name1", [](int, int, int) { return std::vector<int>{}; }); }));
+    std::cout << "test_parse_and_register passed\n";
+}
+
+class TraceCollector : public IResultCollector {
+public:
+    void opRecord(const MarchIdx&, int addr, bool) override { addrs_.push_back(addr); }
+    DetectionReport getReport() const override { return {}; }
+    void reset() override { addrs_.clear(); }
+    std::vector<int> addrs_;
+};
+
+class HealthyFault : public IFault {
+public:
+    explicit HealthyFault(std::shared_ptr<MemoryState> mem) : IFault(nullptr, std::move(mem), nullptr, -1) {}
+    int readProcess(int addr, const SingleOp&) override { return mem_->read(addr); }
+    void writeProcess(int addr, const SingleOp& op) override { mem_->write(addr, op.value_); }
+};
+
+void test_march_syntax_and_execution() {
+    std::ofstream(kMarch) << R"JSON({"name": "orders", "pattern": "b(w0); a[gray](r0,w1); d [ COL ] (r1); a(r1)"})JSON";
+    Parser parser;
+    const auto march = parser.parseMarchTest(kMarch);
+    assert(march.size() == 4);
+    assert(march[0].order_.linear());
+    assert(march[1].order_ == AddressOrderRegistry::parse("gray"));
+    assert(march[2].order_.name == "col" && march[2].addrOrder_ == Direction::DESC);
+
+    // 沒有標註的 element 使用預設順序
+    parser.setDefaultAddressOrder(AddressOrderRegistry::parse("stride1"));
+    const auto strided = parser.parseMarchTest(kMarch);
+    assert(strided[0].order_.name == "stride" && strided[1].order_.name == "gray");
+    const auto builtin = parser.parseMarchTest("builtin:MATS++");
+    assert(builtin[1].order_.name == "stride");
+
+    std::ofstream(kMarch) << R"JSON({"name": "bad", "pattern": "a[spiral](r0)"})JSON";
+    bool threw = false;
+    try { parser.parseMarchTest(kMarch); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::remove(kMarch);
+
+    // 2 x 4：gray 遞增、col 遞減 (同一序列倒著走)、最後回到 linear
+    const MarchProgram program(march, 2, 4);
+    assert(program.builtin() == -1);
+    assert(program.addresses(0) == nullptr && program.addresses(1) != nullptr);
+    HealthyFault fault(MemoryState::create(2, 4, 0));
+    TraceCollector collector;
+    SequenceExecutor executor(8, collector);
+    executor.execute(program, fault);
+    const std::vector<int> expect {
+        0, 1, 3, 2, 6, 7, 5, 4,     // a[gray]
+        7, 3, 6, 2, 5, 1, 4, 0,     // d[col]
+        0, 1, 2, 3, 4, 5, 6, 7,     // a
+    };
+    assert(collector.addrs_ == expect);
+    std::cout << "test_march_syntax_and_execution passed\n";
+}
+
+int main() {
+    test_builtin_orders();
+    test_parse_and_register();
+    test_march_syntax_and_execution();
+    std::cout << "All AddressOrder tests passed\n";
+    return 0;
+}
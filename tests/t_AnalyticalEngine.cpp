@@ -0,0 +1,140 @@
+#include <cassert>
+#include <iostream>
+#include "../include/AnalyticalEngine.hpp"
+#include "../src/AnalyticalEngine.cpp"
+#include "../include/Fault.hpp"
+#include "../src/Fault.cpp"
+#include "../include/MemoryState.hpp"
+#include "../src/MemoryState.cpp"
+#include "../include/ResultCollector.hpp"
+#include "../src/ResultCollector.cpp"
+#include "../include/SequenceExecutor.hpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/SequenceExecutor.cpp"
+
+constexpr int MEM_SIZE = 9;
+
+static MarchElement makeElem(Direction dir, const std::vector<SingleOp>& ops, int elemIdx, int& overallIdx) {
+    MarchElement elem;
+    elem.addrOrder_ = dir;
+    elem.elemIdx_   = elemIdx;
+    for (std::size_t i = 0; i < ops.size(); ++i)
+        elem.ops_.push_back({ops[i], MarchIdx(elemIdx, static_cast<int>(i), overallIdx++)});
+    return elem;
+}
+
+// March C- : b(w0);a(r0,w1);a(r1,w0);d(r0,w1);d(r1,w0);b(r0)
+static std::vector<MarchElement> marchCMinus() {
+    int o = 0;
+    using Op = OpType;
+    return {
+        makeElem(Direction::BOTH, {{Op::W, 0}}, 0, o),
+        makeElem(Direction::ASC,  {{Op::R, 0}, {Op::W, 1}}, 1, o),
+        makeElem(Direction::ASC,  {{Op::R, 1}, {Op::W, 0}}, 2, o),
+        makeElem(Direction::DESC, {{Op::R, 0}, {Op::W, 1}}, 3, o),
+        makeElem(Direction::DESC, {{Op::R, 1}, {Op::W, 0}}, 4, o),
+        makeElem(Direction::BOTH, {{Op::R, 0}}, 5, o),
+    };
+}
+
+static DetectionReport simulate(const std::vector<MarchElement>& march, const FaultConfig& cfg,
+                                int init, int aggr, int vic) {
+    auto mem = std::make_shared<DenseMemoryState>(1, MEM_SIZE, init);
+    OneByOneResultCollector col;
+    auto shared = std::make_shared<const FaultConfig>(cfg);
+    auto fault = cfg.is_twoCell_ ? FaultFactory::makeTwoCellFault(shared, mem, aggr, vic)
+                                 : FaultFactory::makeOneCellFault(shared, mem, vic);
+    SequenceExecutor exe(MEM_SIZE, col);
+    exe.execute(march, *fault);
+    return col.getReport();
+}
+
+static std::vector<FaultConfig> sampleFaults() {
+    std::vector<FaultConfig> out;
+    auto one = [&](int vi, std::vector<SingleOp> trig, int fv, int rv) {
+        FaultConfig c;
+        c.VI_ = vi; c.trigger_ = std::move(trig); c.faultValue_ = fv; c.finalReadValue_ = rv;
+        out.push_back(c);
+    };
+    auto two = [&](TwoCellFaultType t, int ai, int vi, std::vector<SingleOp> trig, int fv, int rv) {
+        FaultConfig c;
+        c.is_twoCell_ = true; c.twoCellFaultType_ = t;
+        c.AI_ = ai; c.VI_ = vi; c.trigger_ = std::move(trig); c.faultValue_ = fv; c.finalReadValue_ = rv;
+        out.push_back(c);
+    };
+    one(0, {{OpType::W, 1}}, 0, -1);                     // TF  <0W1/0/->
+    one(0, {{OpType::R, 0}}, 1, 1);                      // RDF <0R0/1/1>
+    one(1, {{OpType::W, 0}, {OpType::R, 0}}, 1, 1);      // dRDF
+    two(TwoCellFaultType::Sa, 0, 0, {{OpType::W, 1}}, 1, -1);                 // CFtr (Sa)
+    two(TwoCellFaultType::Sa, 1, 1, {{OpType::R, 1}}, 0, -1);                 // CFds (Sa, read)
+    two(TwoCellFaultType::Sv, 0, 1, {{OpType::R, 1}}, 0, 0);                  // CFrd (Sv)
+    two(TwoCellFaultType::Sv, 1, 0, {}, 1, -1);                                // CFst
+    return out;
+}
+
+// 所有位址組合 × 兩種 background：解析式結果必須與實際模擬完全一致
+void test_cross_check_all_placements() {
+    auto march = marchCMinus();
+    AnalyticalEngine engine(march, MEM_SIZE);
+    for (const auto& cfg : sampleFaults()) {
+        assert(engine.supports(cfg));
+        for (int init = 0; init < 2; ++init) {
+            for (int vic = 0; vic < MEM_SIZE; ++vic) {
+                if (!cfg.is_twoCell_) {
+                    assert(engine.evaluate(cfg, init, -1, vic) == simulate(march, cfg, init, -1, vic));
+                    continue;
+                }
+                for (int aggr = 0; aggr < MEM_SIZE; ++aggr) {
+                    if (aggr == vic) continue;
+                    assert(engine.evaluate(cfg, init, aggr, vic) == simulate(march, cfg, init, aggr, vic));
+                }
+            }
+        }
+    }
+}
+
+void test_undetected_report_has_all_reads() {
+    auto march = marchCMinus();
+    AnalyticalEngine engine(march, MEM_SIZE);
+    FaultConfig cfg;
+    cfg.VI_ = 0; cfg.trigger_ = {{OpType::W, 0}, {OpType::W, 0}}; cfg.faultValue_ = 1;
+    DetectionReport r = engine.evaluate(cfg, 0, -1, 4);
+    assert(!r.isDetected_);
+    assert(r.detected_.size() == 5);  // 5 個 read op 都要有 (false) 紀錄
+}
+
+// 偵測以位址段記錄：記憶體放大後段數不變，只有段的範圍改變；展開後與 evaluate() 的報告相同
+void test_segments_independent_of_size() {
+    auto march = marchCMinus();
+    const int big = 1 << 30;
+    AnalyticalEngine small(march, MEM_SIZE), huge(march, big);
+    AnalyticalResult reused, fresh;
+    bool gapDetected = false;
+    for (const auto& cfg : sampleFaults()) {
+        const int aggr = cfg.is_twoCell_ ? 2 : -1;
+        for (int init = 0; init < 2; ++init) {
+            small.evaluate(cfg, init, aggr, 5, reused);
+            assert(reused.report.detectedVicAddrs_.empty());
+            const std::size_t segments = reused.segments.size();
+            reused.expandAddresses();
+            assert(reused.report == small.evaluate(cfg, init, aggr, 5));
+
+            huge.evaluate(cfg, init, aggr, 5, fresh);
+            assert(fresh.segments.size() == segments);
+            assert(fresh.report.detected_ == reused.report.detected_);
+            for (const DetectedSegment& seg : fresh.segments)
+                if (seg.hi == big) gapDetected = gapDetected || seg.hi - seg.lo > 1;
+        }
+    }
+    assert(gapDetected); // 有 fault 在 victim 之後的整段位址被偵測 (未逐一展開)
+}
+
+int main() {
+    test_cross_check_all_placements();
+    test_undetected_report_has_all_reads();
+    test_segments_independent_of_size();
+    std::cout << "All AnalyticalEngine tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "../include/BufferedWriter.hpp"
+
+static std::string slurp(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+// 小 buffer 下跨越邊界的字元、數字與長字串都要完整寫出
+void test_text_across_flushes() {
+    const std::string path = "t_BufferedWriter.tmp";
+    std::string expected;
+    {
+        BufferedWriter out(path, 8);
+        for (int i = -3; i < 40; ++i) {
+            out.put("r").num(i).put(',');
+            expected += "r" + std::to_string(i) + ",";
+        }
+        const std::string big(100, 'x');   // 比 buffer 大：直接寫出
+        out.put(big).put('\n');
+        expected += big + "\n";
+        out.num(1234567890123LL);
+        expected += "1234567890123";
+        out.flush();
+    }
+    assert(slurp(path) == expected);
+    std::remove(path.c_str());
+}
+
+void test_binary_columns() {
+    const std::string path = "t_BufferedWriter.tmp";
+    const std::vector<uint32_t> col = { 1, 2, 0xdeadbeef };
+    {
+        BufferedWriter out(path, 16);
+        out.put("HDR").bin(uint16_t{7}).bin(col);
+    }   // 解構時 flush
+    const std::string data = slurp(path);
+    assert(data.size() == 3 + 2 + col.size() * 4);
+    uint32_t last;
+    std::memcpy(&last, data.data() + 5 + 8, 4);
+    assert(data.substr(0, 3) == "HDR" && last == 0xdeadbeef);
+    std::remove(path.c_str());
+}
+
+int main() {
+    test_text_across_flushes();
+    test_binary_columns();
+    std::cout << "All BufferedWriter tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "../include/Checkpoint.hpp"
+#include "../src/Checkpoint.cpp"
+#include "../src/ResultStore.cpp"
+
+static const char* kState = "t_Checkpoint.ckpt.tmp";
+static const char* kSpill = "t_Checkpoint.spill.tmp";
+
+template <typename Fn>
+static bool throws(Fn fn) {
+    try { fn(); } catch (const std::exception&) { return true; }
+    return false;
+}
+
+void test_cursor() {
+    assert(RunCursor{}.done(10) == 0);
+    assert((RunCursor{ 0, 7 }.done(10) == 7));
+    assert((RunCursor{ 1, 3 }.done(10) == 13));
+    assert((RunCursor{ 2, 0 }.finished() && RunCursor{ 2, 0 }.done(10) == 20));
+    // 只計算 [4, 8) 時
+    assert((RunCursor{ 0, 4 }.done(4, 8) == 0 && RunCursor{ 1, 6 }.done(4, 8) == 6 && RunCursor{ 2, 0 }.done(4, 8) == 8));
+    std::cout << "test_cursor passed\n";
+}
+
+void test_state_round_trip() {
+    const CheckpointState state { "faults.json | March C- | 64x64 seed 7", { 1, 4242 }, "1 2 3 4" };
+    state.save(kState);
+    const CheckpointState back = CheckpointState::load(kState);
+    assert(back.job == state.job && back.cursor == state.cursor && back.rngState == state.rngState);
+    assert(!std::ifstream(std::string(kState) + ".tmp")); // tmp 已 rename
+
+    // 覆寫為新的進度
+    CheckpointState later = state;
+    later.cursor = { 2, 0 };
+    later.save(kState);
+    assert(CheckpointState::load(kState).cursor.finished());
+
+    assert(throws([] { CheckpointState{ "a\nb", {}, "" }.save(kState); }));
+    std::ofstream(kState) << "FSCKPT 1\njob x\ncursor 3 0\nrng 1\n";
+    assert(throws([] { CheckpointState::load(kState); }));
+    std::ofstream(kState) << "FSCKPT 1\njob x\nrng 1\n";
+    assert(throws([] { CheckpointState::load(kState); }));
+    std::ofstream(kState) << "something else\n";
+    assert(throws([] { CheckpointState::load(kState); }));
+    std::remove(kState);
+    assert(throws([] { CheckpointState::load(kState); }));
+    std::cout << "test_state_round_trip passed\n";
+}
+
+void test_writer() {
+    std::vector<MarchElement> march(1);
+    march[0].ops_.push_back({ SingleOp(OpType::R, 0), MarchIdx(0, 0, 0) });
+
+    // 沒有 spill 檔就沒有地方保存結果
+    ResultStore heap(3, march);
+    assert(throws([&] { CheckpointWriter(heap, kState, "job", 60); }));
+
+    {
+        ResultStore results(3, march, kSpill);
+        CheckpointWriter writer(results, CheckpointWriter::statePath(kSpill), "job", 60);
+        assert(writer.path() == std::string(kSpill) + ".ckpt");
+        assert(!writer.due());
+        results.set(1, 0, Syndrome::fromString("1"));
+        writer.save({ 0, 2 }, "rng");
+        assert(writer.saves() == 1);
+        assert(CheckpointWriter(results, kState, "job", 0).due());
+    }
+    // 檢查點記錄的結果已在 spill 檔中
+    const CheckpointState state = CheckpointState::load(std::string(kSpill) + ".ckpt");
+    assert(state.job == "job" && (state.cursor == RunCursor{ 0, 2 }) && state.rngState == "rng");
+    ResultStore reopened = ResultStore::reopen(kSpill, 3, march);
+    assert(reopened.detected(1, 0) && reopened.detectedCount() == 1);
+    std::remove(kSpill);
+    std::remove((std::string(kSpill) + ".ckpt").c_str());
+    std::cout << "test_writer passed\n";
+}
+
+void test_progress_meter() {
+    assert(ProgressMeter::formatDuration(0) == "0s");
+    assert(ProgressMeter::formatDuration(59.4) == "59s");
+    assert(ProgressMeter::formatDuration(245) == "4m05s");
+    assert(ProgressMeter::formatDuration(3723) == "1h02m03s");
+
+    std::ostringstream out;
+    ProgressMeter meter(200, 50, out, 3600);
+    meter.update(60); // 還沒到輸出時間
+    assert(out.str().empty());
+    meter.finish(200);
+    assert(out.str().rfind("Progress: 200/200 (100.0%), ", 0) == 0);
+    assert(out.str().find("elapsed") != std::string::npos);
+
+    std::ostringstream partial;
+    ProgressMeter(100, 0, partial, 0).update(0);
+    assert(partial.str() == "Progress: 0/100 (0.0%), 0/s, ETA --\n");
+    std::cout << "test_progress_meter passed\n";
+}
+
+int main() {
+    test_cursor();
+    test_state_round_trip();
+    test_writer();
+    test_progress_meter();
+    std::cout << "All Checkpoint tests passed\n";
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include "../include/DiagnosticDictionary.hpp"
+#include "../src/DiagnosticDictionary.cpp"
+#include "../src/ResultStore.cpp"
+
+// 三個 read：M1(0) M2(0) M3(0)
+static std::vector<MarchElement> threeReads() {
+    std::vector<MarchElement> march(4);
+    int o = 0;
+    for (int e = 0; e < 4; ++e) {
+        march[e].elemIdx_ = e;
+        if (e > 0) march[e].ops_.push_back({{OpType::R, 0}, MarchIdx(e, 0, o++)});
+        march[e].ops_.push_back({{OpType::W, 0}, MarchIdx(e, e > 0 ? 1 : 0, o++)});
+    }
+    return march;
+}
+
+// fault 名稱與 init0 / init1 的 syndrome (第 i 個字元 = 第 i 個 read)
+struct Entry {
+    std::string name, init0, init1;
+};
+
+static std::vector<FaultConfig> faultsOf(const std::vector<Entry>& entries) {
+    std::vector<FaultConfig> faults(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) faults[i].id_ = { entries[i].name, 0 };
+    return faults;
+}
+
+static ResultStore resultsOf(const std::vector<Entry>& entries, const std::vector<MarchElement>& march) {
+    ResultStore results(entries.size(), march);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        results.set(i, 0, Syndrome::fromString(entries[i].init0));
+        results.set(i, 1, Syndrome::fromString(entries[i].init1));
+    }
+    return results;
+}
+
+void test_syndrome_bits() {
+    Syndrome s = Syndrome::fromString("0100000000000000000000000000000000000000000000000000000000000000001");
+    assert(s.size() == 67 && s.test(1) && s.test(66) && !s.test(0));
+    assert(s.toString() == "0100000000000000000000000000000000000000000000000000000000000000001");
+    assert(s.distance(Syndrome(67)) == 2);
+}
+
+void test_exact_nearest_and_classes() {
+    auto march = threeReads();
+    const std::vector<Entry> entries = {
+        { "A", "110", "110" },
+        { "B", "110", "110" },   // 與 A 無法區分
+        { "C", "110", "011" },   // init 1 不同 → 另一類
+        { "D", "001", "001" },
+        { "E", "000", "000" },   // 未被偵測
+    };
+    DiagnosticDictionary dict(faultsOf(entries), resultsOf(entries, march));
+    assert(dict.readCount() == 3 && dict.syndromeCount() == 3);
+
+    const auto* hit = dict.exact(Syndrome::fromString("110"));
+    assert(hit && (*hit == std::vector<int>{0, 1, 2}));
+    assert(dict.exact(Syndrome::fromString("111")) == nullptr);
+    assert(dict.exact(Syndrome::fromString("000")) == nullptr);
+
+    auto m = dict.nearest(Syndrome::fromString("010"));     // 110 / 011 都差 1 bit
+    assert(m.distance == 1 && (m.faults == std::vector<int>{0, 1, 2}));
+    m = dict.nearest(Syndrome::fromString("101"), 0);        // 最近的 001 差 1 bit
+    assert(m.distance == -1 && m.faults.empty());
+    m = dict.nearest(Syndrome::fromString("101"), 1);
+    assert(m.distance == 1 && (m.faults == std::vector<int>{3}));
+    m = dict.nearest(Syndrome::fromString("111"));            // 110 / 011 都差 1 bit
+    assert(m.distance == 1 && (m.faults == std::vector<int>{0, 1, 2}));
+
+    const auto& classes = dict.equivalenceClasses();
+    assert(classes.size() == 3);
+    assert((classes[0] == std::vector<int>{0, 1}) && classes[1] == std::vector<int>{2});
+    assert(std::abs(dict.resolution() - 3.0 / 4.0) < 1e-12);
+}
+
+void test_save_load_roundtrip() {
+    auto march = threeReads();
+    const std::vector<Entry> entries = {
+        { "A", "110", "000" },
+        { "B", "000", "110" },   // 同一個 syndrome，但初值不同 → 不同類
+        { "C", "011", "011" },
+    };
+    const ResultStore results = resultsOf(entries, march);
+    DiagnosticDictionary dict(faultsOf(entries), results);
+    const std::string path = "t_DiagnosticDictionary.tmp.json";
+    dict.save(path);
+    auto loaded = DiagnosticDictionary::load(path);
+    std::remove(path.c_str());
+
+    assert(loaded.faultCount() == 3 && loaded.readCount() == 3);
+    assert(loaded.syndromeCount() == dict.syndromeCount());
+    assert(loaded.equivalenceClasses() == dict.equivalenceClasses());
+    assert(loaded.equivalenceClasses().size() == 3);
+    assert(loaded.faultId(1).faultName_ == "B");
+    assert(*loaded.exact(Syndrome::fromString("110")) == (std::vector<int>{0, 1}));
+    // 載入後的 read 對應與原本相同
+    assert(loaded.syndromeOf(results.report(2, 0)) == Syndrome::fromString("011"));
+}
+
+int main() {
+    test_syndrome_bits();
+    test_exact_nearest_and_classes();
+    test_save_load_roundtrip();
+    std::cout << "All DiagnosticDictionary tests passed!" << std::endl;
+    return 0;
+}
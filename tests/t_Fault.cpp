@@ -3,6 +3,7 @@
 // 每一組 assert 前面都會標註所對應的 Fault model 方便對照論文 <S/F/R> 表記
 
 #include <cassert>
+#include <deque>
 #include <iostream>
 #include <memory>
 #include "../include/Fault.hpp"        // Fault / Trigger 主要邏輯
@@ -44,11 +45,11 @@ std::shared_ptr<FaultConfig> makeBaseCfg()
 //---------------------------------------------------------------------
 // 一些建構 trigger 序列的小工具
 //---------------------------------------------------------------------
-inline SO W(int value)
-{ return SO{Op::W, value}; }
+inline SO W(int value, int repeat = 1)
+{ return SO{Op::W, value, repeat}; }
 
-inline SO R(int value)
-{ return SO{Op::R,  value}; }
+inline SO R(int value, int repeat = 1)
+{ return SO{Op::R,  value, repeat}; }
 
 //---------------------------------------------------------------------
 // One‑Cell Sequence Trigger 測試
@@ -265,6 +266,326 @@ void test_TwoCellFault_DCF_Sv_R()
     assert(mem->read(VIC_ADDR) == cfg->faultValue_); // Victim 現在應為 0
 }
 
+//---------------------------------------------------------------------
+// LinkedFault — 單一成員時與原 fault 完全相同
+//---------------------------------------------------------------------
+void test_LinkedFault_single_member()
+{
+    auto cfg = makeBaseCfg();
+    cfg->VI_ = INIT_0; cfg->trigger_ = { W(0), R(0) };
+    cfg->faultValue_ = INIT_1; cfg->finalReadValue_ = INIT_0;  // dDRDF <0W0R0/1/0>
+
+    auto memA = makeMemory(0), memB = makeMemory(0);
+    auto alone = FaultFactory::makeOneCellFault(cfg, memA, VIC_ADDR);
+    std::vector<std::unique_ptr<IFault>> members;
+    members.push_back(FaultFactory::makeOneCellFault(cfg, memB, VIC_ADDR));
+    LinkedFault linked(memB, std::move(members));
+
+    const SO seq[] = { W(0), R(0), R(1), W(0), R(0) };
+    for (const SO& op : seq) {
+        for (int addr : { VIC_ADDR, OTHER_ADDR }) {
+            if (op.type_ == Op::W) { alone->writeProcess(addr, op); linked.writeProcess(addr, op); }
+            else assert(alone->readProcess(addr, op) == linked.readProcess(addr, op));
+            assert(memA->read(addr) == memB->read(addr));
+        }
+    }
+}
+
+//---------------------------------------------------------------------
+// LinkedFault — 兩個 fault 共用 victim，後者的效應蓋掉前者 (masking)
+//---------------------------------------------------------------------
+void test_LinkedFault_masking()
+{
+    auto mem = makeMemory(0);
+    auto wdf0 = makeBaseCfg();   // <0W0/1/->：寫 0 到 0 時變成 1
+    wdf0->VI_ = INIT_0; wdf0->trigger_ = { W(0) }; wdf0->faultValue_ = INIT_1;
+    auto rdf1 = makeBaseCfg();   // <1R1/0/1>：讀 1 時變成 0，但讀出正確的 1
+    rdf1->VI_ = INIT_1; rdf1->trigger_ = { R(1) }; rdf1->faultValue_ = INIT_0; rdf1->finalReadValue_ = INIT_1;
+
+    std::vector<std::unique_ptr<IFault>> members;
+    members.push_back(FaultFactory::makeOneCellFault(wdf0, mem, VIC_ADDR));
+    members.push_back(FaultFactory::makeOneCellFault(rdf1, mem, VIC_ADDR));
+    LinkedFault linked(mem, std::move(members));
+    assert(linked.size() == 2);
+
+    linked.writeProcess(VIC_ADDR, W(0));             // wdf0 觸發 → victim = 1
+    assert(mem->read(VIC_ADDR) == INIT_1);
+    assert(linked.readProcess(VIC_ADDR, R(1)) == 1); // rdf1 觸發：讀到 1，victim 被拉回 0
+    assert(mem->read(VIC_ADDR) == INIT_0);
+    assert(linked.readProcess(VIC_ADDR, R(0)) == 0); // wdf0 的效應已被遮蔽
+}
+
+//---------------------------------------------------------------------
+// N‑Cell Fault — 5-cell ANPSF：北邊鄰居 0→1 且其餘鄰居為 0 時 victim 翻成 1
+//   鄰域 (victim = 5)：N=1, W=4, V=5, E=6, S=9
+//---------------------------------------------------------------------
+void test_NCellFault_ANPSF()
+{
+    const std::vector<int> cells = { 1, 4, 5, 6, 9 };
+    auto cfg = makeBaseCfg();
+    cfg->cellNumber_ = 5;
+    cfg->cellStates_ = { 0, 0, 0, 0, 0 };
+    cfg->triggerCell_ = 0;
+    cfg->VI_ = INIT_0; cfg->trigger_ = { W(1) }; cfg->faultValue_ = INIT_1;
+
+    auto mem = makeMemory(0);
+    auto fault = FaultFactory::makeNCellFault(cfg, mem, cells, COLS);
+    fault->writeProcess(6, W(1));           // E = 1：鄰域不符
+    fault->writeProcess(1, W(1));
+    assert(mem->read(1) == 1);
+    assert(mem->read(5) == INIT_0);
+
+    auto mem2 = makeMemory(0);
+    auto fault2 = FaultFactory::makeNCellFault(cfg, mem2, cells, COLS);
+    fault2->writeProcess(OTHER_ADDR, W(1)); // 鄰域外的操作不影響
+    fault2->writeProcess(1, W(1));          // 觸發：寫入照常，victim 翻轉
+    assert(mem2->read(1) == 1);
+    assert(mem2->read(5) == INIT_1);
+    assert(fault2->readProcess(1, R(1)) == 1);
+}
+
+//---------------------------------------------------------------------
+// N‑Cell Fault — 5-cell PNPSF：四周皆為 1 時 victim 無法由 0 寫成 1
+//   packed pattern 必須跟著鄰居的寫入更新
+//---------------------------------------------------------------------
+void test_NCellFault_PNPSF_pattern()
+{
+    const std::vector<int> cells = { 1, 4, 5, 6, 9 };
+    auto cfg = makeBaseCfg();
+    cfg->cellNumber_ = 5;
+    cfg->cellStates_ = { 1, 1, 0, 1, 1 };
+    cfg->triggerCell_ = 2;
+    cfg->VI_ = INIT_0; cfg->trigger_ = { W(1) }; cfg->faultValue_ = INIT_0;
+
+    auto mem = makeMemory(0);
+    auto trig = std::make_unique<NCellPatternTrigger>(cells, COLS, cfg, mem);
+    assert(trig->slotOf(9) == 4 && trig->slotOf(OTHER_ADDR) == -1 && trig->slotOf(10) == -1);
+
+    auto fault = FaultFactory::makeNCellFault(cfg, mem, cells, COLS);
+    fault->writeProcess(5, W(1));           // 鄰居仍為 0：正常寫入
+    assert(mem->read(5) == 1);
+    fault->writeProcess(5, W(0));
+    for (int n : { 1, 4, 6, 9 }) fault->writeProcess(n, W(1));
+    fault->writeProcess(5, W(1));           // 觸發：victim 留在 0
+    assert(fault->readProcess(5, R(1)) == INIT_0);
+}
+
+//---------------------------------------------------------------------
+// RunLengthMatcher — 與逐一比對的 deque 結果相同 (含 op^N 展開)
+//---------------------------------------------------------------------
+void test_RunLengthMatcher_matches_deque()
+{
+    const std::vector<SO> trig = { W(1), R(1, 3), W(0) };  // <0 W1 R1^3 W0>
+    std::deque<OperationRecord> pattern, history;
+    int before = INIT_0;
+    for (const SO& op : trig) {
+        for (int t = 0; t < op.repeat_; ++t) {
+            pattern.push_back({before, SO{op.type_, op.value_}});
+            before = op.value_;
+        }
+    }
+    RunLengthMatcher matcher(toOperationRuns(INIT_0, trig));
+
+    unsigned seed = 7;
+    int hits = 0;
+    for (int n = 0; n < 5000; ++n) {
+        seed = seed * 1103515245u + 12345u;
+        const int pick = (seed >> 16) % 5;
+        OperationRecord rec = (pick == 0) ? OperationRecord{0, W(1)}
+                            : (pick == 1) ? OperationRecord{1, W(0)}
+                            : (pick == 4) ? OperationRecord{0, R(0)}
+                                          : OperationRecord{1, R(1)};
+        history.push_back(rec);
+        if (history.size() > pattern.size()) history.pop_front();
+        const bool expect = (history == pattern);
+        assert(matcher.feed(rec) == expect);
+        hits += expect;
+    }
+    assert(hits > 0);
+}
+
+//---------------------------------------------------------------------
+// Hammer fault — 1-cell <0R0^1000/1/1>：第 1000 次讀取才觸發
+//---------------------------------------------------------------------
+void test_OneCellFault_hammer_R()
+{
+    auto mem = makeMemory(0);
+    auto cfg = makeBaseCfg();
+    cfg->VI_ = INIT_0; cfg->trigger_ = { R(0, 1000) };
+    cfg->faultValue_ = INIT_1; cfg->finalReadValue_ = INIT_1;
+
+    auto fault = FaultFactory::makeOneCellFault(cfg, mem, VIC_ADDR);
+    for (int n = 1; n < 1000; ++n) assert(fault->readProcess(VIC_ADDR, R(0)) == INIT_0);
+    assert(fault->readProcess(VIC_ADDR, R(0)) == INIT_1);
+    assert(mem->read(VIC_ADDR) == INIT_1);
+
+    // 與 OneCellSequenceTrigger 相同：其他 cell 的操作只重置 matched，不清除計數
+    auto mem2 = makeMemory(0);
+    auto fault2 = FaultFactory::makeOneCellFault(cfg, mem2, VIC_ADDR);
+    for (int n = 0; n < 999; ++n) fault2->readProcess(VIC_ADDR, R(0));
+    fault2->readProcess(OTHER_ADDR, R(0));
+    assert(fault2->readProcess(VIC_ADDR, R(0)) == INIT_1);
+    // 換 March element (reset) 才會清除計數
+    fault2->reset();
+    assert(fault2->readProcess(VIC_ADDR, R(0)) == INIT_1); // victim 已是 1：<0R0> 不成立
+    assert(mem2->read(VIC_ADDR) == INIT_1);
+}
+
+//---------------------------------------------------------------------
+// Hammer fault — 2-cell Sa <0W0^500;1/0/->：aggressor 連續寫 500 次 0 且 victim 為 1
+//---------------------------------------------------------------------
+void test_TwoCellFault_hammer_Sa()
+{
+    auto mem = makeMemory(0);
+    mem->write(VIC_ADDR, INIT_1);
+    auto cfg = makeBaseCfg();
+    cfg->is_twoCell_ = true;
+    cfg->twoCellFaultType_ = TwoCellFaultType::Sa;
+    cfg->AI_ = INIT_0; cfg->VI_ = INIT_1;
+    cfg->trigger_ = { W(0, 500) };
+    cfg->faultValue_ = INIT_0;
+
+    auto fault = FaultFactory::makeTwoCellFault(cfg, mem, AGGR_ADDR, VIC_ADDR);
+    for (int n = 1; n < 500; ++n) fault->writeProcess(AGGR_ADDR, W(0));
+    assert(mem->read(VIC_ADDR) == INIT_1);
+    fault->writeProcess(AGGR_ADDR, W(0));
+    assert(mem->read(VIC_ADDR) == INIT_0);
+}
+
+//---------------------------------------------------------------------
+// DecoderFault — no access / multiple cells / wrong cell
+//---------------------------------------------------------------------
+void test_DecoderFault_kinds()
+{
+    auto cfg = makeBaseCfg();
+    cfg->decoderKind_ = DecoderFaultKind::NoAccess;
+    cfg->faultValue_ = INIT_0;                       // 選不到 cell 時讀到 0
+    auto mem = makeMemory(0);
+    auto none = FaultFactory::makeDecoderFault(cfg, mem, VIC_ADDR, -1);
+    none->writeProcess(VIC_ADDR, W(1));
+    assert(mem->read(VIC_ADDR) == INIT_0);           // 寫入遺失
+    assert(none->readProcess(VIC_ADDR, R(1)) == INIT_0);
+    none->writeProcess(OTHER_ADDR, W(1));            // identity 路徑
+    assert(none->readProcess(OTHER_ADDR, R(1)) == INIT_1);
+
+    cfg->decoderKind_ = DecoderFaultKind::MultiCell;
+    cfg->faultValue_ = INIT_0;                       // wired-AND
+    auto mem2 = makeMemory(0);
+    auto multi = FaultFactory::makeDecoderFault(cfg, mem2, VIC_ADDR, AGGR_ADDR);
+    multi->writeProcess(VIC_ADDR, W(1));
+    assert(mem2->read(VIC_ADDR) == INIT_1 && mem2->read(AGGR_ADDR) == INIT_1);
+    multi->writeProcess(AGGR_ADDR, W(0));
+    assert(multi->readProcess(VIC_ADDR, R(1)) == INIT_0);
+
+    cfg->decoderKind_ = DecoderFaultKind::WrongCell;
+    auto mem3 = makeMemory(0);
+    auto wrong = FaultFactory::makeDecoderFault(cfg, mem3, VIC_ADDR, AGGR_ADDR);
+    wrong->writeProcess(VIC_ADDR, W(1));
+    assert(mem3->read(VIC_ADDR) == INIT_0 && mem3->read(AGGR_ADDR) == INIT_1);
+    wrong->writeProcess(AGGR_ADDR, W(0));
+    assert(wrong->readProcess(VIC_ADDR, R(1)) == INIT_0);
+    assert(!wrong->observes(VIC_ADDR));
+}
+
+void test_LineFault_row_column()
+{
+    // <0W1/0/-> 作用在整條 row：觸發 cell 寫 1 後整條 row 變 0，其他 row 不受影響
+    auto cfg = makeBaseCfg();
+    cfg->VI_ = INIT_0;
+    cfg->trigger_ = { W(1) };
+    cfg->faultValue_ = INIT_0;
+    cfg->lineScope_ = LineScope::Row;
+    auto mem = makeMemory(1);
+    mem->write(5, INIT_0);                                     // 觸發 cell 在 row 1
+    auto row = FaultFactory::makeLineFault(cfg, mem, 5, { 4, COLS, 1 });
+    assert(row->observes(5) && !row->observes(6));
+    row->writeProcess(6, W(1));                                // 同一 row 的其他 cell 不觸發
+    for (int c = 0; c < COLS; ++c) assert(mem->read(4 + c) == INIT_1 || c == 1);
+    row->writeProcess(5, W(1));
+    for (int c = 0; c < COLS; ++c) assert(mem->read(4 + c) == INIT_0);
+    assert(mem->read(0) == INIT_1 && mem->read(8) == INIT_1);
+
+    // <0R0/1/1> 作用在整條 column：讀觸發 cell 時整條 column 翻成 1
+    cfg->trigger_ = { R(0) };
+    cfg->faultValue_ = INIT_1;
+    cfg->finalReadValue_ = INIT_1;
+    cfg->lineScope_ = LineScope::Column;
+    auto mem2 = makeMemory(0);
+    auto col = FaultFactory::makeLineFault(cfg, mem2, 6, { 2, ROWS, COLS });
+    assert(col->readProcess(6, R(0)) == INIT_1);
+    for (int r = 0; r < ROWS; ++r) assert(mem2->read(r * COLS + 2) == INIT_1);
+    assert(mem2->read(1) == INIT_0 && mem2->read(7) == INIT_0);
+
+    bool threw = false;
+    try { FaultFactory::makeLineFault(cfg, mem2, 3, { 2, ROWS, COLS }); }
+    catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);                                             // 觸發 cell 不在線上
+}
+
+void test_RetentionFault_deadline()
+{
+    // <DRF 1 ~50ms / 0>：寫入 1 後 50ms 沒有再寫入就變成 0，讀取不會重新計時
+    auto cfg = makeBaseCfg();
+    cfg->timeKind_ = TimeFaultKind::Retention;
+    cfg->VI_ = INIT_1;
+    cfg->retentionTime_ = 50 * kNsPerMs;
+    cfg->faultValue_ = INIT_0;
+    auto mem = makeMemory(0);
+    SimClock clock;
+    auto drf = FaultFactory::makeRetentionFault(cfg, mem, VIC_ADDR);
+    drf->attachClock(&clock);
+    assert(drf->timed() && drf->nextEvent() == kNever);          // 初值 0，不會衰減
+    drf->writeProcess(VIC_ADDR, W(1));
+    assert(drf->nextEvent() == 50 * kNsPerMs);
+    clock.advance(30 * kNsPerMs);
+    assert(drf->readProcess(VIC_ADDR, R(1)) == INIT_1);
+    assert(drf->nextEvent() == 50 * kNsPerMs);                  // 讀取不算 restore
+    clock.advance(30 * kNsPerMs);
+    drf->onEvent(clock.now());
+    assert(mem->read(VIC_ADDR) == INIT_0 && drf->nextEvent() == kNever);
+
+    // leakage：讀取也會重新計時
+    cfg->timeKind_ = TimeFaultKind::Leakage;
+    auto mem2 = makeMemory(0);
+    SimClock clock2;
+    auto leak = FaultFactory::makeRetentionFault(cfg, mem2, VIC_ADDR);
+    leak->attachClock(&clock2);
+    leak->writeProcess(VIC_ADDR, W(1));
+    clock2.advance(30 * kNsPerMs);
+    leak->readProcess(VIC_ADDR, R(1));
+    assert(leak->nextEvent() == 80 * kNsPerMs);
+    leak->writeProcess(VIC_ADDR, W(0));                         // 寫入其他值：沒有事件
+    assert(leak->nextEvent() == kNever);
+}
+
+//---------------------------------------------------------------------
+// ProbabilisticFault — 機率 0 / 1 與 inner fault 的關係
+//---------------------------------------------------------------------
+void test_ProbabilisticFault_activation()
+{
+    auto cfg = makeBaseCfg();
+    cfg->VI_ = INIT_0;
+    cfg->faultValue_ = INIT_0;
+    cfg->finalReadValue_ = -1;
+    cfg->trigger_ = { W(1) };                      // TF <0W1/0>
+    const CounterRng rng(1);
+
+    // p = 1：與 inner fault 完全相同
+    auto mem = makeMemory(0);
+    ProbabilisticFault always(mem, FaultFactory::makeOneCellFault(cfg, mem, VIC_ADDR), 1.0,
+                              CounterRngStream(rng, 0));
+    always.writeProcess(VIC_ADDR, W(1));
+    assert(mem->read(VIC_ADDR) == INIT_0);
+
+    // p = 0：敏化了也不生效，行為等同 fault-free
+    auto mem2 = makeMemory(0);
+    ProbabilisticFault never(mem2, FaultFactory::makeOneCellFault(cfg, mem2, VIC_ADDR), 0.0,
+                             CounterRngStream(rng, 0));
+    never.writeProcess(VIC_ADDR, W(1));
+    assert(mem2->read(VIC_ADDR) == INIT_1);
+    assert(never.readProcess(VIC_ADDR, R(1)) == INIT_1);
+}
+
 //---------------------------------------------------------------------
 int main()
 {
@@ -276,6 +597,17 @@ int main()
     test_OneCellFault_DSF_R();
     test_TwoCellFault_SCF_Sa_W();
     test_TwoCellFault_DCF_Sv_R();
+    test_LinkedFault_single_member();
+    test_LinkedFault_masking();
+    test_NCellFault_ANPSF();
+    test_NCellFault_PNPSF_pattern();
+    test_RunLengthMatcher_matches_deque();
+    test_OneCellFault_hammer_R();
+    test_TwoCellFault_hammer_Sa();
+    test_DecoderFault_kinds();
+    test_LineFault_row_column();
+    test_RetentionFault_deadline();
+    test_ProbabilisticFault_activation();
 
     std::cout << "[All Fault & Trigger asserts passed]" << std::endl;
     return 0;
@@ -0,0 +1,79 @@
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include "../include/FaultLibrary.hpp"
+#include "../src/FaultLibrary.cpp"
+
+static FaultConfig faultOf(const std::string& name, int subcase, std::vector<SingleOp> trigger) {
+    FaultConfig cfg;
+    cfg.id_ = { name, subcase };
+    cfg.trigger_ = trigger;
+    return cfg;
+}
+
+void test_interned_names() {
+    const std::string text = "TF";
+    InternedName a(text), b("TF"), c(std::string_view("SAF"));
+    assert(a == b && !(a == c));
+    assert(&a.str() == &b.str());          // 同名共用同一份字串
+    assert(a.hash() == b.hash());
+    assert(InternedName().empty() && a.str() == "TF");
+
+    // 多個 thread 同時 intern 同一個名稱，得到同一份字串
+    const std::string* seen[4] {};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&seen, t] { seen[t] = &InternedName("CFds" + std::to_string(7)).str(); });
+    for (auto& th : threads) th.join();
+    for (int t = 1; t < 4; ++t) assert(seen[t] == seen[0]);
+    std::cout << "test_interned_names passed\n";
+}
+
+void test_inline_trigger() {
+    TriggerOps ops { SingleOp(OpType::W, 1), SingleOp(OpType::R, 1) };
+    assert(ops.size() == 2 && ops.isInline() && ops[1].type_ == OpType::R);
+
+    // 超過 4 個操作時移到 heap，內容不變
+    for (int i = 0; i < 3; ++i) ops.push_back(SingleOp(OpType::W, i & 1));
+    assert(ops.size() == 5 && !ops.isInline());
+    assert(ops.front().value_ == 1 && ops.back().value_ == 0 && ops[2].value_ == 0);
+
+    TriggerOps copy = ops;
+    assert(copy.size() == 5 && copy.data() != ops.data() && copy[4].value_ == 0);
+    TriggerOps moved = std::move(copy);
+    assert(moved.size() == 5 && moved[0].type_ == OpType::W && copy.empty());
+    moved.clear();
+    assert(moved.empty() && moved.isInline());
+    std::cout << "test_inline_trigger passed\n";
+}
+
+void test_library_lookup_and_sharing() {
+    std::vector<FaultConfig> faults;
+    faults.push_back(faultOf("SAF", 0, { SingleOp(OpType::R, 0) }));
+    faults.push_back(faultOf("SAF", 1, { SingleOp(OpType::R, 1) }));
+    faults.push_back(faultOf("TF", 0, { SingleOp(OpType::W, 1) }));
+    faults.push_back(faultOf("SAF", 0, { SingleOp(OpType::W, 0) }));   // 重複的 id
+
+    const FaultLibrary library(std::move(faults));
+    assert(library.size() == 4 && !library.empty());
+    assert(library.find({ "TF", 0 }) == 2);
+    assert(library.find({ "SAF", 0 }) == 0);
+    assert(library.find({ "TF", 1 }) == -1);
+
+    // 複製共用同一份資料
+    const FaultLibrary copy = library;
+    assert(&copy[1] == &library[1] && &copy.faults() == &library.faults());
+    int n = 0;
+    for (const auto& cfg : copy) n += cfg.trigger_.size();
+    assert(n == 4);
+    assert(FaultLibrary().empty() && FaultLibrary().find({ "SAF", 0 }) == -1);
+    std::cout << "test_library_lookup_and_sharing passed\n";
+}
+
+int main() {
+    test_interned_names();
+    test_inline_trigger();
+    test_library_lookup_and_sharing();
+    std::cout << "All FaultLibrary tests passed\n";
+    return 0;
+}
@@ -0,0 +1,1006 @@
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "../include/FaultSimulator.hpp"
+#include "../src/FaultSimulator.cpp"
+#include "../src/AddressAllocator.cpp"
+#include "../src/AnalyticalEngine.cpp"
+#include "../src/Fault.cpp"
+#include "../src/MemoryState.cpp"
+#include "../src/ResultCollector.cpp"
+#include "../src/SensitizationFilter.cpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/ResultStore.cpp"
+#include "../src/SequenceExecutor.cpp"
+#include "../src/SymmetryReducer.cpp"
+
+// 計算 operator new 的呼叫次數 (steady-state 配置測試使用)。
+// 取代整組 new / delete (array、nothrow、aligned、sized)，任何配置都經過同一對 alloc / free
+static std::atomic<long long> g_allocations {0};
+
+static void* countedAlloc(std::size_t size, std::size_t align = alignof(std::max_align_t)) noexcept {
+    ++g_allocations;
+    if (size == 0) size = 1;
+    if (align <= alignof(std::max_align_t)) return std::malloc(size);
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+static void* countedAllocOrThrow(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+    if (void* p = countedAlloc(size, align)) return p;
+    throw std::bad_alloc();
+}
+// 不 inline：否則 GCC 會把內建的 operator new 與這裡的 free 視為不配對 (-Wmismatched-new-delete)
+[[gnu::noinline]] static void countedFree(void* p) noexcept { std::free(p); }
+
+void* operator new(std::size_t size) { return countedAllocOrThrow(size); }
+void* operator new[](std::size_t size) { return countedAllocOrThrow(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return countedAllocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return countedAllocOrThrow(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return countedAlloc(size, static_cast<std::size_t>(al));
+}
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { countedFree(p); }
+
+static MarchElement makeElem(Direction dir, const std::vector<SingleOp>& ops, int elemIdx, int& overallIdx) {
+    MarchElement elem;
+    elem.addrOrder_ = dir;
+    elem.elemIdx_   = elemIdx;
+    for (std::size_t i = 0; i < ops.size(); ++i)
+        elem.ops_.push_back({ops[i], MarchIdx(elemIdx, static_cast<int>(i), overallIdx++)});
+    return elem;
+}
+
+// March C- : b(w0);a(r0,w1);a(r1,w0);d(r0,w1);d(r1,w0);b(r0)
+static std::vector<MarchElement> marchCMinus() {
+    int o = 0;
+    using Op = OpType;
+    return {
+        makeElem(Direction::BOTH, {{Op::W, 0}}, 0, o),
+        makeElem(Direction::ASC,  {{Op::R, 0}, {Op::W, 1}}, 1, o),
+        makeElem(Direction::ASC,  {{Op::R, 1}, {Op::W, 0}}, 2, o),
+        makeElem(Direction::DESC, {{Op::R, 0}, {Op::W, 1}}, 3, o),
+        makeElem(Direction::DESC, {{Op::R, 1}, {Op::W, 0}}, 4, o),
+        makeElem(Direction::BOTH, {{Op::R, 0}}, 5, o),
+    };
+}
+
+static std::vector<FaultConfig> sampleFaults() {
+    std::vector<FaultConfig> out;
+    auto one = [&](int vi, std::vector<SingleOp> trig, int fv, int rv) {
+        FaultConfig c;
+        c.VI_ = vi; c.trigger_ = std::move(trig); c.faultValue_ = fv; c.finalReadValue_ = rv;
+        out.push_back(c);
+    };
+    auto two = [&](TwoCellFaultType t, int ai, int vi, std::vector<SingleOp> trig, int fv, int rv) {
+        FaultConfig c;
+        c.is_twoCell_ = true; c.twoCellFaultType_ = t; c.is_A_less_than_V_ = true;
+        c.AI_ = ai; c.VI_ = vi; c.trigger_ = std::move(trig); c.faultValue_ = fv; c.finalReadValue_ = rv;
+        out.push_back(c);
+    };
+    one(0, {{OpType::W, 1}}, 0, -1);                     // TF
+    one(0, {{OpType::R, 0}}, 1, 1);                      // RDF
+    one(1, {{OpType::W, 0}, {OpType::R, 0}}, 1, 1);      // dRDF
+    one(0, {{OpType::W, 0}, {OpType::W, 0}}, 1, -1);     // 不會被觸發
+    two(TwoCellFaultType::Sa, 0, 0, {{OpType::W, 1}}, 1, -1);
+    two(TwoCellFaultType::Sa, 1, 1, {{OpType::R, 1}}, 0, -1);
+    two(TwoCellFaultType::Sv, 0, 1, {{OpType::R, 1}}, 0, 0);
+    two(TwoCellFaultType::Sv, 1, 0, {}, 1, -1);
+    out.back().is_A_less_than_V_ = false;
+    return out;
+}
+
+// 模擬器交給 observer 的完整 DetectionReport (ResultStore 只保存 syndrome)：reports(fault, init)
+class Collected {
+public:
+    template <typename Sim>
+    Collected(Sim& sim, std::size_t faults) : reports_(faults) {
+        sim.setReportObserver([this](std::size_t f, int init, const DetectionReport& r) { reports_[f][init] = r; });
+    }
+    Collected(const Collected&) = delete;
+    const DetectionReport& operator()(std::size_t fault, int init) const { return reports_[fault][init]; }
+private:
+    std::vector<std::array<DetectionReport, 2>> reports_;
+};
+
+// 位址不同時 detectedVicAddrs_ 必然不同，只比較與擺放位置無關的部分
+static bool sameOutcome(const DetectionReport& a, const DetectionReport& b) {
+    return a.isDetected_ == b.isDetected_ && a.detected_ == b.detected_;
+}
+
+static bool adjacent(int a, int b, int cols) {
+    return std::abs(a / cols - b / cols) <= 1 && std::abs(a % cols - b % cols) <= 1;
+}
+
+void test_overlay_dispatch() {
+    auto mem = std::make_shared<DenseMemoryState>(1, 8, 0);
+    FaultOverlay overlay(mem, 8);
+    FaultConfig sa1;  // write 0 到 victim 時 victim 變成 1
+    sa1.VI_ = 0; sa1.trigger_ = {{OpType::W, 0}}; sa1.faultValue_ = 1;
+    auto shared = std::make_shared<const FaultConfig>(sa1);
+    overlay.add(FaultFactory::makeOneCellFault(shared, mem, 2), {2});
+    assert(overlay.size() == 1);
+    assert(overlay.ownerOf(2) == 0);
+    assert(overlay.ownerOf(3) == -1);
+
+    const SingleOp w0{OpType::W, 0}, r0{OpType::R, 0};
+    overlay.writeProcess(2, w0);
+    overlay.writeProcess(3, w0);
+    assert(overlay.readProcess(2, r0) == 1);  // 由 fault 處理
+    assert(overlay.readProcess(3, r0) == 0);  // 直接存取記憶體
+
+    bool threw = false;
+    try { overlay.add(FaultFactory::makeOneCellFault(shared, mem, 2), {2}); }
+    catch (const std::logic_error&) { threw = true; }
+    assert(threw);
+
+    overlay.clear();
+    assert(overlay.size() == 0 && overlay.ownerOf(2) == -1);
+}
+
+void test_planner_keeps_faults_apart() {
+    const int rows = 8, cols = 8;
+    SpatialPlacementPlanner planner(rows, cols);
+    std::vector<int> used;
+    for (const auto& cfg : sampleFaults()) {
+        auto p = planner.place(cfg);
+        assert(p.second >= 0);
+        std::vector<int> cells = { p.second };
+        if (cfg.is_twoCell_) {
+            assert(p.first >= 0 && p.first / cols == p.second / cols);
+            assert(std::abs(p.first - p.second) == 1);
+            assert(cfg.is_A_less_than_V_ == (p.first < p.second));
+            cells.push_back(p.first);
+        }
+        for (int c : cells)
+            for (int u : used) assert(!adjacent(c, u, cols));
+        used.insert(used.end(), cells.begin(), cells.end());
+    }
+    // 放滿之後回報 -1，clear 後可重新放置
+    FaultConfig one;
+    while (planner.place(one).second >= 0) {}
+    planner.clear();
+    assert(planner.place(one).second == 0);
+}
+
+// 單一 fault 一批與全部打包成一批，偵測結果必須相同
+void test_packed_matches_isolated() {
+    auto march = marchCMinus();
+    const std::vector<FaultConfig> faults = sampleFaults();
+    ResultStore packed(faults.size(), march), isolated(faults.size(), march);
+
+    SpatialFaultSimulator big(faults, march, 16, 16, packed);
+    big.run();
+    assert(big.batchCount() == 2);
+
+    SpatialFaultSimulator small(faults, march, 1, 2, isolated);  // 一次只放得下一個 fault
+    small.run();
+    assert(small.batchCount() > 2);
+
+    for (std::size_t i = 0; i < faults.size(); ++i) {
+        assert(sameOutcome(packed.report(i, 0), isolated.report(i, 0)));
+        assert(sameOutcome(packed.report(i, 1), isolated.report(i, 1)));
+    }
+    assert(big.getDetectedRate() == small.getDetectedRate());
+}
+
+// 1-cell fault 沒有跨位址的效應，空間平行的結果應與逐一模擬一致
+void test_one_cell_matches_one_by_one() {
+    auto march = marchCMinus();
+    std::vector<FaultConfig> faults;
+    for (const auto& cfg : sampleFaults())
+        if (!cfg.is_twoCell_) faults.push_back(cfg);
+    ResultStore spatial(faults.size(), march), oneByOne(faults.size(), march);
+
+    SpatialFaultSimulator sp(faults, march, 8, 8, spatial);
+    sp.run();
+    OneByOneFaultSimulator ob(faults, march, 4, 4, 12345, oneByOne);
+    ob.run();
+    for (std::size_t i = 0; i < faults.size(); ++i) {
+        assert(sameOutcome(spatial.report(i, 0), oneByOne.report(i, 0)));
+        assert(sameOutcome(spatial.report(i, 1), oneByOne.report(i, 1)));
+    }
+    assert(sp.getDetectedRate() == ob.getDetectedRate());
+}
+
+// Solid background 下 1-cell fault 的每個 bit 位置都等同一個 bit-oriented cell
+void test_word_one_cell_matches_bit_model() {
+    auto march = marchCMinus();
+    std::vector<FaultConfig> oneCell;
+    for (const auto& cfg : sampleFaults())
+        if (!cfg.is_twoCell_) oneCell.push_back(cfg);
+    ResultStore bit(oneCell.size(), march);
+
+    WordFaultSimulator word(oneCell, march, 2, 2, 32, { DataBackground::Solid });
+    word.run();
+    OneByOneFaultSimulator ob(oneCell, march, 2, 2, 12345, bit);
+    ob.run();
+    for (std::size_t i = 0; i < oneCell.size(); ++i) {
+        const WordDetectionReport& r = word.reports()[i];
+        assert(r.validLanes_ == 0xFFFFFFFFULL);
+        assert(r.detectedLanes(0) == (bit.detected(i, 0) ? r.validLanes_ : 0));
+        assert(r.detectedLanes(1) == (bit.detected(i, 1) ? r.validLanes_ : 0));
+    }
+    assert(word.getDetectedRate() == ob.getDetectedRate());
+}
+
+// 需要相鄰 bit 不同值才會觸發的 intra-word coupling fault：只有 checkerboard 抓得到
+void test_word_coupling_needs_background() {
+    auto march = marchCMinus();
+    FaultConfig c;  // <0; 1R1 / 0 / 0>：aggressor 為 0 時讀 victim 的 1 會得到 0
+    c.is_twoCell_ = true; c.twoCellFaultType_ = TwoCellFaultType::Sv; c.is_A_less_than_V_ = true;
+    c.AI_ = 0; c.VI_ = 1; c.trigger_ = {{OpType::R, 1}}; c.faultValue_ = 0; c.finalReadValue_ = 0;
+    std::vector<FaultConfig> faults = { c };
+
+    WordFaultSimulator word(faults, march, 2, 2, 8,
+                            { DataBackground::Solid, DataBackground::Checkerboard });
+    word.run();
+    const WordDetectionReport& r = word.reports()[0];
+    assert(r.validLanes_ == 0xFE);            // bit 0 沒有低位的 aggressor
+    assert(r.detected_[0][0] == 0);           // solid：相鄰 bit 永遠相同
+    // checkerboard：background 與其反相兩個 phase 合起來涵蓋所有 bit 位置
+    assert(r.detected_[0][1] == r.validLanes_);
+}
+
+void test_linked_pruning() {
+    auto faults = sampleFaults();
+    // TF <0W1/0> 與 RDF <0R0/1/1>：fault value 相反，且 TF 的結果 0 正是 RDF 的初值 → 可能遮蔽
+    assert(LinkedFaultSimulator::mayInteract(faults[0], faults[1]));
+    assert(!LinkedFaultSimulator::mayInteract(faults[1], faults[2])); // fault value 相同
+    FaultConfig noValue;                                             // fault value 未定義
+    assert(!LinkedFaultSimulator::mayInteract(faults[0], noValue));
+}
+
+// 平行評估的結果與單執行緒相同，且 masked 的組合一定未被偵測
+void test_linked_parallel_deterministic() {
+    auto march = marchCMinus();
+    auto faults = sampleFaults();
+    for (int order : { 2, 3 }) {
+        LinkedFaultSimulator serial(faults, march, 3, 3, order, 1);
+        serial.run();
+        LinkedFaultSimulator parallel(faults, march, 3, 3, order, 4);
+        parallel.run();
+        assert(!serial.reports().empty());
+        assert(serial.prunedCount() > 0);
+        assert(serial.reports().size() == parallel.reports().size());
+        for (std::size_t i = 0; i < serial.reports().size(); ++i) {
+            const auto& a = serial.reports()[i];
+            const auto& b = parallel.reports()[i];
+            assert(a.members_ == b.members_);
+            assert(a.members_.size() == static_cast<std::size_t>(order));
+            for (int init = 0; init < 2; ++init) {
+                assert(a.detected_[init] == b.detected_[init] && a.masked_[init] == b.masked_[init]);
+                assert(!(a.masked_[init] && a.detected_[init]));
+            }
+        }
+        assert(serial.getDetectedRate() == parallel.getDetectedRate());
+    }
+}
+
+// N-cell fault 的效應只在自己的鄰域內，空間平行與逐一模擬的結果應一致
+void test_n_cell_matches_one_by_one() {
+    auto march = marchCMinus();
+    auto nCell = [](int n, std::vector<int> states, int trigCell, SingleOp op, int fv) {
+        FaultConfig cfg;
+        cfg.cellNumber_ = n;
+        cfg.cellStates_ = std::move(states);
+        cfg.triggerCell_ = trigCell;
+        cfg.VI_ = cfg.cellStates_[NeighborhoodLayout::victimIndex(n)];
+        cfg.trigger_ = { op };
+        cfg.faultValue_ = fv;
+        cfg.is_twoCell_ = false;
+        return cfg;
+    };
+    const std::vector<FaultConfig> faults = {
+        nCell(3, { 0, 0, 1 }, 0, { OpType::W, 1 }, 1),
+        nCell(5, { 0, 0, 0, 0, 0 }, 0, { OpType::W, 1 }, 1),
+        nCell(5, { 1, 1, 0, 1, 1 }, 2, { OpType::W, 1 }, 0),
+        nCell(9, { 0, -1, 0, -1, 0, -1, 0, -1, 0 }, 0, { OpType::W, 1 }, 1),
+    };
+    ResultStore spatial(faults.size(), march), oneByOne(faults.size(), march);
+
+    SpatialFaultSimulator sp(faults, march, 8, 8, spatial);
+    sp.run();
+    OneByOneFaultSimulator ob(faults, march, 4, 4, 12345, oneByOne);
+    ob.run();
+    for (std::size_t i = 0; i < faults.size(); ++i) {
+        assert(sameOutcome(spatial.report(i, 0), oneByOne.report(i, 0)));
+        assert(sameOutcome(spatial.report(i, 1), oneByOne.report(i, 1)));
+    }
+    // 全 0 鄰域的 ANPSF 會在 March C- 的第二個 element 被觸發並偵測
+    assert(oneByOne.detected(1, 0));
+}
+
+// op^N 在 March test 中當成一步執行，結果須與逐一展開的 March test 相同
+void test_repeated_march_ops_match_expanded() {
+    int overall = 0;
+    std::vector<MarchElement> counted = {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, overall),
+        makeElem(Direction::ASC,  {{OpType::R, 0, 40}, {OpType::W, 1}}, 1, overall),
+        makeElem(Direction::DESC, {{OpType::W, 1, 40}, {OpType::R, 1}}, 2, overall),
+    };
+    overall = 0;
+    std::vector<SingleOp> r0(40, {OpType::R, 0}), w1(40, {OpType::W, 1});
+    r0.push_back({OpType::W, 1});
+    w1.push_back({OpType::R, 1});
+    std::vector<MarchElement> expanded = {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, overall),
+        makeElem(Direction::ASC,  r0, 1, overall),
+        makeElem(Direction::DESC, w1, 2, overall),
+    };
+
+    auto hammer = [](int vi, SingleOp op, int fv, bool twoCell) {
+        FaultConfig cfg;
+        cfg.VI_ = vi; cfg.trigger_ = { op }; cfg.faultValue_ = fv;
+        if (twoCell) {
+            cfg.is_twoCell_ = true; cfg.is_A_less_than_V_ = true;
+            cfg.twoCellFaultType_ = TwoCellFaultType::Sa; cfg.AI_ = 1; cfg.VI_ = vi;
+        }
+        return cfg;
+    };
+    const std::vector<FaultConfig> faults = {
+        hammer(0, {OpType::R, 0, 40}, 1, false),  // 剛好 40 次 → 觸發
+        hammer(0, {OpType::R, 0, 41}, 1, false),  // 41 次 → 不觸發
+        hammer(0, {OpType::W, 1, 40}, 0, true),   // aggressor 寫 1 共 40 次 (已為 1)
+    };
+    ResultStore ra(faults.size(), counted), rb(faults.size(), expanded);
+    OneByOneFaultSimulator sa(faults, counted, 4, 4, 12345, ra);
+    Collected a(sa, faults.size());
+    sa.run();
+    OneByOneFaultSimulator sb(faults, expanded, 4, 4, 12345, rb);
+    Collected b(sb, faults.size());
+    sb.run();
+    for (std::size_t i = 0; i < faults.size(); ++i) {
+        assert(a(i, 0).isDetected_ == b(i, 0).isDetected_);
+        assert(a(i, 1).isDetected_ == b(i, 1).isDetected_);
+        assert(a(i, 0).detectedVicAddrs_ == b(i, 0).detectedVicAddrs_);
+    }
+    assert(ra.detected(0, 0));
+    assert(!ra.detected(1, 0));
+}
+
+// March C- 可偵測所有 address decoder fault；空間平行模式亦同
+void test_decoder_faults_detected() {
+    auto march = marchCMinus();
+    auto af = [](DecoderFaultKind kind, int value) {
+        FaultConfig cfg;
+        cfg.decoderKind_ = kind;
+        cfg.faultValue_ = value;
+        cfg.is_A_less_than_V_ = false;
+        return cfg;
+    };
+    const std::vector<FaultConfig> faults = {
+        af(DecoderFaultKind::NoAccess, 0), af(DecoderFaultKind::NoAccess, 1),
+        af(DecoderFaultKind::MultiCell, 0), af(DecoderFaultKind::MultiCell, 1),
+        af(DecoderFaultKind::WrongCell, -1),
+    };
+    ResultStore oneByOne(faults.size(), march), spatial(faults.size(), march);
+    OneByOneFaultSimulator ob(faults, march, 4, 4, 12345, oneByOne);
+    ob.run();
+    assert(ob.getDetectedRate() == 1.0);
+    assert(oneByOne.detectedCount() == static_cast<long long>(faults.size() * 2));
+    SpatialFaultSimulator sp(faults, march, 8, 8, spatial);
+    sp.run();
+    assert(sp.getDetectedRate() == 1.0);
+}
+
+// Line fault 一次改變整條 row / column，March C- 會在線上多個 cell 讀到錯誤
+void test_line_faults_detected() {
+    auto march = marchCMinus();
+    auto line = [](LineScope scope, int vi, SingleOp op, int fv, int rv) {
+        FaultConfig cfg;
+        cfg.lineScope_ = scope;
+        cfg.VI_ = vi; cfg.trigger_ = { op }; cfg.faultValue_ = fv; cfg.finalReadValue_ = rv;
+        return cfg;
+    };
+    const std::vector<FaultConfig> faults = {
+        line(LineScope::Row,    0, {OpType::W, 1}, 0, -1),
+        line(LineScope::Column, 0, {OpType::R, 0}, 1, 1),
+        line(LineScope::Row,    0, {OpType::W, 0}, 1, -1),   // init 1 時 March C- 不會在 0 上寫 0
+    };
+    ResultStore oneByOne(faults.size(), march), spatial(faults.size(), march);
+    OneByOneFaultSimulator ob(faults, march, 4, 4, 12345, oneByOne);
+    Collected obReports(ob, faults.size());
+    ob.run();
+    SpatialFaultSimulator sp(faults, march, 8, 8, spatial);
+    Collected spReports(sp, faults.size());
+    sp.run();
+    for (std::size_t i = 0; i < faults.size(); ++i) {
+        assert(oneByOne.detected(i, 0) && spatial.detected(i, 0));
+    }
+    assert(oneByOne.detected(0, 1) && spatial.detected(0, 1));
+    assert(oneByOne.detected(1, 1) && spatial.detected(1, 1));
+    assert(!oneByOne.detected(2, 1) && !spatial.detected(2, 1));
+    // 讀錯的不只觸發 cell
+    assert(obReports(1, 0).detectedVicAddrs_.size() > 1);
+    assert(spReports(1, 0).detectedVicAddrs_.size() > 1);
+}
+
+// Retention fault 只有在 Del 暫停超過 retention time 時才會被偵測；
+// Del 以事件方式跳過，暫停一小時與暫停 100ms 的模擬量相同
+void test_retention_faults_need_delay() {
+    auto timed = [](TimeFaultKind kind, int vi, SimTime t, int fv) {
+        FaultConfig cfg;
+        cfg.timeKind_ = kind; cfg.VI_ = vi; cfg.retentionTime_ = t; cfg.faultValue_ = fv;
+        cfg.is_A_less_than_V_ = false;
+        return cfg;
+    };
+    const std::vector<FaultConfig> faults = {
+        timed(TimeFaultKind::Retention, 1, 50 * kNsPerMs, 0),
+        timed(TimeFaultKind::Leakage,   1, 50 * kNsPerMs, 0),
+        timed(TimeFaultKind::Retention, 0, 3600LL * 1000 * kNsPerMs, 1),
+    };
+    auto run = [&](const std::vector<MarchElement>& march, bool spatial) {
+        ResultStore results(faults.size(), march);
+        if (spatial) { SpatialFaultSimulator sim(faults, march, 8, 8, results); sim.run(); }
+        else         { OneByOneFaultSimulator sim(faults, march, 4, 4, 12345, results); sim.run(); }
+        return results;
+    };
+    int o = 0;
+    // b(w1); b(del30); a(r1); b(del30); b(r1)
+    std::vector<MarchElement> split = {
+        makeElem(Direction::BOTH, {{OpType::W, 1}}, 0, o),
+        makeElem(Direction::BOTH, {{OpType::DEL, 30}}, 1, o),
+        makeElem(Direction::ASC,  {{OpType::R, 1}}, 2, o),
+        makeElem(Direction::BOTH, {{OpType::DEL, 30}}, 3, o),
+        makeElem(Direction::BOTH, {{OpType::R, 1}}, 4, o),
+    };
+    for (bool spatial : { false, true }) {
+        const auto results = run(split, spatial);
+        assert(results.detected(0, 0));   // 60ms 沒有寫入
+        assert(!results.detected(1, 0));  // 中間的讀取重新計時
+        assert(!results.detected(2, 0));
+    }
+    // 同樣的 March test 去掉 Del：沒有任何 fault 被偵測
+    o = 0;
+    std::vector<MarchElement> noDelay = {
+        makeElem(Direction::BOTH, {{OpType::W, 1}}, 0, o),
+        makeElem(Direction::ASC,  {{OpType::R, 1}}, 1, o),
+        makeElem(Direction::BOTH, {{OpType::R, 1}}, 2, o),
+    };
+    const auto none = run(noDelay, false);
+    for (std::size_t i = 0; i < faults.size(); ++i) assert(!none.detected(i, 0));
+    // 一小時的暫停：retention time 一小時的 fault 也會被偵測
+    o = 0;
+    std::vector<MarchElement> hour = {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, o),
+        makeElem(Direction::BOTH, {{OpType::DEL, 3600 * 1000}}, 1, o),
+        makeElem(Direction::ASC,  {{OpType::R, 0}}, 2, o),
+    };
+    for (bool spatial : { false, true }) assert(run(hour, spatial).detected(2, 0));
+}
+
+// Philox4x32-10 的 known-answer vector (Random123)
+void test_counter_rng_known_answers() {
+    const CounterRng zero(0);
+    assert((zero.block({0, 0, 0, 0}) == CounterRng::Block{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    const CounterRng ones(~0ULL);
+    assert((ones.block({~0u, ~0u, ~0u, ~0u}) == CounterRng::Block{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+    // 同一個 (stream, counter) 不論從哪裡取都相同
+    CounterRngStream s(zero, 3, 10);
+    s();
+    assert(s() == zero.bits(3, 11) && s.counter() == 12);
+}
+
+void test_wilson_interval() {
+    assert(std::abs(MonteCarloSimulator::zScore(0.95) - 1.959964) < 1e-5);
+    const double z = MonteCarloSimulator::zScore(0.95);
+    auto [lo, hi] = MonteCarloSimulator::wilson(50, 100, z);
+    assert(lo < 0.5 && hi > 0.5 && std::abs((lo + hi) / 2 - 0.5) < 1e-12);
+    auto [lo0, hi0] = MonteCarloSimulator::wilson(0, 100, z);
+    assert(lo0 == 0.0 && hi0 > 0.0 && hi0 < 0.05);
+}
+
+// 樣本只取決於 (seed, fault, sample)：thread 數不影響結果；
+// 必定偵測 / 不會觸發的 fault 都在樣本下限附近就停止
+void test_monte_carlo() {
+    auto march = marchCMinus();
+    auto faults = sampleFaults();
+    MonteCarloOptions opt;
+    opt.maxSamples = 400;
+    opt.tolerance = 0.05;
+    opt.activation = 0.5;
+    opt.threads = 1;
+    MonteCarloSimulator serial(faults, march, 4, 4, opt);
+    serial.run();
+    opt.threads = 4;
+    MonteCarloSimulator parallel(faults, march, 4, 4, opt);
+    parallel.run();
+    for (std::size_t i = 0; i < faults.size(); ++i) {
+        const auto& a = serial.reports()[i];
+        const auto& b = parallel.reports()[i];
+        assert(a.samples_ == b.samples_ && a.detected_ == b.detected_ && a.lo_ == b.lo_);
+        assert(a.lo_ <= a.estimate() && a.estimate() <= a.hi_);
+    }
+    // TF 在 March C- 中被敏化兩次，各有一半機率生效
+    const auto& tf = serial.reports()[0];
+    assert(tf.estimate() > 0.6 && tf.estimate() < 0.9);
+    assert(serial.reports()[3].detected_ == 0 && serial.reports()[3].converged_);
+
+    opt.activation = 1.0;
+    MonteCarloSimulator certain(faults, march, 4, 4, opt);
+    certain.run();
+    const auto& r = certain.reports()[0];
+    assert(r.converged_ && r.detected_ == r.samples_ && r.hi_ == 1.0 && r.samples_ < opt.maxSamples);
+}
+
+// 各種 fault 交錯 (同一個 pool slot 會被不同 config 重複使用)
+static std::vector<FaultConfig> mixedFaults() {
+    std::vector<FaultConfig> out = sampleFaults();
+    FaultConfig hammer;
+    hammer.VI_ = 0; hammer.trigger_ = {{OpType::R, 0, 3}}; hammer.faultValue_ = 1;
+    out.push_back(hammer);
+    FaultConfig coupledHammer = hammer;
+    coupledHammer.is_twoCell_ = true; coupledHammer.is_A_less_than_V_ = true;
+    coupledHammer.twoCellFaultType_ = TwoCellFaultType::Sa; coupledHammer.AI_ = 0;
+    coupledHammer.trigger_ = {{OpType::W, 1, 2}};
+    out.push_back(coupledHammer);
+    FaultConfig line;
+    line.lineScope_ = LineScope::Column; line.VI_ = 0; line.trigger_ = {{OpType::R, 0}};
+    line.faultValue_ = 1; line.finalReadValue_ = 1;
+    out.push_back(line);
+    FaultConfig decoder;
+    decoder.decoderKind_ = DecoderFaultKind::MultiCell; decoder.faultValue_ = 1;
+    out.push_back(decoder);
+    decoder.decoderKind_ = DecoderFaultKind::NoAccess; decoder.faultValue_ = 0;
+    out.push_back(decoder);
+    FaultConfig npsf;
+    npsf.cellNumber_ = 5; npsf.cellStates_ = { 0, 0, 0, 0, 0 }; npsf.triggerCell_ = 0;
+    npsf.VI_ = 0; npsf.trigger_ = {{OpType::W, 1}}; npsf.faultValue_ = 1;
+    out.push_back(npsf);
+    FaultConfig retention;
+    retention.timeKind_ = TimeFaultKind::Retention; retention.retentionTime_ = 1000;
+    retention.VI_ = 1; retention.faultValue_ = 0;
+    out.push_back(retention);
+    // 再來一輪，讓每個 slot 都被 bind 過
+    const std::size_t n = out.size();
+    for (std::size_t i = 0; i < n; ++i) out.push_back(out[i]);
+    return out;
+}
+
+// OneByOne 以 FaultPool 重複使用 fault 物件，結果須與每次重新建立 fault 完全相同 (含位址)
+void test_fault_pool_matches_fresh_faults() {
+    auto march = marchCMinus();
+    const std::vector<FaultConfig> pooled = mixedFaults();
+    ResultStore results(pooled.size(), march);
+    OneByOneFaultSimulator ob(pooled, march, 4, 4, 12345, results);
+    Collected reports(ob, pooled.size());
+    ob.run();
+
+    AddressAllocator allocator(4, 4, 12345);
+    SensitizationFilter filter(march);
+    for (int init = 0; init < 2; ++init) {
+        auto mem = MemoryState::create(4, 4, init);
+        for (std::size_t i = 0; i < pooled.size(); ++i) {
+            const FaultConfig& cfg = pooled[i];
+            const DetectionReport& got = reports(i, init);
+            int aggr, vic;
+            std::vector<int> cells;
+            allocateFor(allocator, cfg, aggr, vic, cells);
+            if (!filter.canTrigger(cfg, init)) {
+                assert(got == DetectionReport());
+                continue;
+            }
+            mem->reset();
+            OneByOneResultCollector collector;
+            SequenceExecutor executor(16, collector);
+            auto fault = buildFault(cfg, mem, allocator, aggr, vic, cells, 4);
+            executor.execute(march, *fault);
+            assert(collector.getReport() == got);
+            assert(results.syndrome(i, init) == ResultStore::toSyndrome(got, results.reads()));
+        }
+    }
+}
+
+// 暖機之後逐一模擬不再配置記憶體：工作物件與暫存的 report 都重複使用，結果寫入事先配置的
+// ResultStore，因此配置次數與 fault 數無關 (再次 run() 時亦同)
+void test_one_by_one_steady_state_allocations() {
+    auto march = marchCMinus();
+    for (MemoryKind kind : { MemoryKind::Dense, MemoryKind::Paged }) {
+        long long first[2], rerun[2];
+        for (int copies : { 1, 8 }) {
+            std::vector<FaultConfig> faults;
+            for (int c = 0; c < copies; ++c) {
+                auto batch = mixedFaults();
+                faults.insert(faults.end(), batch.begin(), batch.end());
+            }
+            ResultStore results(faults.size(), march);
+            OneByOneFaultSimulator ob(faults, march, 4, 4, 12345, results);
+            ob.setMemoryKind(kind);
+
+            const long long before = g_allocations;
+            ob.run();
+            const long long again = g_allocations;
+            ob.run();
+            const int k = copies == 1 ? 0 : 1;
+            first[k] = again - before;
+            rerun[k] = g_allocations - again;
+        }
+        assert(first[0] == first[1]);
+        assert(rerun[0] == rerun[1]);
+    }
+}
+
+// ⇕ 兩個方向：分岔的結果須等於把每個 ⇕ 改成 ⇑ / ⇓ 的所有組合中最差的那一個
+void test_both_directions_worst_case() {
+    // b(w0);b(r0,w1);a(r1,w0);b(r0)：coupling fault 是否被偵測取決於 ⇕ 的方向
+    int o = 0;
+    const std::vector<MarchElement> march {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, o),
+        makeElem(Direction::BOTH, {{OpType::R, 0}, {OpType::W, 1}}, 1, o),
+        makeElem(Direction::ASC,  {{OpType::R, 1}, {OpType::W, 0}}, 2, o),
+        makeElem(Direction::BOTH, {{OpType::R, 0}}, 3, o),
+    };
+    std::vector<int> both;
+    for (int e = 0; e < static_cast<int>(march.size()); ++e)
+        if (march[e].addrOrder_ == Direction::BOTH) both.push_back(e);
+    for (MemoryKind kind : { MemoryKind::Dense, MemoryKind::Paged }) {
+        const std::vector<FaultConfig> faults = mixedFaults();
+        ResultStore results(faults.size(), march);
+        OneByOneFaultSimulator ob(faults, march, 4, 4, 12345, results);
+        Collected forked(ob, faults.size());
+        ob.setMemoryKind(kind);
+        ob.setBothDirections(true);
+        ob.setAnalyticalMode(AnalyticalMode::FastPath); // 有 ⇕ 時不得使用
+        ob.setSymmetryReduction(true);
+        ob.run();
+
+        std::vector<std::unique_ptr<Collected>> combos;
+        for (int mask = 0; mask < (1 << both.size()); ++mask) {
+            auto fixed = march;
+            for (std::size_t k = 0; k < both.size(); ++k)
+                fixed[both[k]].addrOrder_ = (mask >> k & 1) ? Direction::DESC : Direction::ASC;
+            ResultStore plainResults(faults.size(), fixed);
+            OneByOneFaultSimulator plain(faults, fixed, 4, 4, 12345, plainResults);
+            combos.push_back(std::make_unique<Collected>(plain, faults.size()));
+            plain.setMemoryKind(kind);
+            plain.run();
+        }
+        int weaker = 0;
+        for (std::size_t i = 0; i < faults.size(); ++i) {
+            for (int init = 0; init < 2; ++init) {
+                const DetectionReport& got = forked(i, init);
+                assert(results.detected(i, init) == got.isDetected_);
+                bool all = true, some = false, matchesOne = false;
+                for (const auto& c : combos) {
+                    const DetectionReport& r = (*c)(i, init);
+                    all = all && r.isDetected_;
+                    some = some || r.isDetected_;
+                    matchesOne = matchesOne || r == got;
+                }
+                assert(got.isDetected_ == all);
+                assert(matchesOne);
+                if (some && !all) ++weaker;
+            }
+        }
+        assert(weaker > 0); // 這組 fault 中確實有只在某個方向才偵測得到的
+    }
+
+    // 沒有 fault 時兩個方向的狀態相同，分支立即合併
+    auto mem = MemoryState::create(4, 4, 0);
+    OneByOneResultCollector collector;
+    SequenceExecutor executor(16, collector);
+    executor.setBothDirections(true);
+    FaultOverlay healthy(mem, 16);
+    executor.execute(MarchProgram(march, 4, 4), healthy);
+    assert(executor.peakBranches() == 1);
+    assert(!collector.report().isDetected_ && collector.report().detected_.size() == 3);
+    std::cout << "test_both_directions_worst_case passed\n";
+}
+
+// 記錄每次讀取的時間；saveState 帶著第一個寫入的位址，讓 ⇑ / ⇓ 的分支狀態不同而不會合併
+class ReadClockProbe final : public IFault {
+public:
+    explicit ReadClockProbe(std::shared_ptr<MemoryState> mem) : IFault(nullptr, std::move(mem), nullptr, -1) {}
+    void writeProcess(int addr, const SingleOp& op) override {
+        if (firstWrite_ == kNever) firstWrite_ = addr;
+        mem_->write(addr, op.value_);
+    }
+    int readProcess(int addr, const SingleOp& op) override {
+        (void)op;
+        times.push_back(clock_->now());
+        return mem_->read(addr);
+    }
+    FaultForkState saveState() const override { return { firstWrite_ }; }
+    void restoreState(const FaultForkState& state) override { firstWrite_ = state.deadline; }
+
+    std::vector<SimTime> times;
+
+private:
+    SimTime firstWrite_ {kNever};
+};
+
+// 把 march 中的每個 ⇕ 依 mask 改成 ⇑ (0) / ⇓ (1)
+static std::vector<MarchElement> fixDirections(std::vector<MarchElement> march, int mask) {
+    for (auto& elem : march) {
+        if (elem.addrOrder_ != Direction::BOTH) continue;
+        elem.addrOrder_ = (mask & 1) ? Direction::DESC : Direction::ASC;
+        mask >>= 1;
+    }
+    return march;
+}
+
+// 偵測的嚴格程度：先比是否偵測，再比讀錯的 read 數 (越小越差)
+static std::pair<bool, int> strength(const DetectionReport& r) {
+    int reads = 0;
+    for (const auto& [idx, hit] : r.detected_) reads += hit;
+    return { r.isDetected_, reads };
+}
+
+// 分岔時每個分支的 ⇑ 與 ⇓ 都從 element 開頭的時間開始：兩個分支同時存在時，
+// 讀取時間與 retention fault 的偵測結果都須與不分岔、逐一組合執行的結果相同
+void test_both_directions_clock() {
+    int o = 0;
+    const std::vector<MarchElement> probeMarch {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, o),
+        makeElem(Direction::BOTH, {{OpType::R, 0}}, 1, o),
+    };
+    {
+        auto mem = MemoryState::create(1, 4, 0);
+        OneByOneResultCollector collector;
+        SequenceExecutor executor(4, collector);
+        executor.setBothDirections(true);
+        ReadClockProbe probe(mem);
+        executor.execute(MarchProgram(probeMarch, 1, 4), probe);
+        assert(executor.peakBranches() == 2);
+        assert(executor.elapsed() == 8 * kDefaultCycleTime);
+        // 兩個分支 × 兩個方向，每次都在 element 1 的時間範圍內讀取 4 個位址
+        assert(probe.times.size() == 16);
+        for (SimTime t : probe.times) assert(t >= 4 * kDefaultCycleTime && t < 8 * kDefaultCycleTime);
+    }
+
+    // b(w1);b(r1,w1);b(r1);a(r1)：retention fault 是否被偵測取決於 victim 上次寫入的時間
+    o = 0;
+    const std::vector<MarchElement> march {
+        makeElem(Direction::BOTH, {{OpType::W, 1}}, 0, o),
+        makeElem(Direction::BOTH, {{OpType::R, 1}, {OpType::W, 1}}, 1, o),
+        makeElem(Direction::BOTH, {{OpType::R, 1}}, 2, o),
+        makeElem(Direction::ASC,  {{OpType::R, 1}}, 3, o),
+    };
+    auto run = [](const std::vector<MarchElement>& m, const std::shared_ptr<const FaultConfig>& cfg, int vic,
+                  bool both, int* peak) {
+        auto mem = MemoryState::create(1, 4, 0);
+        auto fault = RetentionFault::create(cfg, mem, vic);
+        OneByOneResultCollector collector;
+        SequenceExecutor executor(4, collector);
+        executor.setBothDirections(both);
+        executor.execute(MarchProgram(m, 1, 4), *fault);
+        if (peak) *peak = executor.peakBranches();
+        return collector.report();
+    };
+    int forkedCases = 0, weaker = 0;
+    for (SimTime t = kDefaultCycleTime; t <= 14 * kDefaultCycleTime; t += kDefaultCycleTime) {
+        auto cfg = std::make_shared<FaultConfig>();
+        cfg->timeKind_ = TimeFaultKind::Retention; cfg->VI_ = 1; cfg->retentionTime_ = t; cfg->faultValue_ = 0;
+        for (int vic = 0; vic < 4; ++vic) {
+            int peak = 1;
+            const DetectionReport got = run(march, cfg, vic, true, &peak);
+            bool all = true, some = false, matchesOne = false;
+            auto worst = strength(got);
+            for (int mask = 0; mask < 8; ++mask) {
+                const DetectionReport r = run(fixDirections(march, mask), cfg, vic, false, nullptr);
+                all = all && r.isDetected_;
+                some = some || r.isDetected_;
+                matchesOne = matchesOne || r == got;
+                worst = std::min(worst, strength(r));
+            }
+            assert(got.isDetected_ == all);
+            assert(matchesOne && strength(got) == worst);
+            if (peak >= 2) ++forkedCases;
+            if (some && !all) ++weaker;
+        }
+    }
+    assert(forkedCases > 0 && weaker > 0);
+    std::cout << "test_both_directions_clock passed\n";
+}
+
+// 讀錯的 read 依走訪順序而定 (沒有跨 element 的狀態)：每個 element 第一個存取的位址不會讀錯，
+// 之後的位址在 ⇑ 時第 0 次讀取讀錯，在 ⇓ 時第 1、2 次讀取讀錯
+class OrderProbe final : public IFault {
+public:
+    explicit OrderProbe(std::shared_ptr<MemoryState> mem) : IFault(nullptr, std::move(mem), nullptr, -1) {}
+    void reset() override { first_ = -1; reads_ = 0; }
+    void writeProcess(int addr, const SingleOp& op) override {
+        if (first_ < 0) first_ = addr;
+        mem_->write(addr, op.value_);
+    }
+    int readProcess(int addr, const SingleOp& op) override {
+        (void)op;
+        if (first_ < 0) first_ = addr;
+        const int value = mem_->read(addr);
+        if (addr == first_) return value;
+        const int k = reads_++;
+        const bool wrong = addr > first_ ? k == 0 : (k == 1 || k == 2);
+        return wrong ? value ^ 1 : value;
+    }
+
+private:
+    int first_ {-1};
+    int reads_ {0};
+};
+
+// ⇕ 之後還有 element：兩個方向狀態相同、但讀錯的 read 互不包含時，兩個分支都要保留到最後，
+// 結果為所有組合中最差的那一個 (與之後的 element 讀錯哪些 read 無關)
+void test_both_directions_keeps_incomparable_branches() {
+    int o = 0;
+    // b(w0);b(r0,r0,r0);a(r0,r0,r0);b(r0,r0,r0)
+    const std::vector<MarchElement> march {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, o),
+        makeElem(Direction::BOTH, {{OpType::R, 0}, {OpType::R, 0}, {OpType::R, 0}}, 1, o),
+        makeElem(Direction::ASC,  {{OpType::R, 0}, {OpType::R, 0}, {OpType::R, 0}}, 2, o),
+        makeElem(Direction::BOTH, {{OpType::R, 0}, {OpType::R, 0}, {OpType::R, 0}}, 3, o),
+    };
+    auto run = [](const std::vector<MarchElement>& m, bool both, int* peak) {
+        auto mem = MemoryState::create(1, 2, 0);
+        OrderProbe probe(mem);
+        OneByOneResultCollector collector;
+        SequenceExecutor executor(2, collector);
+        executor.setBothDirections(both);
+        executor.execute(MarchProgram(m, 1, 2), probe);
+        if (peak) *peak = executor.peakBranches();
+        return collector.report();
+    };
+    int peak = 1;
+    const DetectionReport got = run(march, true, &peak);
+    assert(peak >= 2); // element 1 之後：⇑ 讀錯 {r0}、⇓ 讀錯 {r1, r2}，記憶體相同但不能合併
+
+    DetectionReport worst;
+    bool first = true;
+    for (int mask = 0; mask < 8; ++mask) {
+        const DetectionReport r = run(fixDirections(march, mask), false, nullptr);
+        if (first || strength(r) < strength(worst)) worst = r;
+        first = false;
+    }
+    assert(got == worst);
+    assert(strength(got) == std::make_pair(true, 3)); // ⇑, ⇑/⇓ 後兩個 element 各讀錯 1 個
+    std::cout << "test_both_directions_keeps_incomparable_branches passed\n";
+}
+
+// 中途停止再由 (cursor, 亂數狀態) 接續，結果與一次跑完相同 (接續時開啟對稱性化簡也一樣)
+void test_one_by_one_resume() {
+    auto march = marchCMinus();
+    const std::vector<FaultConfig> faults = mixedFaults();
+    ResultStore expected(faults.size(), march);
+    OneByOneFaultSimulator full(faults, march, 4, 4, 12345, expected);
+    full.run();
+    assert(full.cursor().finished() && full.cursor().done(faults.size()) == static_cast<long long>(faults.size()) * 2);
+
+    for (const RunCursor stop : { RunCursor{ 0, 5 }, RunCursor{ 1, 0 }, RunCursor{ 1, 7 }, RunCursor{ 2, 0 } }) {
+        ResultStore results(faults.size(), march);
+        RunCursor saved;
+        std::string rng;
+        {
+            OneByOneFaultSimulator first(faults, march, 4, 4, 12345, results);
+            first.setProgressCallback([&](const RunCursor& next) {
+                if (!(next == stop)) return;
+                saved = next;
+                rng = first.allocatorState();
+                throw std::runtime_error("stop");
+            });
+            bool stopped = false;
+            try { first.run(); } catch (const std::runtime_error&) { stopped = true; }
+            assert(stopped && first.cursor() == stop);
+        }
+        OneByOneFaultSimulator second(faults, march, 4, 4, 12345, results);
+        second.setSymmetryReduction(true);
+        second.resumeAt(saved, rng);
+        second.run();
+        assert(second.getDetectedRate() == full.getDetectedRate());
+        for (std::size_t i = 0; i < faults.size(); ++i)
+            for (int init = 0; init < 2; ++init)
+                assert(results.syndrome(i, init) == expected.syndrome(i, init));
+    }
+
+    // 跑完之後再 run() 一次會從頭重新計算
+    std::size_t again = 0;
+    full.setReportObserver([&](std::size_t, int, const DetectionReport&) { ++again; });
+    full.run();
+    assert(again == faults.size() * 2);
+
+    bool threw = false;
+    try { full.resumeAt(RunCursor{ 0, faults.size() + 1 }, full.allocatorState()); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "test_one_by_one_resume passed\n";
+}
+
+// 分成幾段各自計算 (可在中途接續)，合起來與一次跑完相同；每段只模擬自己範圍內的 fault
+void test_one_by_one_fault_range() {
+    auto march = marchCMinus();
+    const std::vector<FaultConfig> faults = mixedFaults();
+    ResultStore expected(faults.size(), march);
+    OneByOneFaultSimulator full(faults, march, 4, 4, 12345, expected);
+    full.run();
+
+    const std::size_t cuts[] = { 0, 3, 3, 11, faults.size() }; // 含一段空的範圍
+    ResultStore merged(faults.size(), march);
+    for (std::size_t k = 0; k + 1 < std::size(cuts); ++k) {
+        ResultStore results(faults.size(), march);
+        OneByOneFaultSimulator part(faults, march, 4, 4, 12345, results);
+        part.setFaultRange(cuts[k], cuts[k + 1]);
+        assert((part.cursor() == RunCursor{ 0, cuts[k] }));
+        std::size_t simulated = 0;
+        part.setReportObserver([&](std::size_t f, int, const DetectionReport&) {
+            assert(f >= cuts[k] && f < cuts[k + 1]);
+            ++simulated;
+        });
+        // 在 init 1 的中途停下再接續
+        RunCursor saved { 2, 0 };
+        std::string rng;
+        part.setProgressCallback([&](const RunCursor& next) {
+            if (next.init == 1 && next.fault == cuts[k] + 1) {
+                saved = next;
+                rng = part.allocatorState();
+                throw std::runtime_error("stop");
+            }
+        });
+        try { part.run(); } catch (const std::runtime_error&) {}
+        if (!saved.finished()) {
+            OneByOneFaultSimulator rest(faults, march, 4, 4, 12345, results);
+            rest.setFaultRange(cuts[k], cuts[k + 1]);
+            rest.resumeAt(saved, rng);
+            rest.run();
+            assert(rest.cursor().finished());
+            assert((saved.done(cuts[k], cuts[k + 1]) == static_cast<long long>(cuts[k + 1] - cuts[k]) + 1));
+        } else {
+            assert(part.cursor().finished() && simulated == (cuts[k + 1] - cuts[k]) * 2);
+        }
+        merged.copyRows(results, cuts[k], cuts[k + 1]);
+    }
+    for (std::size_t i = 0; i < faults.size(); ++i)
+        for (int init = 0; init < 2; ++init)
+            assert(merged.syndrome(i, init) == expected.syndrome(i, init));
+
+    bool threw = false;
+    try { full.setFaultRange(5, faults.size() + 1); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "test_one_by_one_fault_range passed\n";
+}
+
+int main() {
+    test_linked_pruning();
+    test_linked_parallel_deterministic();
+    test_word_one_cell_matches_bit_model();
+    test_word_coupling_needs_background();
+    test_overlay_dispatch();
+    test_planner_keeps_faults_apart();
+    test_packed_matches_isolated();
+    test_one_cell_matches_one_by_one();
+    test_n_cell_matches_one_by_one();
+    test_repeated_march_ops_match_expanded();
+    test_decoder_faults_detected();
+    test_line_faults_detected();
+    test_retention_faults_need_delay();
+    test_counter_rng_known_answers();
+    test_wilson_interval();
+    test_monte_carlo();
+    test_fault_pool_matches_fresh_faults();
+    test_one_by_one_steady_state_allocations();
+    test_both_directions_worst_case();
+    test_both_directions_clock();
+    test_both_directions_keeps_incomparable_branches();
+    test_one_by_one_resume();
+    test_one_by_one_fault_range();
+    std::cout << "All FaultSimulator tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+#include "nlohmann/json.hpp"
+#include "../include/MarchLibrary.hpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/SequenceExecutor.cpp"
+#include "../src/Fault.cpp"
+#include "../src/MemoryState.cpp"
+#include "../src/ResultCollector.cpp"
+#include "../src/ResultStore.cpp"
+#include "../src/Parser.cpp"
+#include "../src/AddressDecoder.cpp"
+#include "../src/DataBackground.cpp"
+
+// ── 編譯期檢查 ──
+constexpr StaticMarch kMatsPP = StaticMarch::parse("b(w0);a(r0,w1);d(r1,w0,r0)");
+static_assert(kMatsPP.elementCount == 3 && kMatsPP.opCount == 6);
+static_assert(kMatsPP.elems[2].dir == Direction::DESC && kMatsPP.elems[2].begin == 3 && kMatsPP.elems[2].end == 6);
+static_assert(kMatsPP.ops[5].type == OpType::R && kMatsPP.ops[5].value == 0 && kMatsPP.ops[5].opIdx == 2);
+
+// 一個 token 內多個操作共用 opIdx；op^N、co、del 與大小寫
+constexpr StaticMarch kMixed = StaticMarch::parse(" A( R0W1 , w0^500, CO ); b(del100) ");
+static_assert(kMixed.elementCount == 2 && kMixed.opCount == 5);
+static_assert(kMixed.ops[0].opIdx == 0 && kMixed.ops[1].opIdx == 0 && kMixed.ops[1].type == OpType::W);
+static_assert(kMixed.ops[2].repeat == 500 && kMixed.ops[2].opIdx == 1);
+static_assert(kMixed.ops[3].type == OpType::CO && kMixed.ops[3].value == -1);
+static_assert(kMixed.ops[4].type == OpType::DEL && kMixed.ops[4].value == 100);
+
+static_assert(MarchLibrary::find("March C-") == 3);
+static_assert(MarchLibrary::find("no such test") == -1);
+
+static const char* kMarch = "t_MarchLibrary.march.tmp.json";
+
+// 記錄 fault 看到的每個操作
+class TraceFault : public IFault {
+public:
+    TraceFault(std::shared_ptr<MemoryState> mem, int badAddr)
+        : IFault(nullptr, std::move(mem), nullptr, -1), badAddr_(badAddr) {}
+    int readProcess(int addr, const SingleOp& op) override {
+        trace_.emplace_back('R', addr, op.value_);
+        const int v = mem_->read(addr);
+        return addr == badAddr_ ? v ^ 1 : v;
+    }
+    void writeProcess(int addr, const SingleOp& op) override {
+        trace_.emplace_back('W', addr, op.value_);
+        mem_->write(addr, op.value_);
+    }
+    void reset() override { trace_.emplace_back('-', 0, 0); }
+    std::vector<std::tuple<char, int, int>> trace_;
+    int badAddr_;
+};
+
+class TraceCollector : public IResultCollector {
+public:
+    void opRecord(const MarchIdx& idx, int addr, bool mismatch) override {
+        trace_.emplace_back(idx.marchIdx, idx.opIdx, idx.overallIdx, addr * 2 + mismatch);
+    }
+    DetectionReport getReport() const override { return {}; }
+    void reset() override { trace_.clear(); }
+    std::vector<std::tuple<int, int, int, int>> trace_;
+};
+
+// 不經過 MarchProgram 的參考實作：逐一走訪 MarchElement
+static void reference(const std::vector<MarchElement>& march, int size, TraceFault& fault, TraceCollector& col) {
+    for (const auto& elem : march) {
+        fault.reset();
+        bool pause = !elem.ops_.empty();
+        for (const auto& pop : elem.ops_) pause = pause && pop.op_.type_ == OpType::DEL;
+        if (pause) continue;
+        for (int n = 0; n < size; ++n) {
+            const int addr = elem.addrOrder_ == Direction::DESC ? size - 1 - n : n;
+            for (const auto& pop : elem.ops_) {
+                if (pop.op_.type_ == OpType::R)
+                    col.opRecord(pop.idx_, addr, fault.readProcess(addr, pop.op_) != pop.op_.value_);
+                else if (pop.op_.type_ == OpType::W)
+                    fault.writeProcess(addr, pop.op_);
+            }
+        }
+    }
+}
+
+void test_matches_json_library() {
+    // 與 make run / run-test 相同，在 repo 根目錄執行
+    const char* path = "input/All_MarchTest.json";
+    std::ifstream ifs(path);
+    if (!ifs) {
+        std::cerr << "找不到 " << path << "，請在 repo 根目錄執行測試\n";
+        std::exit(1);
+    }
+    nlohmann::json lib;
+    ifs >> lib;
+    assert(static_cast<int>(lib.size()) == MarchLibrary::kCount);
+    Parser parser;
+    for (int i = 0; i < MarchLibrary::kCount; ++i) {
+        assert(lib[i]["name"].get<std::string>() == MarchLibrary::kTests[i].name);
+        assert(lib[i]["pattern"].get<std::string>() == MarchLibrary::kTests[i].pattern);
+
+        // Parser 讀出的結果與編譯期解析相同，且會被認出是內建 test
+        std::ofstream(kMarch) << lib[i].dump();
+        const auto parsed = parser.parseMarchTest(kMarch);
+        assert(MarchLibrary::match(parsed) == i);
+        assert(MarchProgram(parsed, 9).builtin() == i);
+
+        const auto builtin = parser.parseMarchTest("builtin:" + lib[i]["name"].get<std::string>());
+        assert(builtin.size() == parsed.size());
+        for (std::size_t e = 0; e < parsed.size(); ++e) {
+            assert(builtin[e].addrOrder_ == parsed[e].addrOrder_ && builtin[e].elemIdx_ == parsed[e].elemIdx_);
+            assert(builtin[e].ops_.size() == parsed[e].ops_.size());
+            for (std::size_t k = 0; k < parsed[e].ops_.size(); ++k) {
+                assert(builtin[e].ops_[k].idx_ == parsed[e].ops_[k].idx_);
+                assert(builtin[e].ops_[k].op_.type_ == parsed[e].ops_[k].op_.type_);
+                assert(builtin[e].ops_[k].op_.value_ == parsed[e].ops_[k].op_.value_);
+            }
+        }
+    }
+    std::remove(kMarch);
+
+    bool threw = false;
+    try { parser.parseMarchTest("builtin:March Z"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::cout << "test_matches_json_library passed\n";
+}
+
+void test_non_builtin_uses_generic_path() {
+    auto march = MarchLibrary::toElements(MarchLibrary::kTests[0].march);
+    assert(MarchLibrary::match(march) == 0);
+    march[1].addrOrder_ = Direction::DESC;
+    assert(MarchLibrary::match(march) == -1);
+    assert(MarchProgram(march, 4).builtin() == -1);
+    std::cout << "test_non_builtin_uses_generic_path passed\n";
+}
+
+void test_kernels_match_reference() {
+    const int size = 9;
+    for (int i = 0; i < MarchLibrary::kCount; ++i) {
+        const auto march = MarchLibrary::toElements(MarchLibrary::kTests[i].march);
+        const MarchProgram program(march, size);
+        assert(program.builtin() == i);
+        for (int bad : { -1, 0, 4 }) {
+            TraceFault f1(MemoryState::create(3, 3, 0), bad), f2(MemoryState::create(3, 3, 0), bad);
+            TraceCollector c1, c2;
+            SequenceExecutor executor(size, c1);
+            executor.execute(program, f1);
+            reference(march, size, f2, c2);
+            assert(f1.trace_ == f2.trace_);
+            assert(c1.trace_ == c2.trace_);
+        }
+    }
+    std::cout << "test_kernels_match_reference passed\n";
+}
+
+void test_kernel_clock() {
+    // 內建 kernel 與一般路徑的模擬時間相同：March C- 共 10 個操作 x 9 個位址
+    const auto march = MarchLibrary::toElements(MarchLibrary::kTests[MarchLibrary::find("March C-")].march);
+    TraceFault fault(MemoryState::create(3, 3, 0), -1);
+    TraceCollector col;
+    SequenceExecutor executor(9, col);
+    executor.execute(MarchProgram(march, 9), fault);
+    assert(executor.elapsed() == 10 * 9 * kDefaultCycleTime);
+    std::cout << "test_kernel_clock passed\n";
+}
+
+int main() {
+    test_matches_json_library();
+    test_non_builtin_uses_generic_path();
+    test_kernels_match_reference();
+    test_kernel_clock();
+    std::cout << "All MarchLibrary tests passed\n";
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include "../include/MarchProgram.hpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../include/Fault.hpp"
+#include "../src/Fault.cpp"
+#include "../include/MemoryState.hpp"
+#include "../src/MemoryState.cpp"
+#include "../include/ResultCollector.hpp"
+#include "../src/ResultCollector.cpp"
+#include "../include/SequenceExecutor.hpp"
+#include "../src/SequenceExecutor.cpp"
+
+constexpr int MEM_SIZE = 4;
+
+static MarchElement makeElem(Direction dir, const std::vector<SingleOp>& ops, int elemIdx, int& overallIdx) {
+    MarchElement elem;
+    elem.addrOrder_ = dir;
+    elem.elemIdx_   = elemIdx;
+    for (std::size_t i = 0; i < ops.size(); ++i)
+        elem.ops_.push_back({ops[i], MarchIdx(elemIdx, static_cast<int>(i), overallIdx++)});
+    return elem;
+}
+
+// b(w0);a(r0,w1);Del10;d(r1,w0,r0)
+static std::vector<MarchElement> sample() {
+    int o = 0;
+    using Op = OpType;
+    return {
+        makeElem(Direction::BOTH, {{Op::W, 0}}, 0, o),
+        makeElem(Direction::ASC,  {{Op::R, 0}, {Op::W, 1}}, 1, o),
+        makeElem(Direction::BOTH, {{Op::DEL, 10}}, 2, o),
+        makeElem(Direction::DESC, {{Op::R, 1}, {Op::W, 0}, {Op::R, 0}}, 3, o),
+    };
+}
+
+// 正常運作的記憶體：讀寫直接存取 MemoryState
+class HealthyFault : public IFault {
+public:
+    explicit HealthyFault(std::shared_ptr<MemoryState> mem) : IFault(nullptr, std::move(mem), nullptr, -1) {}
+    int readProcess(int addr, const SingleOp&) override { return mem_->read(addr); }
+    void writeProcess(int addr, const SingleOp& op) override { mem_->write(addr, op.value_); }
+};
+
+// 記錄每次 read 的 (element, op, 位址, mismatch)
+class TraceCollector : public IResultCollector {
+public:
+    void opRecord(const MarchIdx& idx, int addr, bool mismatch) override {
+        trace_.push_back({ idx.marchIdx, idx.overallIdx, addr, mismatch });
+    }
+    DetectionReport getReport() const override { return {}; }
+    void reset() override { trace_.clear(); }
+    std::vector<std::array<int, 4>> trace_;
+};
+
+void test_layout() {
+    const MarchProgram program(sample(), MEM_SIZE);
+    assert(program.memorySize() == MEM_SIZE);
+    assert(program.elementCount() == 4);
+    assert(program.opCount() == 7);
+    assert(program.readCount() == 3);
+
+    assert(program.opBegin(1) == 1 && program.opEnd(1) == 3);
+    assert(program.opBegin(3) == 4 && program.opEnd(3) == 7);
+
+    // ⇕ 以遞增執行，⇓ 從最後一個位址往回
+    assert(program.firstPos(0) == 0 && program.posStep(0) == 1);
+    assert(program.firstPos(3) == MEM_SIZE - 1 && program.posStep(3) == -1);
+
+    // 只有 Del 的 element 是整體暫停
+    assert(!program.pause(1));
+    assert(program.pause(2));
+    assert(program.kind(3) == MarchProgram::Delay);
+    assert(program.delay(3) == 10 * kNsPerMs);
+
+    assert(program.kind(1) == MarchProgram::Read && program.value(1) == 0);
+    assert(program.kind(2) == MarchProgram::Write && program.value(2) == 1);
+    std::cout << "test_layout passed\n";
+}
+
+void test_syndrome_bits() {
+    const MarchProgram program(sample(), MEM_SIZE);
+    // read 依 overallIdx 編號，其他操作為 -1
+    assert(program.bit(0) == -1);
+    assert(program.bit(1) == 0);
+    assert(program.bit(4) == 1);
+    assert(program.bit(6) == 2);
+    for (int b = 1; b < program.readCount(); ++b)
+        assert(program.readIndex(b - 1).overallIdx < program.readIndex(b).overallIdx);
+    std::cout << "test_syndrome_bits passed\n";
+}
+
+void test_address_order() {
+    const MarchProgram program(sample(), MEM_SIZE);
+    HealthyFault fault(MemoryState::create(2, 2, 0));
+    TraceCollector collector;
+    SequenceExecutor executor(MEM_SIZE, collector);
+    executor.execute(program, fault);
+
+    // element 1 遞增；element 3 遞減，每個位址依序 r1、r0
+    const std::vector<int> expectAddr { 0, 1, 2, 3, 3, 3, 2, 2, 1, 1, 0, 0 };
+    assert(collector.trace_.size() == expectAddr.size());
+    for (std::size_t k = 0; k < expectAddr.size(); ++k) {
+        assert(collector.trace_[k][2] == expectAddr[k]);
+        assert(!collector.trace_[k][3]);
+    }
+    std::cout << "test_address_order passed\n";
+}
+
+void test_size_mismatch() {
+    const MarchProgram program(sample(), MEM_SIZE);
+    HealthyFault fault(MemoryState::create(3, 3, 0));
+    TraceCollector collector;
+    SequenceExecutor executor(9, collector);
+    bool threw = false;
+    try { executor.execute(program, fault); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "test_size_mismatch passed\n";
+}
+
+int main() {
+    test_layout();
+    test_syndrome_bits();
+    test_address_order();
+    test_size_mismatch();
+    std::cout << "All MarchProgram tests passed\n";
+    return 0;
+}
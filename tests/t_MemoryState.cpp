@@ -32,7 +32,132 @@ void testDenseMemoryState() {
     std::cout << "All DenseMemoryState tests passed!\n";
 }
 
+void testWordMemoryState() {
+    std::cout << "Running WordMemoryState tests...\n";
+    WordMemoryState memory(2, 2, 8);
+    assert(memory.size() == 4 && memory.mask() == 0xFF);
+
+    memory.write(1, 0x1FF);           // 超過寬度的 bit 會被截掉
+    assert(memory.read(1) == 0xFF);
+    assert(memory.read(4) == 0);      // 超出範圍
+
+    // Checkerboard：相鄰 bit、相鄰 row 都互為反相
+    memory.fill(DataBackground::Checkerboard, false);
+    assert(memory.read(0) == 0xAA && memory.read(2) == 0x55);
+    assert(memory.pattern(0, true) == 0x55);
+
+    memory.fill(DataBackground::RowStripe, true);
+    assert(memory.read(0) == 0xFF && memory.read(3) == 0x00);
+
+    memory.fill(DataBackground::ColumnStripe, false);
+    assert(memory.read(0) == 0xAA && memory.read(3) == 0xAA);
+
+    // 奇數寬度時下一個 word 從奇數實體欄位開始
+    assert(backgroundWord(DataBackground::ColumnStripe, 0, 1, 3) == 0x5);
+    assert(wordMask(64) == ~uint64_t{0});
+    std::cout << "All WordMemoryState tests passed!\n";
+}
+
+void testPagedMemoryState() {
+    std::cout << "Running PagedMemoryState tests...\n";
+    const int COLS = PagedMemoryState::kPageSize;  // 一個 row 剛好一個 page
+    PagedMemoryState memory(4, COLS, 1);
+    assert(memory.residentPages() == 0);
+    assert(memory.read(0) == 1 && memory.read(4 * COLS - 1) == 1);
+    assert(memory.read(4 * COLS) == 1);  // 超出範圍
+
+    memory.write(5, 0);
+    memory.write(3 * COLS, 0);
+    memory.write(4 * COLS, 0);           // 超出範圍，忽略
+    assert(memory.residentPages() == 2);
+    assert(memory.read(5) == 0 && memory.read(6) == 1 && memory.read(3 * COLS) == 0);
+
+    // clone 共用 page，寫入時才複製
+    auto snap = memory.clone();
+    memory.write(5, 1);
+    snap->write(3 * COLS, 1);
+    assert(snap->read(5) == 0 && memory.read(5) == 1);
+    assert(memory.read(3 * COLS) == 0 && snap->read(3 * COLS) == 1);
+
+    // reset 只丟掉 touched page，snapshot 不受影響
+    memory.reset();
+    assert(memory.residentPages() == 0);
+    assert(memory.read(5) == 1 && memory.read(3 * COLS) == 1);
+    assert(snap->read(5) == 0);
+
+    // 與 DenseMemoryState 行為一致
+    auto dense = MemoryState::create(3, 5, 0, MemoryKind::Dense);
+    auto paged = MemoryState::create(3, 5, 0, MemoryKind::Paged);
+    for (int i = 0; i < 15; i += 2) { dense->write(i, 1); paged->write(i, 1); }
+    for (int i = -1; i <= 15; ++i) assert(dense->read(i) == paged->read(i));
+    assert(dynamic_cast<PagedMemoryState*>(MemoryState::create(1024, 1024, 0).get()) != nullptr);
+    assert(dynamic_cast<DenseMemoryState*>(MemoryState::create(4, 4, 0).get()) != nullptr);
+    std::cout << "All PagedMemoryState tests passed!\n";
+}
+
+void testFillLine() {
+    std::cout << "Running fillLine tests...\n";
+    // row / column 一次寫入，結果須與逐一 write 相同 (Dense 與 Paged)
+    const LineRange row { 2 * 6, 6, 1 }, col { 4, 5, 6 };
+    for (MemoryKind kind : { MemoryKind::Dense, MemoryKind::Paged }) {
+        auto bulk = MemoryState::create(5, 6, 0, kind);
+        auto ref  = MemoryState::create(5, 6, 0, kind);
+        bulk->fillLine(row, 1);
+        bulk->fillLine(col, 1);
+        for (int k = 0; k < row.count; ++k) ref->write(row.first + k * row.stride, 1);
+        for (int k = 0; k < col.count; ++k) ref->write(col.first + k * col.stride, 1);
+        for (int i = 0; i < 30; ++i) assert(bulk->read(i) == ref->read(i));
+        assert(bulk->read(13) == 1 && bulk->read(28) == 1 && bulk->read(5) == 0);
+    }
+    // 跨 page 的 row
+    PagedMemoryState paged(2, PagedMemoryState::kPageSize + 8, 0);
+    paged.fillLine({ 0, PagedMemoryState::kPageSize + 8, 1 }, 1);
+    assert(paged.residentPages() == 2);
+    assert(paged.read(PagedMemoryState::kPageSize + 7) == 1 && paged.read(PagedMemoryState::kPageSize + 8) == 0);
+    assert(row.contains(17) && !row.contains(18) && col.contains(28) && !col.contains(34) && !col.contains(5));
+    std::cout << "All fillLine tests passed!\n";
+}
+
+void testRestoreAndCompare() {
+    std::cout << "Running restore / sameContents tests...\n";
+    for (MemoryKind kind : { MemoryKind::Dense, MemoryKind::Paged }) {
+        auto memory = MemoryState::create(3, PagedMemoryState::kPageSize, 0, kind);
+        memory->write(7, 1);
+        auto snap = memory->clone();
+        assert(memory->sameContents(*snap));
+        memory->write(2 * PagedMemoryState::kPageSize, 1);
+        memory->write(7, 0);
+        assert(!memory->sameContents(*snap) && !snap->sameContents(*memory));
+        memory->restore(*snap);
+        assert(memory->sameContents(*snap));
+        assert(memory->read(7) == 1 && memory->read(2 * PagedMemoryState::kPageSize) == 0);
+        // 還原後兩份仍互不影響
+        memory->write(8, 1);
+        assert(snap->read(8) == 0);
+
+        // 不同實作之間也可以比較 / 還原
+        auto other = MemoryState::create(3, PagedMemoryState::kPageSize, 0,
+                                         kind == MemoryKind::Dense ? MemoryKind::Paged : MemoryKind::Dense);
+        other->restore(*memory);
+        assert(other->sameContents(*memory) && memory->sameContents(*other));
+    }
+
+    // reset 留下的 spare page 不隨 clone 共用：兩邊各自重新使用時不會寫到同一個 page
+    PagedMemoryState paged(2, PagedMemoryState::kPageSize, 0);
+    paged.write(0, 1);
+    paged.reset();
+    auto copy = paged.clone();
+    paged.write(1, 1);
+    copy->write(2, 1);
+    assert(paged.read(2) == 0 && copy->read(1) == 0);
+    std::cout << "All restore / sameContents tests passed!\n";
+}
+
 int main() {
     testDenseMemoryState();
+    testPagedMemoryState();
+    testWordMemoryState();
+    testFillLine();
+    testRestoreAndCompare();
     return 0;
 }
\ No newline at end of file
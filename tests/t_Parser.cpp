@@ -4,7 +4,10 @@
 #define private   public
 #define protected public
 #include "../include/Parser.hpp"        // Parser / explodeOpToken
+#include "../src/AddressOrder.cpp"
 #include "../src/Parser.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/ResultStore.cpp"
 
 // 方便重複驗證字串 → int 轉換
 void test_toInt() {
@@ -0,0 +1,159 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "../include/Pipeline.hpp"
+#include "../src/Pipeline.cpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/Parser.cpp"
+#include "../src/FaultSimulator.cpp"
+#include "../src/AddressAllocator.cpp"
+#include "../src/AddressDecoder.cpp"
+#include "../src/AnalyticalEngine.cpp"
+#include "../src/DataBackground.cpp"
+#include "../src/Fault.cpp"
+#include "../src/MemoryState.cpp"
+#include "../src/ResultCollector.cpp"
+#include "../src/SensitizationFilter.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/ResultStore.cpp"
+#include "../src/SequenceExecutor.cpp"
+#include "../src/SymmetryReducer.cpp"
+
+static const char* kFaults = "t_Pipeline.faults.tmp.json";
+static const char* kMarch  = "t_Pipeline.march.tmp.json";
+
+static void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream(path) << text;
+}
+
+static std::string slurp(const std::string& path) {
+    std::ifstream ifs(path);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+static void writeInputs() {
+    writeFile(kFaults, R"JSON([
+      {"name": "TF", "cell_number": 1, "conditions": ["{0}, {W1}, {R1}, {0}, {-}", "{1}, {W0}, {R0}, {1}, {-}"]},
+      {"name": "RDF", "cell_number": 1, "conditions": ["{0}, {R0}, {R0}, {1}, {1}", "{1}, {R1}, {R1}, {0}, {0}"]},
+      {"name": "CFds", "cell_number": 2, "conditions": ["{0},{0},{0},{-},{-},{R0},{1},{-}",
+                                                      "{0},{1},{1},{-},{-},{R1},{0},{-}"]},
+      {"name": "WDF", "cell_number": 1, "conditions": ["{0}, {W0}, {R0}, {1}, {-}"]}
+    ])JSON");
+    writeFile(kMarch, R"JSON({"name": "March C-", "pattern": "b(w0);a(r0,w1);a(r1,w0);d(r0,w1);d(r1,w0);b(r0)"})JSON");
+}
+
+// 串流讀入的 fault 與一次讀完的結果相同，且保持 JSON 順序
+void test_stream_faults_matches_parse() {
+    Parser parser;
+    auto all = parser.parseFaults(kFaults);
+    std::vector<FaultConfig> streamed;
+    parser.streamFaults(kFaults, [&](FaultConfig&& cfg) { streamed.push_back(std::move(cfg)); });
+    assert(all.size() == 7 && streamed.size() == all.size());
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        assert(streamed[i].id_ == all[i].id_);
+        assert(streamed[i].trigger_.size() == all[i].trigger_.size());
+        assert(streamed[i].faultValue_ == all[i].faultValue_);
+    }
+}
+
+// worker 數、佇列深度不影響輸出；同時存在的 fault 不超過 window
+void test_pipeline_deterministic_and_bounded() {
+    Parser parser;
+    auto march = parser.parseMarchTest(kMarch);
+    std::string reference;
+    for (int workers : { 1, 4 }) {
+        for (std::size_t depth : { std::size_t{1}, std::size_t{16} }) {
+            PipelineOptions opt;
+            opt.workers = workers;
+            opt.queueDepth = depth;
+            SimulationPipeline pipeline(march, opt);
+            const std::string out = "t_Pipeline.out.tmp.csv";
+            PipelineStats stats = pipeline.run(kFaults, out);
+            const std::string text = slurp(out);
+            std::remove(out.c_str());
+            assert(stats.faults == 7);
+            assert(stats.peakInFlight >= 1 && stats.peakInFlight <= pipeline.window());
+            if (reference.empty()) reference = text;
+            assert(text == reference);
+        }
+    }
+    // 表頭 + 每個 fault 兩列，依讀入順序；TF 在 March C- 下必定被偵測
+    std::istringstream lines(reference);
+    std::string line;
+    int count = 0;
+    std::getline(lines, line);
+    assert(line.rfind("fault,subcase", 0) == 0);
+    std::getline(lines, line);
+    assert(line.rfind("\"TF\",0,", 0) == 0 && line.find(",0,1,") != std::string::npos);
+    for (count = 1; std::getline(lines, line);) ++count;
+    assert(count == 14);
+}
+
+// 與 SingleFaultSimulator 直接模擬的結果一致 (NDJSON)
+void test_pipeline_matches_single_fault() {
+    Parser parser;
+    auto march = parser.parseMarchTest(kMarch);
+    PipelineOptions opt;
+    opt.workers = 3;
+    opt.format = StreamFormat::NdJson;
+    const std::string out = "t_Pipeline.out.tmp.ndjson";
+    PipelineStats stats = SimulationPipeline(march, opt).run(kFaults, out);
+    const std::string text = slurp(out);
+    std::remove(out.c_str());
+
+    auto faults = parser.parseFaults(kFaults);
+    SingleFaultSimulator sim(march, opt.rows, opt.cols, opt.seed);
+    long long detected = 0;
+    const std::string expectedFile = "t_Pipeline.expected.tmp.ndjson";
+    {
+        BufferedWriter expected(expectedFile);
+        const auto reads = Parser::readOps(march);
+        for (std::size_t i = 0; i < faults.size(); ++i) {
+            sim.run(faults[i], i);
+            detected += sim.report(0).isDetected_ + sim.report(1).isDetected_;
+            parser.writeJsonRows(expected, faults[i], ResultStore::toSyndrome(sim.report(0), reads),
+                                 ResultStore::toSyndrome(sim.report(1), reads), reads);
+        }
+    }
+    assert(slurp(expectedFile) == text);
+    std::remove(expectedFile.c_str());
+    assert(stats.detected == detected);
+}
+
+// 解析錯誤會在 run() 拋出，其他階段正常結束
+void test_pipeline_propagates_errors() {
+    Parser parser;
+    auto march = parser.parseMarchTest(kMarch);
+    const std::string bad = "t_Pipeline.bad.tmp.json";
+    writeFile(bad, R"JSON([{"name": "TF", "cell_number": 1, "conditions": ["{0}, {W1}, {R1}, {0}, {-}"]},
+                           {"name": "X", "cell_number": 7, "conditions": ["{0}"]}])JSON");
+    PipelineOptions opt;
+    opt.workers = 2;
+    opt.queueDepth = 1;
+    bool thrown = false;
+    try {
+        SimulationPipeline(march, opt).run(bad, "t_Pipeline.out.tmp.csv");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(bad.c_str());
+    std::remove("t_Pipeline.out.tmp.csv");
+}
+
+int main() {
+    writeInputs();
+    test_stream_faults_matches_parse();
+    test_pipeline_deterministic_and_bounded();
+    test_pipeline_matches_single_fault();
+    test_pipeline_propagates_errors();
+    std::remove(kFaults);
+    std::remove(kMarch);
+    std::cout << "All Pipeline tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "../include/ResultStore.hpp"
+#include "../src/ResultStore.cpp"
+
+static const char* kSpill = "t_ResultStore.spill.tmp";
+
+// b(w0); a(r0,w1); d(r1,w0,r0)：三個 read，overallIdx 為 1、3、5
+static std::vector<MarchElement> marchOf() {
+    std::vector<MarchElement> march(3);
+    int o = 0;
+    auto op = [&](int e, int k, OpType type, int value) {
+        march[e].elemIdx_ = e;
+        march[e].ops_.push_back({ SingleOp(type, value), MarchIdx(e, k, o++) });
+    };
+    op(0, 0, OpType::W, 0);
+    op(1, 0, OpType::R, 0); op(1, 1, OpType::W, 1);
+    op(2, 0, OpType::R, 1); op(2, 1, OpType::W, 0); op(2, 2, OpType::R, 0);
+    return march;
+}
+
+static DetectionReport reportOf(const std::vector<MarchElement>& march, const std::string& bits) {
+    DetectionReport report;
+    int r = 0;
+    for (const auto& elem : march)
+        for (const auto& op : elem.ops_) {
+            if (op.op_.type_ != OpType::R) continue;
+            report.detected_[op.idx_] = bits[r] == '1';
+            report.isDetected_ = report.isDetected_ || bits[r] == '1';
+            ++r;
+        }
+    report.detectedVicAddrs_ = { 3 };
+    return report;
+}
+
+void test_set_and_read_back() {
+    const auto march = marchOf();
+    ResultStore store(4, march);
+    assert(store.faultCount() == 4 && store.readCount() == 3 && store.stride() == 1 && !store.spilled());
+    assert(store.reads()[1] == MarchIdx(2, 0, 3));
+    assert(store.detectedCount() == 0);
+
+    store.set(0, 1, reportOf(march, "101"));
+    store.set(2, 0, Syndrome::fromString("010"));
+    assert(!store.detected(0, 0) && store.detected(0, 1) && store.detected(2, 0));
+    assert(store.syndrome(0, 1).toString() == "101");
+    assert(store.detectedCount() == 2);
+
+    // 還原的報告與原本相同，只少了 detectedVicAddrs_
+    DetectionReport expected = reportOf(march, "101");
+    expected.detectedVicAddrs_.clear();
+    assert(store.report(0, 1) == expected);
+    assert(store.report(3, 0).detected_.size() == 3 && !store.report(3, 0).isDetected_);
+
+    // 覆寫為未偵測
+    store.set(0, 1, DetectionReport());
+    assert(!store.detected(0, 1) && store.detectedCount() == 1);
+    assert(ResultStore::toSyndrome(reportOf(march, "011"), store.reads()) == Syndrome::fromString("011"));
+
+    bool threw = false;
+    try { store.set(1, 0, Syndrome::fromString("01")); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    std::cout << "test_set_and_read_back passed\n";
+}
+
+// 超過 64 個 read：每列跨多個 word
+void test_wide_rows() {
+    std::vector<MarchElement> march(1);
+    for (int i = 0; i < 70; ++i) march[0].ops_.push_back({ SingleOp(OpType::R, 0), MarchIdx(0, i, i) });
+    ResultStore store(2, march);
+    assert(store.stride() == 2);
+    Syndrome s(70);
+    s.set(0); s.set(69);
+    store.set(1, 1, s);
+    assert(store.syndrome(1, 1) == s && store.detected(1, 1) && !store.detected(1, 0));
+    assert(store.words(1, 1)[1] == (uint64_t{1} << 5));
+    std::cout << "test_wide_rows passed\n";
+}
+
+void test_spill_file() {
+    const auto march = marchOf();
+    bool threw = false;
+    {
+        ResultStore store(1000, march, kSpill);
+        assert(store.spilled());
+        store.set(999, 1, Syndrome::fromString("110"));
+        store.set(0, 0, Syndrome::fromString("001"));
+        assert(store.detectedCount() == 2);
+
+        // 移動後 mapping 跟著新物件
+        ResultStore moved = std::move(store);
+        assert(moved.spilled() && !store.spilled() && store.faultCount() == 0);
+        assert(moved.syndrome(999, 1).toString() == "110");
+    }
+    // 檔頭 + 1000 x 2 列，每列一個 word；第 0 列的 bit 2 即為 read 2
+    std::ifstream in(kSpill, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assert(bytes.size() == 24 + 1000 * 2 * 8);
+    assert(std::string(bytes.data(), 8) == "FSRES001");
+    assert(bytes[24] == 0x4);
+    assert(bytes[24 + 1999 * 8] == 0x3);
+    in.close();
+
+    // 重新開啟保留內容；fault 數或 March test 不同時拒絕
+    {
+        ResultStore reopened = ResultStore::reopen(kSpill, 1000, march);
+        assert(reopened.spilled() && reopened.syndrome(999, 1).toString() == "110");
+        reopened.set(5, 0, Syndrome::fromString("100"));
+        reopened.flush();
+    }
+    assert(ResultStore::reopen(kSpill, 1000, march).detectedCount() == 3);
+    threw = false;
+    try { ResultStore::reopen(kSpill, 999, march); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    auto shorter = march;
+    shorter.pop_back();
+    threw = false;
+    try { ResultStore::reopen(kSpill, 1000, shorter); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::remove(kSpill);
+
+    threw = false;
+    try { ResultStore bad(1, march, "no/such/dir/x.bin"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::cout << "test_spill_file passed\n";
+}
+
+int main() {
+    test_set_and_read_back();
+    test_wide_rows();
+    test_spill_file();
+    std::cout << "All ResultStore tests passed\n";
+    return 0;
+}
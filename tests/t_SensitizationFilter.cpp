@@ -0,0 +1,119 @@
+#include <cassert>
+#include <iostream>
+#include "../include/SensitizationFilter.hpp"
+#include "../src/SensitizationFilter.cpp"
+
+// ---------------------------------
+// 工具：由 (direction, ops) 建立 MarchElement
+// ---------------------------------
+static MarchElement makeElem(Direction dir, const std::vector<SingleOp>& ops, int elemIdx, int& overallIdx) {
+    MarchElement elem;
+    elem.addrOrder_ = dir;
+    elem.elemIdx_   = elemIdx;
+    for (std::size_t i = 0; i < ops.size(); ++i)
+        elem.ops_.push_back({ops[i], MarchIdx(elemIdx, static_cast<int>(i), overallIdx++)});
+    return elem;
+}
+
+// MATS++ : b(w0);a(r0,w1);d(r1,w0,r0)
+static std::vector<MarchElement> matsPP() {
+    int overall = 0;
+    return {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, overall),
+        makeElem(Direction::ASC,  {{OpType::R, 0}, {OpType::W, 1}}, 1, overall),
+        makeElem(Direction::DESC, {{OpType::R, 1}, {OpType::W, 0}, {OpType::R, 0}}, 2, overall),
+    };
+}
+
+static FaultConfig oneCell(int vi, std::vector<SingleOp> trig) {
+    FaultConfig cfg;
+    cfg.VI_      = vi;
+    cfg.trigger_ = std::move(trig);
+    return cfg;
+}
+
+void test_static_triggers() {
+    SensitizationFilter filter(matsPP());
+    assert(filter.isConsistent(0));
+    assert(filter.isConsistent(1));  // b(w0) 先寫入，background 不影響讀值
+
+    assert(filter.canTrigger(oneCell(0, {{OpType::W, 1}}), 0));  // <0W1> 出現在 a(r0,w1)
+    assert(filter.canTrigger(oneCell(1, {{OpType::W, 0}}), 0));  // <1W0> 出現在 d(r1,w0)
+    assert(filter.canTrigger(oneCell(0, {{OpType::R, 0}}), 0));  // <0R0>
+}
+
+void test_dynamic_triggers() {
+    SensitizationFilter filter(matsPP());
+    // <0W1R1>：MATS++ 中 w1 之後沒有緊接 r1 → 永遠不會觸發
+    assert(!filter.canTrigger(oneCell(0, {{OpType::W, 1}, {OpType::R, 1}}), 0));
+    // <1W0R0>：d(r1,w0,r0) 內連續出現
+    assert(filter.canTrigger(oneCell(1, {{OpType::W, 0}, {OpType::R, 0}}), 0));
+    // <0R0R0>：r0 之後是 w1，不會連續讀兩次
+    assert(!filter.canTrigger(oneCell(0, {{OpType::R, 0}, {OpType::R, 0}}), 0));
+}
+
+void test_background_dependence() {
+    SensitizationFilter filter(matsPP());
+    // <1W0> 在 background = 1 時也會由第一個 b(w0) 觸發
+    assert(filter.canTrigger(oneCell(1, {{OpType::W, 0}}), 1));
+    // <0W0>：background = 0 時 b(w0) 觸發；background = 1 時 d(r1,w0) 之前值為 1 → 不符
+    FaultConfig wdf = oneCell(0, {{OpType::W, 0}});
+    assert(filter.canTrigger(wdf, 0));
+    assert(!filter.canTrigger(wdf, 1));
+}
+
+void test_two_cell_and_empty_trigger() {
+    SensitizationFilter filter(matsPP());
+    FaultConfig cfg;
+    cfg.is_twoCell_       = true;
+    cfg.twoCellFaultType_ = TwoCellFaultType::Sa;
+    cfg.AI_               = 0;
+    cfg.VI_               = 1;
+    cfg.trigger_          = {{OpType::W, 1}, {OpType::W, 1}};  // aggressor 連寫兩次 1
+    assert(!filter.canTrigger(cfg, 0));
+
+    cfg.trigger_.clear();                                       // CFst：空序列
+    assert(filter.canTrigger(cfg, 0));
+}
+
+void test_inconsistent_march() {
+    int overall = 0;
+    // a(r0) 直接讀取：background = 1 時 fault-free 也會讀錯，不可略過任何 fault
+    std::vector<MarchElement> march { makeElem(Direction::ASC, {{OpType::R, 0}}, 0, overall) };
+    SensitizationFilter filter(march);
+    assert(filter.isConsistent(0));
+    assert(!filter.isConsistent(1));
+    FaultConfig never = oneCell(0, {{OpType::W, 1}});
+    assert(!filter.canTrigger(never, 0));
+    assert(filter.canTrigger(never, 1));
+}
+
+void test_repeated_ops() {
+    // b(w0);a(r0^1000,w1);d(w0^3)
+    int overall = 0;
+    std::vector<MarchElement> march = {
+        makeElem(Direction::BOTH, {{OpType::W, 0}}, 0, overall),
+        makeElem(Direction::ASC,  {{OpType::R, 0, 1000}, {OpType::W, 1}}, 1, overall),
+        makeElem(Direction::DESC, {{OpType::W, 0, 3}}, 2, overall),
+    };
+    SensitizationFilter filter(march);
+    assert(filter.canTrigger(oneCell(0, {{OpType::R, 0, 1000}}), 0));
+    assert(filter.canTrigger(oneCell(0, {{OpType::R, 0, 999}}), 0));  // 視窗可只取 run 的一部分
+    assert(!filter.canTrigger(oneCell(0, {{OpType::R, 0, 1001}}), 0));
+    assert(filter.canTrigger(oneCell(0, {{OpType::R, 0, 2}, {OpType::W, 1}}), 0));
+    // w0^3 從 1 開始：<1W0> 後接兩次 <0W0>
+    assert(filter.canTrigger(oneCell(1, {{OpType::W, 0, 3}}), 0));
+    assert(!filter.canTrigger(oneCell(1, {{OpType::W, 0, 4}}), 0));
+    assert(filter.canTrigger(oneCell(0, {{OpType::W, 0, 2}}), 0));
+}
+
+int main() {
+    test_static_triggers();
+    test_dynamic_triggers();
+    test_background_dependence();
+    test_two_cell_and_empty_trigger();
+    test_inconsistent_march();
+    test_repeated_ops();
+    std::cout << "All SensitizationFilter tests passed!" << std::endl;
+    return 0;
+}
@@ -2,6 +2,9 @@
 #include <memory>
 #include <cassert>
 #include "../include/SequenceExecutor.hpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
 #include "../src/SequenceExecutor.cpp"
 #include "../include/Fault.hpp"
 #include "../src/Fault.cpp"
@@ -0,0 +1,106 @@
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../include/Shard.hpp"
+#include "../src/Shard.cpp"
+#include "../src/Checkpoint.cpp"
+#include "../src/ResultStore.cpp"
+
+static const std::string kJob = "faults.json | march.json | 4x4 seed 1 | order linear";
+
+template <typename Fn>
+static bool throws(Fn fn) {
+    try { fn(); } catch (const std::exception&) { return true; }
+    return false;
+}
+
+static std::vector<MarchElement> marchOf() {
+    std::vector<MarchElement> march(1);
+    march[0].ops_.push_back({ SingleOp(OpType::R, 0), MarchIdx(0, 0, 0) });
+    march[0].ops_.push_back({ SingleOp(OpType::R, 1), MarchIdx(0, 1, 1) });
+    return march;
+}
+
+static std::string fileOf(std::size_t k) { return "t_Shard." + std::to_string(k) + ".tmp"; }
+
+// 模擬一個跑完 (或沒跑完) 的 shard：範圍內第 f 個 fault 的 init 0 syndrome 為 f 的低 2 bit
+static void writeShard(const ShardSpec& spec, std::size_t faults, bool finished, const std::string& job = kJob) {
+    const auto march = marchOf();
+    ResultStore results(faults, march, fileOf(spec.index));
+    const auto [first, last] = spec.range(faults);
+    for (std::size_t f = first; f < last; ++f) {
+        Syndrome s(2);
+        if (f & 1) s.set(0);
+        if (f & 2) s.set(1);
+        results.set(f, 0, s);
+    }
+    results.flush();
+    CheckpointState{ spec.tag(job), finished ? RunCursor{ 2, 0 } : RunCursor{ 1, first }, "rng" }
+        .save(CheckpointWriter::statePath(fileOf(spec.index)));
+}
+
+static void removeShards(std::size_t count) {
+    for (std::size_t k = 0; k < count; ++k) {
+        std::remove(fileOf(k).c_str());
+        std::remove(CheckpointWriter::statePath(fileOf(k)).c_str());
+    }
+}
+
+void test_parse_and_range() {
+    const ShardSpec spec = ShardSpec::parse("2/5");
+    assert(spec.index == 2 && spec.count == 5 && spec.toString() == "2/5");
+    assert(spec.tag("job") == "job | shard 2/5");
+    for (const char* bad : { "5/5", "1/0", "1", "a/2", "1/2x", "-1/2", "" })
+        assert(throws([&] { ShardSpec::parse(bad); }));
+
+    // 各段相接、涵蓋全部 fault，大小最多差 1
+    for (std::size_t faults : { 0, 3, 10, 11 }) {
+        std::size_t next = 0;
+        for (std::size_t k = 0; k < 4; ++k) {
+            const auto [first, last] = ShardSpec{ k, 4 }.range(faults);
+            assert(first == next && last >= first && last - first <= faults / 4 + 1 && last - first >= faults / 4);
+            next = last;
+        }
+        assert(next == faults);
+    }
+    assert((ShardSpec{}.range(7) == std::pair<std::size_t, std::size_t>(0, 7)));
+    std::cout << "test_parse_and_range passed\n";
+}
+
+void test_merge() {
+    const auto march = marchOf();
+    const std::size_t faults = 10;
+    for (std::size_t k = 0; k < 3; ++k) writeShard({ k, 3 }, faults, true);
+
+    ResultStore merged(faults, march);
+    mergeShards({ fileOf(2), fileOf(0), fileOf(1) }, kJob, march, merged); // 順序不拘
+    for (std::size_t f = 0; f < faults; ++f) {
+        assert(merged.syndrome(f, 0).test(0) == bool(f & 1));
+        assert(merged.syndrome(f, 0).test(1) == bool(f & 2));
+        assert(!merged.detected(f, 1));
+    }
+
+    // 缺 shard、重複、參數不同、fault 數不同
+    ResultStore other(faults, march);
+    assert(throws([&] { mergeShards({ fileOf(0), fileOf(1) }, kJob, march, other); }));
+    assert(throws([&] { mergeShards({ fileOf(0), fileOf(0), fileOf(1) }, kJob, march, other); }));
+    assert(throws([&] { mergeShards({ fileOf(0), fileOf(1), fileOf(2) }, kJob + " analytical", march, other); }));
+    ResultStore wrongSize(faults + 1, march);
+    assert(throws([&] { mergeShards({ fileOf(0), fileOf(1), fileOf(2) }, kJob, march, wrongSize); }));
+    assert(throws([&] { mergeShards({}, kJob, march, other); }));
+
+    // 還沒跑完的 shard
+    writeShard({ 1, 3 }, faults, false);
+    assert(throws([&] { mergeShards({ fileOf(0), fileOf(1), fileOf(2) }, kJob, march, other); }));
+    removeShards(3);
+    std::cout << "test_merge passed\n";
+}
+
+int main() {
+    test_parse_and_range();
+    test_merge();
+    std::cout << "All Shard tests passed\n";
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../include/SimulationServer.hpp"
+#include "../src/SimulationServer.cpp"
+#include "../src/Parser.cpp"
+#include "../src/FaultLibrary.cpp"
+#include "../src/FaultSimulator.cpp"
+#include "../src/AddressAllocator.cpp"
+#include "../src/AddressDecoder.cpp"
+#include "../src/AnalyticalEngine.cpp"
+#include "../src/Checkpoint.cpp"
+#include "../src/DataBackground.cpp"
+#include "../src/Fault.cpp"
+#include "../src/MemoryState.cpp"
+#include "../src/ResultCollector.cpp"
+#include "../src/SensitizationFilter.cpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/ResultStore.cpp"
+#include "../src/SequenceExecutor.cpp"
+#include "../src/SymmetryReducer.cpp"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+static const std::string kFaults = "input/fault.json"; // 與 make run-test 相同，在 repo 根目錄執行
+static const std::string kLibrary = "t_SimulationServer.march.tmp";
+
+static json reply(SimulationServer& server, const json& job) { return json::parse(server.handle(job.dump())); }
+
+static void writeLibrary(const std::string& pattern) {
+    std::ofstream out(kLibrary, std::ios::trunc);
+    out << json::array({ { { "name", "Mine" }, { "pattern", pattern } },
+                         { { "name", "Other" }, { "pattern", "b(w0);b(r0)" } } }).dump();
+}
+
+// 與直接使用 OneByOneFaultSimulator 的結果相同；第二次起 library 與 program 都取自快取
+void test_handle_matches_simulator() {
+    Parser parser;
+    const auto faults = parser.parseFaults(kFaults);
+    const auto march = parser.parseMarchTest("builtin:March C-");
+    ResultStore results(faults.size(), march);
+    OneByOneFaultSimulator sim(faults, march, 8, 8, 7, results);
+    sim.run();
+
+    SimulationServer server;
+    const json job = { { "id", 1 }, { "faults", kFaults }, { "march", "builtin:March C-" },
+                       { "rows", 8 }, { "cols", 8 }, { "seed", 7 }, { "detail", true } };
+    const json first = reply(server, job);
+    assert(first["ok"] == true && first["id"] == 1);
+    assert(first["faults"] == faults.size());
+    assert(first["detected"] == results.detectedCount());
+    assert(first["coverage"].get<double>() == sim.getDetectedRate());
+    assert(first["cache"]["faults"] == "miss" && first["cache"]["program"] == "miss");
+    assert(first["results"].size() == faults.size());
+    assert(first["results"][3]["init1"] == results.syndrome(3, 1).toString());
+    for (const char* key : { "queue", "load", "simulate", "total" })
+        assert(first["timing_ms"][key].get<double>() >= 0);
+
+    const json second = reply(server, job);
+    assert(second["cache"]["faults"] == "hit" && second["cache"]["march"] == "hit");
+    assert(second["cache"]["program"] == "hit");
+    assert(second["detected"] == first["detected"]);
+
+    // 不同大小要另外編譯，March test 本身仍在快取中
+    json bigger = job;
+    bigger["rows"] = 16;
+    const json third = reply(server, bigger);
+    assert(third["cache"]["march"] == "hit" && third["cache"]["program"] == "miss");
+
+    // family 只模擬指定名稱的 fault
+    json family = job;
+    family["family"] = "Stuck-at Fault (SAF)";
+    const json saf = reply(server, family);
+    assert(saf["ok"] == true && saf["faults"].get<std::size_t>() < faults.size());
+    for (const auto& row : saf["results"]) assert(row["fault"] == "Stuck-at Fault (SAF)");
+
+    const json stats = reply(server, { { "cmd", "stats" } });
+    assert(stats["cached"]["libraries"] == 1 && stats["cached"]["programs"] == 2);
+    assert(reply(server, { { "cmd", "evict" } })["ok"] == true);
+    assert(reply(server, job)["cache"]["faults"] == "miss");
+    std::cout << "test_handle_matches_simulator passed\n";
+}
+
+// March test 庫的檔案修改後重新載入；list_marches 與互動選單使用相同的清單
+void test_library_reload() {
+    SimulationServer server;
+    writeLibrary("b(w0);a(r0,w1);d(r1,w0);b(r0)");
+    const json listed = reply(server, { { "cmd", "list_marches" }, { "file", kLibrary } });
+    assert(listed["marches"] == json::array({ "Mine", "Other" }));
+    const json builtins = reply(server, { { "cmd", "list_marches" } });
+    assert(builtins["marches"][0] == "builtin:MATS++");
+
+    const json job = { { "faults", kFaults }, { "march_library", kLibrary }, { "march_name", "Mine" } };
+    const json before = reply(server, job);
+    assert(before["ok"] == true && before["cache"]["march"] == "miss");
+    assert(reply(server, job)["cache"]["march"] == "hit");
+
+    const auto mtime = std::filesystem::last_write_time(kLibrary);
+    writeLibrary("b(w0);b(r0)");
+    std::filesystem::last_write_time(kLibrary, mtime + std::chrono::seconds(2));
+    const json after = reply(server, job);
+    assert(after["cache"]["march"] == "miss" && after["cache"]["program"] == "miss");
+    assert(after["detected"].get<long long>() < before["detected"].get<long long>());
+
+    // pattern 與 March test 庫中相同內容的結果相同
+    const json pattern = reply(server, { { "faults", kFaults }, { "pattern", "b(w0);b(r0)" } });
+    assert(pattern["detected"] == after["detected"]);
+
+    json missing = job;
+    missing["march_name"] = "Nope";
+    assert(reply(server, missing)["ok"] == false);
+    std::remove(kLibrary.c_str());
+    std::cout << "test_library_reload passed\n";
+}
+
+void test_errors() {
+    SimulationServer server;
+    const json bad = json::parse(server.handle("{not json"));
+    assert(bad["ok"] == false && bad["id"].is_null());
+    assert(reply(server, { { "id", "a" }, { "march", "builtin:March C-" } })["ok"] == false);
+    assert(reply(server, { { "faults", kFaults } })["ok"] == false);
+    assert(reply(server, { { "faults", "no_such_file.json" }, { "march", "builtin:March C-" } })["ok"] == false);
+    assert(reply(server, { { "faults", kFaults }, { "march", "builtin:Nope" } })["ok"] == false);
+    assert(reply(server, { { "faults", kFaults }, { "march", "builtin:March C-" }, { "rows", 0 } })["ok"] == false);
+    assert(reply(server, { { "faults", kFaults }, { "march", "builtin:March C-" },
+                           { "family", "No Such Fault" } })["ok"] == false);
+    const json unknown = reply(server, { { "id", 5 }, { "cmd", "reboot" } });
+    assert(unknown["ok"] == false && unknown["id"] == 5);
+    const json stats = reply(server, { { "cmd", "stats" } });
+    assert(stats["failed"] == 8 && stats["jobs"] == 9);
+    std::cout << "test_errors passed\n";
+}
+
+// JSON lines：每個 job 回覆一行 (以 id 對應，順序不定)；shutdown 之後的 job 不執行
+void test_serve_stream() {
+    ServerOptions options;
+    options.workers = 3;
+    options.queueDepth = 2;
+    SimulationServer server(options);
+    std::stringstream in, out;
+    const char* marches[] = { "builtin:March C-", "builtin:MATS++", "builtin:March X" };
+    for (int id = 0; id < 9; ++id)
+        in << json{ { "id", id }, { "faults", kFaults }, { "march", marches[id % 3] } }.dump() << "\n";
+    in << "\n" << "oops\n" << R"({"cmd":"shutdown","id":"bye"})" << "\n" << R"({"cmd":"ping","id":"late"})" << "\n";
+    server.serve(in, out);
+
+    std::vector<json> lines;
+    for (std::string line; std::getline(out, line);) lines.push_back(json::parse(line));
+    assert(lines.size() == 11);
+    assert(lines.back()["id"] == "bye" && lines.back()["cmd"] == "shutdown");
+    std::set<int> ids;
+    double coverage[3] = { -1, -1, -1 };
+    for (const auto& r : lines) {
+        if (!r["id"].is_number()) continue;
+        const int id = r["id"];
+        ids.insert(id);
+        assert(r["ok"] == true);
+        if (coverage[id % 3] < 0) coverage[id % 3] = r["coverage"];
+        assert(r["coverage"] == coverage[id % 3]);
+    }
+    assert(ids.size() == 9);
+    assert(server.jobCount() == 11);
+    std::cout << "test_serve_stream passed\n";
+}
+
+#ifndef _WIN32
+static sockaddr_un addressOf(const std::string& path) {
+    sockaddr_un addr {};
+    addr.sun_family = AF_UNIX;
+    std::copy(path.begin(), path.end(), addr.sun_path);
+    return addr;
+}
+
+// server 在另一個 thread 啟動，等到可以連線為止
+static int connectTo(const std::string& path) {
+    const sockaddr_un addr = addressOf(path);
+    for (int attempt = 0; attempt < 250; ++attempt) {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return -1;
+}
+
+// 送出 request 並讀到 server 關閉連線為止
+static std::vector<json> roundTrip(int fd, const std::string& request) {
+    assert(::send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+    ::shutdown(fd, SHUT_WR);
+    std::string received;
+    char chunk[4096];
+    for (ssize_t n; (n = ::recv(fd, chunk, sizeof(chunk), 0)) > 0;) received.append(chunk, n);
+    ::close(fd);
+    std::vector<json> replies;
+    std::istringstream lines(received);
+    for (std::string line; std::getline(lines, line);) replies.push_back(json::parse(line));
+    return replies;
+}
+
+// 上次未正常結束留下的 socket 檔會被取代；job 與 shutdown 分別由兩個連線送出
+void test_serve_unix() {
+    const std::string path = "t_SimulationServer.sock.tmp";
+    std::remove(path.c_str());
+    {
+        const int stale = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        const sockaddr_un addr = addressOf(path);
+        assert(::bind(stale, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0);
+        ::close(stale); // socket 檔留在原處，但沒有人在等待連線
+        assert(std::filesystem::is_socket(path));
+    }
+
+    SimulationServer server(ServerOptions{ 8, 8, 7, 2, 8, MemoryKind::Auto });
+    std::thread serving([&] { server.serveUnix(path); });
+
+    const json job = { { "id", "sock-1" }, { "faults", kFaults }, { "march", "builtin:March C-" } };
+    const int fd = connectTo(path);
+    assert(fd >= 0);
+    const auto replies = roundTrip(fd, job.dump() + "\n");
+    assert(replies.size() == 1);
+    const json& r = replies[0];
+    assert(r["id"] == "sock-1" && r["ok"] == true);
+    assert(r["detected"] == json::parse(server.handle(job.dump()))["detected"]); // 與同步呼叫相同
+    for (const char* key : { "queue", "load", "simulate", "total" })
+        assert(r["timing_ms"][key].is_number() && r["timing_ms"][key].get<double>() >= 0);
+    assert(r["timing_ms"]["total"].get<double>() >= r["timing_ms"]["simulate"].get<double>());
+
+    const auto bye = roundTrip(connectTo(path), R"({"cmd":"shutdown","id":2})");
+    serving.join();
+    assert(bye.size() == 1 && bye[0]["cmd"] == "shutdown" && bye[0]["id"] == 2);
+    assert(!std::filesystem::exists(path));
+
+    // 同名的一般檔案不會被刪除
+    std::ofstream(path) << "keep";
+    bool refused = false;
+    try { server.serveUnix(path); } catch (const std::runtime_error&) { refused = true; }
+    assert(refused && std::filesystem::is_regular_file(path));
+    std::remove(path.c_str());
+    std::cout << "test_serve_unix passed\n";
+}
+#endif
+
+int main() {
+    test_handle_matches_simulator();
+    test_library_reload();
+    test_errors();
+    test_serve_stream();
+#ifndef _WIN32
+    test_serve_unix();
+#endif
+    std::cout << "All SimulationServer tests passed\n";
+    return 0;
+}
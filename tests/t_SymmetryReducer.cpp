@@ -0,0 +1,137 @@
+#include <cassert>
+#include <iostream>
+#include "../include/SymmetryReducer.hpp"
+#include "../src/SymmetryReducer.cpp"
+#include "../include/SensitizationFilter.hpp"
+#include "../src/SensitizationFilter.cpp"
+#include "../include/Fault.hpp"
+#include "../src/Fault.cpp"
+#include "../include/MemoryState.hpp"
+#include "../src/MemoryState.cpp"
+#include "../include/ResultCollector.hpp"
+#include "../src/ResultCollector.cpp"
+#include "../include/SequenceExecutor.hpp"
+#include "../src/AddressOrder.cpp"
+#include "../src/MarchLibrary.cpp"
+#include "../src/MarchProgram.cpp"
+#include "../src/SequenceExecutor.cpp"
+
+constexpr int MEM_SIZE = 7;
+
+static MarchElement makeElem(Direction dir, const std::vector<SingleOp>& ops, int elemIdx, int& overallIdx) {
+    MarchElement elem;
+    elem.addrOrder_ = dir;
+    elem.elemIdx_   = elemIdx;
+    for (std::size_t i = 0; i < ops.size(); ++i)
+        elem.ops_.push_back({ops[i], MarchIdx(elemIdx, static_cast<int>(i), overallIdx++)});
+    return elem;
+}
+
+// March C- : b(w0);a(r0,w1);a(r1,w0);d(r0,w1);d(r1,w0);b(r0)
+static std::vector<MarchElement> marchCMinus() {
+    int o = 0;
+    using Op = OpType;
+    return {
+        makeElem(Direction::BOTH, {{Op::W, 0}}, 0, o),
+        makeElem(Direction::ASC,  {{Op::R, 0}, {Op::W, 1}}, 1, o),
+        makeElem(Direction::ASC,  {{Op::R, 1}, {Op::W, 0}}, 2, o),
+        makeElem(Direction::DESC, {{Op::R, 0}, {Op::W, 1}}, 3, o),
+        makeElem(Direction::DESC, {{Op::R, 1}, {Op::W, 0}}, 4, o),
+        makeElem(Direction::BOTH, {{Op::R, 0}}, 5, o),
+    };
+}
+
+// 一開始就讀取，init 0 / 1 的結果不可互相沿用
+static std::vector<MarchElement> readFirstMarch() {
+    int o = 0;
+    using Op = OpType;
+    return {
+        makeElem(Direction::ASC,  {{Op::R, 0}, {Op::W, 1}}, 0, o),
+        makeElem(Direction::DESC, {{Op::R, 1}, {Op::W, 0}, {Op::R, 0}}, 1, o),
+    };
+}
+
+static DetectionReport simulate(const std::vector<MarchElement>& march, const FaultConfig& cfg,
+                                int init, int aggr, int vic) {
+    auto mem = std::make_shared<DenseMemoryState>(1, MEM_SIZE, init);
+    OneByOneResultCollector col;
+    auto shared = std::make_shared<const FaultConfig>(cfg);
+    auto fault = cfg.is_twoCell_ ? FaultFactory::makeTwoCellFault(shared, mem, aggr, vic)
+                                 : FaultFactory::makeOneCellFault(shared, mem, vic);
+    SequenceExecutor exe(MEM_SIZE, col);
+    exe.execute(march, *fault);
+    return col.getReport();
+}
+
+static std::vector<FaultConfig> sampleFaults() {
+    std::vector<FaultConfig> out;
+    auto one = [&](int vi, std::vector<SingleOp> trig, int fv, int rv) {
+        FaultConfig c;
+        c.VI_ = vi; c.trigger_ = std::move(trig); c.faultValue_ = fv; c.finalReadValue_ = rv;
+        out.push_back(c);
+    };
+    auto two = [&](TwoCellFaultType t, int ai, int vi, std::vector<SingleOp> trig, int fv, int rv) {
+        FaultConfig c;
+        c.is_twoCell_ = true; c.twoCellFaultType_ = t;
+        c.AI_ = ai; c.VI_ = vi; c.trigger_ = std::move(trig); c.faultValue_ = fv; c.finalReadValue_ = rv;
+        out.push_back(c);
+    };
+    one(0, {{OpType::W, 1}}, 0, -1);                     // TF
+    one(0, {{OpType::R, 0}}, 1, 1);                      // RDF
+    one(1, {{OpType::W, 0}, {OpType::R, 0}}, 1, 1);      // dRDF
+    one(1, {{OpType::W, 0}}, 1, -1);                     // 在第一個 element 就會觸發
+    two(TwoCellFaultType::Sa, 0, 0, {{OpType::W, 1}}, 1, -1);
+    two(TwoCellFaultType::Sa, 1, 1, {{OpType::R, 1}}, 0, -1);
+    two(TwoCellFaultType::Sv, 0, 1, {{OpType::R, 1}}, 0, 0);
+    two(TwoCellFaultType::Sv, 1, 0, {}, 1, -1);
+    return out;
+}
+
+// 所有位址組合 × 兩種 background：換算出的報告必須與實際模擬完全一致
+static int checkAllPlacements(const std::vector<MarchElement>& march) {
+    SymmetryReducer reducer(march, MEM_SIZE);
+    for (const auto& cfg : sampleFaults()) {
+        for (int init = 0; init < 2; ++init) {
+            for (int vic = 0; vic < MEM_SIZE; ++vic) {
+                for (int aggr = cfg.is_twoCell_ ? 0 : -1; aggr < (cfg.is_twoCell_ ? MEM_SIZE : 0); ++aggr) {
+                    if (aggr == vic) continue;
+                    DetectionReport real = simulate(march, cfg, init, aggr, vic);
+                    auto key = reducer.orbitKey(cfg, init, aggr, vic);
+                    DetectionReport derived;
+                    if (reducer.derive(key, aggr, vic, derived)) {
+                        assert(derived == real);
+                    } else {
+                        reducer.record(key, aggr, vic, real);
+                    }
+                }
+            }
+        }
+    }
+    assert(reducer.derivedCount() > reducer.representatives());
+    return reducer.representatives();
+}
+
+void test_derived_reports_match_simulation() {
+    checkAllPlacements(marchCMinus());
+    checkAllPlacements(readFirstMarch());
+}
+
+void test_background_independence() {
+    SymmetryReducer cminus(marchCMinus(), MEM_SIZE);
+    auto faults = sampleFaults();
+    assert(cminus.backgroundIndependent(faults[0]));   // TF <0w1>：w0 element 內不會觸發
+    assert(!cminus.backgroundIndependent(faults[3]));  // <1w0>：init 1 時在 w0 element 觸發
+    assert(!cminus.backgroundIndependent(faults[7]));  // 空 trigger 一存取就觸發
+    assert(cminus.orbitKey(faults[0], 0, -1, 3) == cminus.orbitKey(faults[0], 1, -1, 3));
+    assert(cminus.orbitKey(faults[3], 0, -1, 3) != cminus.orbitKey(faults[3], 1, -1, 3));
+
+    SymmetryReducer readFirst(readFirstMarch(), MEM_SIZE);
+    assert(!readFirst.backgroundIndependent(faults[0]));
+}
+
+int main() {
+    test_derived_reports_match_simulation();
+    test_background_independence();
+    std::cout << "All SymmetryReducer tests passed!" << std::endl;
+    return 0;
+}